@@ -4,6 +4,7 @@ set (CMAKE_LINK_FLAGS_RELWITHDEBINFO " " CACHE INTERNAL "Link flags for release
 set (CMAKE_LINK_FLAGS_DEBUG " " CACHE INTERNAL "Link flags for debug" FORCE)
 set (CMAKE_LINK_FLAGS_PROFILE " -pg" CACHE INTERNAL "Link flags for profile" FORCE)
 set (CMAKE_LINK_FLAGS_COVERAGE " --coverage" CACHE INTERNAL "Link flags for static code coverage" FORCE)
+set (CMAKE_LINK_FLAGS_THREADSANITIZER " -fsanitize=thread" CACHE INTERNAL "Link flags for thread sanitizer" FORCE)
 
 set (CMAKE_C_FLAGS_RELEASE "")
 if (NOT "${CMAKE_CXX_COMPILER_ID} " STREQUAL "Clang " AND NOT MSVC)
@@ -25,6 +26,9 @@ if (NOT MSVC)
   set (CMAKE_C_FLAGS_PROFILE " -fno-omit-frame-pointer -g -pg ${CMAKE_C_FLAGS_ALL}" CACHE INTERNAL "C Flags for profile" FORCE)
   set (CMAKE_CXX_FLAGS_PROFILE ${CMAKE_C_FLAGS_PROFILE})
 
+  set (CMAKE_C_FLAGS_THREADSANITIZER " -g -O1 -fno-omit-frame-pointer -fsanitize=thread ${CMAKE_C_FLAGS_ALL}" CACHE INTERNAL "C Flags for thread sanitizer" FORCE)
+  set (CMAKE_CXX_FLAGS_THREADSANITIZER ${CMAKE_C_FLAGS_THREADSANITIZER})
+
   set (CMAKE_C_FLAGS_COVERAGE " -g -O0 -Wformat=2 --coverage -fno-inline ${CMAKE_C_FLAGS_ALL}" CACHE INTERNAL "C Flags for static code coverage" FORCE)
   set (CMAKE_CXX_FLAGS_COVERAGE "${CMAKE_C_FLAGS_COVERAGE}")
   foreach(flag
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_BATCHLOADER_HH_
+#define SDF_BATCHLOADER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sdf/Types.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  // Forward declarations.
+  class BatchLoaderPrivate;
+  class Root;
+
+  /// \brief Loads many SDF files in parallel, each into its own Root.
+  ///
+  /// The files are parsed on a pool of worker threads. The workers share
+  /// the parsed SDF specification, and the paths found for included files,
+  /// so a file included by many models is only searched for once per call
+  /// to Load.
+  class SDFORMAT_VISIBLE BatchLoader
+  {
+    /// \brief Default constructor
+    public: BatchLoader();
+
+    /// \brief Destructor
+    public: ~BatchLoader();
+
+    /// \brief Copy constructor is not allowed.
+    public: BatchLoader(const BatchLoader &_loader) = delete;
+
+    /// \brief Copy assignment is not allowed.
+    public: BatchLoader &operator=(const BatchLoader &_loader) = delete;
+
+    /// \brief Set the number of worker threads used by Load.
+    /// \param[in] _count Number of threads. Zero, the default, uses one
+    /// thread per hardware thread.
+    /// \sa unsigned int ThreadCount() const
+    public: void SetThreadCount(const unsigned int _count);
+
+    /// \brief Get the number of worker threads used by Load.
+    /// \return Number of threads, which is at least one.
+    /// \sa void SetThreadCount(const unsigned int _count)
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Parse the given SDF files, each into its own Root object, as
+    /// with Root::Load. The Root objects of any previous call are released.
+    /// If loading a file throws an exception, the other files are still
+    /// loaded, and the exception of the first such file is then rethrown on
+    /// the calling thread.
+    /// \param[in] _filenames Names of the SDF files to parse.
+    /// \return The errors of each file, in the same order as _filenames.
+    /// An empty vector of errors indicates that the file was loaded without
+    /// error.
+    public: std::vector<Errors> Load(
+                const std::vector<std::string> &_filenames);
+
+    /// \brief Get the number of Root objects, which is the number of files
+    /// given to the last call to Load.
+    /// \return Number of Root objects.
+    public: uint64_t RootCount() const;
+
+    /// \brief Get the Root object of a file given to the last call to Load.
+    /// \param[in] _index Index of the file. The index should be in the
+    /// range [0..RootCount()).
+    /// \return Pointer to the Root object. Nullptr if the index does not
+    /// exist.
+    /// \sa uint64_t RootCount() const
+    public: const Root *RootByIndex(const uint64_t _index) const;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<BatchLoaderPrivate> dataPtr;
+  };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif
@@ -21,6 +21,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sdf/sdf_config.h>
@@ -148,6 +149,10 @@ namespace sdf
 
     /// \brief logfile stream
     public: std::ofstream logFileStream;
+
+    /// \brief Protects logFileStream, which messages from every thread are
+    /// written to.
+    public: std::mutex logFileMutex;
   };
 
   ///////////////////////////////////////////////
@@ -159,10 +164,12 @@ namespace sdf
       *this->stream << _rhs;
     }
 
-    if (Console::Instance()->dataPtr->logFileStream.is_open())
+    ConsolePtr console = Console::Instance();
+    std::lock_guard<std::mutex> lock(console->dataPtr->logFileMutex);
+    if (console->dataPtr->logFileStream.is_open())
     {
-      Console::Instance()->dataPtr->logFileStream << _rhs;
-      Console::Instance()->dataPtr->logFileStream.flush();
+      console->dataPtr->logFileStream << _rhs;
+      console->dataPtr->logFileStream.flush();
     }
 
     return *this;
@@ -20,6 +20,7 @@
 #include <tinyxml.h>
 
 #include <string>
+#include <vector>
 
 #include <sdf/sdf_config.h>
 #include "sdf/system_util.hh"
@@ -30,6 +31,9 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  // Forward declare private data class.
+  class ConvertRules;
+
   /// \brief Convert from one version of SDF to another
   class SDFORMAT_VISIBLE Converter
   {
@@ -53,16 +57,29 @@ namespace sdf
 
     /// \brief Implementation of Convert functionality.
     /// \param[in] _elem SDF xml element tree to convert.
-    /// \param[in] _convert Convert xml element tree.
+    /// \param[in] _rules Rules compiled from a convert xml element tree.
     private: static void ConvertImpl(TiXmlElement *_elem,
-                                     TiXmlElement *_convert);
+                                     const ConvertRules &_rules);
+
+    /// \brief Apply a chain of compiled rules to an element, with the same
+    /// result as applying each of them in turn with ConvertImpl.
+    /// Consecutive rules that only convert children, such as the rules of
+    /// successive SDF versions, are fused into a single pass over the
+    /// children.
+    /// \param[in] _elem SDF xml element tree to convert.
+    /// \param[in] _chain Rules to apply, in order.
+    private: static void ConvertChain(
+                 TiXmlElement *_elem,
+                 const std::vector<const ConvertRules *> &_chain);
 
     /// \brief Recursive helper function for ConvertImpl that converts
     /// elements named by the descendant_name attribute.
     /// \param[in] _e SDF xml element tree to convert.
-    /// \param[in] _c Convert xml element tree.
+    /// \param[in] _name Name of the descendants to convert.
+    /// \param[in] _rules Rules to apply to the descendants.
     private: static void ConvertDescendantsImpl(TiXmlElement *_e,
-                                                TiXmlElement *_c);
+                                                const std::string &_name,
+                                                const ConvertRules &_rules);
 
     /// \brief Rename an element or attribute.
     /// \param[in] _elem The element to be renamed, or the element which
@@ -107,7 +124,7 @@ namespace sdf
                                          TiXmlElement *_elem);
 
     private: static void CheckDeprecation(TiXmlElement *_elem,
-                                          TiXmlElement *_convert);
+                                          const ConvertRules &_rules);
   };
   }
 }
@@ -20,8 +20,10 @@
 #include <any>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -74,7 +76,8 @@ namespace sdf
     /// \brief Destructor.
     public: virtual ~Element();
 
-    /// \brief Create a copy of this Element.
+    /// \brief Create a copy of this Element. The element descriptions
+    /// are shared with the copy rather than duplicated.
     /// \return A copy of this Element.
     public: ElementPtr Clone() const;
 
@@ -138,6 +141,13 @@ namespace sdf
     /// \param[in] _prefix String value to prefix to the output.
     public: void PrintValues(std::string _prefix) const;
 
+    /// \brief Write Element's values to a stream, without building the
+    /// whole output in memory first.
+    /// \param[out] _out Stream to write to.
+    /// \param[in] _prefix String value to prefix to each line.
+    public: void PrintValues(std::ostream &_out,
+                             const std::string &_prefix = "") const;
+
     /// \brief Helper function for SDF::PrintDoc
     ///
     /// This generates the SDF html documentation.
@@ -356,8 +366,8 @@ namespace sdf
     ///        the embedded Param.
     public: void Update();
 
-    /// \brief Call reset on each element and element description
-    ///        before deleting all of them.  Also clear out the
+    /// \brief Call reset on each element before deleting all of them
+    ///        and release the element descriptions.  Also clear out the
     ///        embedded Param.
     public: void Reset();
 
@@ -393,7 +403,9 @@ namespace sdf
     /// \param[in] _desc the text description to set for the element.
     public: void SetDescription(const std::string &_desc);
 
-    /// \brief Add a new element description
+    /// \brief Add a new element description. Descriptions are shared
+    /// between clones of this element, so _elem should not be modified
+    /// once it has been added.
     /// \param[in] _elem the Element object to add to the descriptions.
     public: void AddElementDescription(ElementPtr _elem);
 
@@ -404,15 +416,20 @@ namespace sdf
 
     /// \brief Generate a string (XML) representation of this object.
     /// \param[in] _prefix arbitrary prefix to put on the string.
-    /// \param[out] _out the std::ostreamstream to write output to.
-    private: void ToString(const std::string &_prefix,
-                           std::ostringstream &_out) const;
+    /// \param[in] _depth Number of levels to indent each line after the
+    /// prefix.
+    /// \param[out] _out the std::ostream to write output to.
+    private: void ToString(const std::string &_prefix, unsigned int _depth,
+                           std::ostream &_out) const;
 
     /// \brief Generate a string (XML) representation of this object.
     /// \param[in] _prefix arbitrary prefix to put on the string.
-    /// \param[out] _out the std::ostreamstream to write output to.
+    /// \param[in] _depth Number of levels to indent each line after the
+    /// prefix.
+    /// \param[out] _out the std::ostream to write output to.
     private: void PrintValuesImpl(const std::string &_prefix,
-                                  std::ostringstream &_out) const;
+                                  unsigned int _depth,
+                                  std::ostream &_out) const;
 
     /// \brief Create a new Param object and return it.
     /// \param[in] _key Key for the parameter.
@@ -428,6 +445,22 @@ namespace sdf
                                   bool _required,
                                   const std::string &_description="");
 
+    /// \brief Update the cached index of each child element in this
+    /// element, starting from the given position.
+    /// \param[in] _start Position of the first child to update.
+    private: void UpdateChildIndices(ElementPtr_V::const_iterator _start);
+
+    /// \brief Rebuild the index used to look up child elements by name.
+    private: void RebuildElementIndex();
+
+    /// \brief Add an attribute and update the index used to look up
+    /// attributes by key.
+    /// \param[in] _param The attribute to add.
+    private: void AppendAttribute(ParamPtr _param);
+
+    /// \brief Allow BinaryCache to read and write the private data of
+    /// elements directly, without converting values to and from strings.
+    friend class BinaryCache;
 
     /// \brief Private data pointer
     private: std::unique_ptr<ElementPrivate> dataPtr;
@@ -437,11 +470,17 @@ namespace sdf
   /// \brief Private data for Element
   class ElementPrivate
   {
-    /// \brief Element name
-    public: std::string name;
+    /// \brief Element name, never null. Names from the spec point to
+    /// interned strings that are shared between elements. Other names,
+    /// such as those of copied user elements, point to ownedName.
+    public: const std::string *name;
+
+    /// \brief Owner of the name if it is not interned, shared with clones.
+    public: std::shared_ptr<const std::string> ownedName;
 
-    /// \brief True if element is required
-    public: std::string required;
+    /// \brief True if element is required. This and the reference SDF
+    /// name only take values from the spec, so they are always interned.
+    public: const std::string *required;
 
     /// \brief Element description
     public: std::string description;
@@ -455,20 +494,38 @@ namespace sdf
     // Attributes of this element
     public: Param_V attributes;
 
+    /// \brief Index of attributes by key. This is only populated for
+    /// elements with many attributes.
+    public: std::unordered_map<std::string, std::size_t> attributeIndex;
+
     // Value of this element
     public: ParamPtr value;
 
     // The existing child elements
     public: ElementPtr_V elements;
 
-    // The possible child elements
+    /// \brief Index of this element in its parent's elements. This is
+    /// used by GetNextElement to avoid searching for this element.
+    public: std::size_t indexInParent = 0;
+
+    /// \brief Index of the first child element with each name. This is
+    /// only populated for elements with many children.
+    public: std::unordered_map<std::string, std::size_t> elementIndex;
+
+    // The possible child elements. These are shared between clones and
+    // with the spec cache, and must not be modified.
     public: ElementPtr_V elementDescriptions;
 
+    /// \brief Index of element descriptions by name, shared along with
+    /// the descriptions. This is null for elements with few descriptions.
+    public: std::shared_ptr<const std::unordered_map<std::string, std::size_t>>
+        elementDescriptionIndex;
+
     /// name of the include file that was used to create this element
     public: std::string includeFilename;
 
     /// \brief Name of reference sdf.
-    public: std::string referenceSDF;
+    public: const std::string *referenceSDF;
 
     /// \brief Path to file where this element came from
     public: std::string path;
@@ -277,6 +277,23 @@ namespace sdf
     /// \sa Model::SetEnableWind(bool)
     public: void SetEnableWind(bool _enableWind);
 
+    /// \brief Load the visuals, collisions, lights, sensors and inertial of
+    /// the link if their loading was deferred by lazy loading, and get the
+    /// errors found while loading them. Without lazy loading these errors
+    /// are returned by Load instead.
+    /// \return Errors found while loading the deferred contents of the link.
+    /// \sa Root::SetLazyLoading
+    public: Errors ValidateAll() const;
+
+    /// \brief Pass the Pose Relative-To Graph of the link to the visuals,
+    /// collisions, lights and sensors that are loaded.
+    private: void SetChildPoseRelativeToGraph() const;
+
+    /// \brief Load the contents of the link if their loading was deferred
+    /// and they are not loaded yet. Errors found are printed, and kept for
+    /// ValidateAll.
+    private: void LoadDeferred() const;
+
     /// \brief Private data pointer.
     private: LinkPrivate *dataPtr = nullptr;
   };
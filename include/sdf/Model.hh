@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Element.hh"
 #include "sdf/SemanticPose.hh"
@@ -39,6 +40,34 @@ namespace sdf
   class ModelPrivate;
   struct PoseRelativeToGraph;
 
+  /// \brief Poses of every frame of a model, resolved to a single frame
+  /// by Model::ResolveAllPoses. The poses are index-aligned with the objects
+  /// of the model, so links[i] is the pose of LinkByIndex(i) and
+  /// visuals[i][j] is the pose of LinkByIndex(i)->VisualByIndex(j).
+  struct ModelPoses
+  {
+    /// \brief Poses of the links.
+    std::vector<ignition::math::Pose3d> links;
+
+    /// \brief Poses of the joints.
+    std::vector<ignition::math::Pose3d> joints;
+
+    /// \brief Poses of the explicit frames.
+    std::vector<ignition::math::Pose3d> frames;
+
+    /// \brief Poses of the visuals of each link.
+    std::vector<std::vector<ignition::math::Pose3d>> visuals;
+
+    /// \brief Poses of the collisions of each link.
+    std::vector<std::vector<ignition::math::Pose3d>> collisions;
+
+    /// \brief Poses of the sensors of each link.
+    std::vector<std::vector<ignition::math::Pose3d>> sensors;
+
+    /// \brief Poses of the lights of each link.
+    std::vector<std::vector<ignition::math::Pose3d>> lights;
+  };
+
   class SDFORMAT_VISIBLE Model
   {
     /// \brief Default constructor
@@ -279,6 +308,57 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the poses of all the links, joints, frames, visuals,
+    /// collisions, sensors and lights of the model in a single pass. This
+    /// is faster than resolving the SemanticPose of each of them.
+    /// \param[out] _poses The resolved poses. It is not changed if there
+    /// are errors.
+    /// \param[in] _resolveTo Name of the frame relative to which the poses
+    /// are resolved. An empty value resolves them to the model frame.
+    /// \return Errors if the frame to resolve to does not exist or the
+    /// poses can't be resolved.
+    public: Errors ResolveAllPoses(ModelPoses &_poses,
+                                   const std::string &_resolveTo = "") const;
+
+    /// \brief Set the raw pose of a link, joint or frame of a loaded model.
+    /// The graphs built by Load are updated in place, so only the poses of
+    /// the frames posed relative to it are computed again, and the model
+    /// doesn't need to be loaded again.
+    /// \param[in] _name Name of the link, joint or frame.
+    /// \param[in] _pose The new raw pose.
+    /// \return Errors if there is no such link, joint or frame, or Load
+    /// found errors in the graphs. The model is not changed if there are
+    /// errors.
+    public: Errors UpdateRawPose(const std::string &_name,
+                                 const ignition::math::Pose3d &_pose);
+
+    /// \brief Set the name of the frame relative to which the pose of a
+    /// link, joint or frame of a loaded model is expressed. The graphs
+    /// built by Load are updated in place, and only the frames posed
+    /// relative to it are checked for cycles.
+    /// \param[in] _name Name of the link, joint or frame.
+    /// \param[in] _relativeTo The new pose relative-to frame. An empty
+    /// value has the same meaning as an empty relative_to attribute.
+    /// \return Errors if there is no such link, joint or frame, the new
+    /// frame does not exist or causes a cycle, or Load found errors in the
+    /// graphs. The model is not changed if there are errors.
+    public: Errors UpdatePoseRelativeTo(const std::string &_name,
+                                        const std::string &_relativeTo);
+
+    /// \brief Set the name of the frame to which a frame of a loaded model
+    /// is attached. The graphs built by Load are updated in place, and only
+    /// the frames attached to it are checked for cycles. If the frame has
+    /// no pose relative-to frame, its pose is then relative to the new
+    /// attached-to frame.
+    /// \param[in] _frameName Name of the frame.
+    /// \param[in] _attachedTo The new attached-to frame. An empty value
+    /// attaches the frame to the model frame.
+    /// \return Errors if there is no such frame, the new frame does not
+    /// exist or causes a cycle, or Load found errors in the graphs. The
+    /// model is not changed if there are errors.
+    public: Errors UpdateFrameAttachedTo(const std::string &_frameName,
+                                         const std::string &_attachedTo);
+
     /// \brief Give a weak pointer to the PoseRelativeToGraph to be used
     /// for resolving poses. This is private and is intended to be called by
     /// World::Load.
@@ -289,6 +369,10 @@ namespace sdf
     /// \brief Allow World::Load to call SetPoseRelativeToGraph.
     friend class World;
 
+    /// \brief Allow checks run after Load to read the errors found while
+    /// building the graphs.
+    friend class LoadedGraphErrors;
+
     /// \brief Private data pointer.
     private: ModelPrivate *dataPtr = nullptr;
   };
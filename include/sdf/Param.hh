@@ -26,6 +26,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <typeinfo>
 #include <variant>
 #include <vector>
@@ -116,6 +117,11 @@ namespace sdf
     /// \return String containing the default value of the parameter.
     public: std::string GetDefaultAsString() const;
 
+    /// \brief Write the value to a stream, in the same format as
+    /// GetAsString. Numbers and strings are written without allocating.
+    /// \param[out] _out Stream to write to.
+    public: void WriteValue(std::ostream &_out) const;
+
     /// \brief Set the parameter value from a string.
     /// \param[in] _value New value for the parameter in string form.
     public: bool SetFromString(const std::string &_value);
@@ -162,6 +168,9 @@ namespace sdf
     /// \brief Set the parameter's value.
     ///
     /// The passed in value value must have an input and output stream operator.
+    /// Values of the type held by the parameter are stored at full precision
+    /// instead of being rounded through their string form. Rotations are
+    /// normalized, as they are when set from a string.
     /// \param[in] _value The value to set the parameter to.
     /// \return True if the value was successfully set.
     public: template<typename T>
@@ -211,10 +220,18 @@ namespace sdf
       return _out;
     }
 
+    /// \brief Private constructor used by Clone, which fills in the private
+    /// data itself.
+    private: Param();
+
     /// \brief Private method to set the Element from a passed-in string.
     /// \param[in] _value Value to set the parameter to.
     private: bool ValueFromString(const std::string &_value);
 
+    /// \brief Allow BinaryCache to read and write values in their native
+    /// type, and to construct params with the private constructor.
+    friend class BinaryCache;
+
     /// \brief Private data
     private: std::unique_ptr<ParamPrivate> dataPtr;
   };
@@ -223,8 +240,13 @@ namespace sdf
   /// \brief Private data for the param class
   class ParamPrivate
   {
-    /// \brief Key value
-    public: std::string key;
+    /// \brief Key value, never null. Keys from the spec point to interned
+    /// strings that are shared between params. Other keys, such as those
+    /// of copied user attributes, point to ownedKey.
+    public: const std::string *key;
+
+    /// \brief Owner of the key if it is not interned, shared with clones.
+    public: std::shared_ptr<const std::string> ownedKey;
 
     /// \brief True if the parameter is required.
     public: bool required;
@@ -232,8 +254,8 @@ namespace sdf
     /// \brief True if the parameter is set.
     public: bool set;
 
-    //// \brief Name of the type.
-    public: std::string typeName;
+    //// \brief Name of the type. Type names are always interned.
+    public: const std::string *typeName;
 
     /// \brief Description of the parameter.
     public: std::string description;
@@ -260,6 +282,17 @@ namespace sdf
     public: ParamVariant defaultValue;
   };
 
+  /// \internal
+  /// \brief True if T is one of the types of a variant.
+  template<typename T, typename Variant>
+  struct IsVariantAlternative : std::false_type {};
+
+  /// \internal
+  /// \brief True if T is one of the types of a variant.
+  template<typename T, typename... Ts>
+  struct IsVariantAlternative<T, std::variant<Ts...>>
+    : std::disjunction<std::is_same<T, Ts>...> {};
+
   ///////////////////////////////////////////////
   template<typename T>
   void Param::SetUpdateFunc(T _updateFunc)
@@ -271,6 +304,35 @@ namespace sdf
   template<typename T>
   bool Param::Set(const T &_value)
   {
+    // Assign values of the type held by this param directly, without
+    // converting them to and from a string. Strings still go through
+    // SetFromString, which trims them and treats empty strings as unset.
+    if constexpr (!std::is_same_v<T, std::string> &&
+        IsVariantAlternative<T, ParamPrivate::ParamVariant>::value)
+    {
+      if (std::holds_alternative<T>(this->dataPtr->value))
+      {
+        if constexpr (std::is_same_v<T, ignition::math::Quaterniond>)
+        {
+          ignition::math::Quaterniond rot = _value;
+          rot.Normalize();
+          this->dataPtr->value = rot;
+        }
+        else if constexpr (std::is_same_v<T, ignition::math::Pose3d>)
+        {
+          ignition::math::Pose3d pose = _value;
+          pose.Rot().Normalize();
+          this->dataPtr->value = pose;
+        }
+        else
+        {
+          this->dataPtr->value = _value;
+        }
+        this->dataPtr->set = true;
+        return true;
+      }
+    }
+
     try
     {
       std::stringstream ss;
@@ -280,7 +342,7 @@ namespace sdf
     catch(...)
     {
       sdferr << "Unable to set parameter["
-             << this->dataPtr->key << "]."
+             << *this->dataPtr->key << "]."
              << "Type used must have a stream input and output operator,"
              << "which allows proper functioning of Param.\n";
       return false;
@@ -293,7 +355,7 @@ namespace sdf
   {
     try
     {
-      if (typeid(T) == typeid(bool) && this->dataPtr->typeName == "string")
+      if (typeid(T) == typeid(bool) && *this->dataPtr->typeName == "string")
       {
         std::string strValue = std::get<std::string>(this->dataPtr->value);
         std::transform(strValue.begin(), strValue.end(), strValue.begin(),
@@ -329,9 +391,9 @@ namespace sdf
     catch(...)
     {
       sdferr << "Unable to convert parameter["
-             << this->dataPtr->key << "] "
+             << *this->dataPtr->key << "] "
              << "whose type is["
-             << this->dataPtr->typeName << "], to "
+             << *this->dataPtr->typeName << "], to "
              << "type[" << typeid(T).name() << "]\n";
       return false;
     }
@@ -352,9 +414,9 @@ namespace sdf
     catch(...)
     {
       sdferr << "Unable to convert parameter["
-             << this->dataPtr->key << "] "
+             << *this->dataPtr->key << "] "
              << "whose type is["
-             << this->dataPtr->typeName << "], to "
+             << *this->dataPtr->typeName << "], to "
              << "type[" << typeid(T).name() << "]\n";
       return false;
     }
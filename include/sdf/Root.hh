@@ -155,6 +155,34 @@ namespace sdf
     /// \return True if there exists an actor with the given name.
     public: bool ActorNameExists(const std::string &_name) const;
 
+    /// \brief Set whether Load defers the loading of the visuals,
+    /// collisions, lights, sensors and inertial of each link until they are
+    /// first accessed. This makes loading faster for users that only need
+    /// part of a document, such as the models and their poses. Errors in the
+    /// deferred contents are not returned by Load. They are printed when the
+    /// contents are loaded, and returned by ValidateAll.
+    ///
+    /// An object whose contents are loaded on access must not be accessed
+    /// from more than one thread before ValidateAll is called.
+    /// \param[in] _lazy True to enable lazy loading. It is disabled by
+    /// default.
+    /// \sa Errors ValidateAll() const
+    public: void SetLazyLoading(const bool _lazy);
+
+    /// \brief Get whether Load defers the loading of the contents of links.
+    /// \return True if lazy loading is enabled.
+    /// \sa void SetLazyLoading(const bool _lazy)
+    public: bool LazyLoading() const;
+
+    /// \brief Load every part of the document that was deferred by lazy
+    /// loading, and get the errors found while loading them. Together with
+    /// the errors returned by Load, these are the errors that Load returns
+    /// when lazy loading is disabled.
+    /// \return Errors found while loading the deferred parts of the
+    /// document. An empty vector indicates no error.
+    /// \sa void SetLazyLoading(const bool _lazy)
+    public: Errors ValidateAll() const;
+
     /// \brief Get a pointer to the SDF element that was generated during
     /// load.
     /// \return SDF element pointer. The value will be nullptr if Load has
@@ -17,6 +17,7 @@
 #ifndef SDFIMPL_HH_
 #define SDFIMPL_HH_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -78,6 +79,74 @@ namespace sdf
   SDFORMAT_VISIBLE
   void setFindCallback(std::function<std::string (const std::string &)> _cb);
 
+  /// \brief Enable or disable the cache of findFile results. When enabled,
+  /// findFile remembers the path found for each file, and the files it
+  /// could not find, until addURIPath, setFindCallback or
+  /// clearFindFileCache is called. Files added or removed later, and
+  /// changes to the working directory or SDF_PATH, are not noticed until
+  /// then. Disabled by default.
+  /// \param[in] _enabled True to enable the cache.
+  SDFORMAT_VISIBLE
+  void setFindFileCacheEnabled(const bool _enabled);
+
+  /// \brief Get whether the cache of findFile results is enabled.
+  /// \return True if the cache is enabled.
+  /// \sa setFindFileCacheEnabled
+  SDFORMAT_VISIBLE
+  bool findFileCacheEnabled();
+
+  /// \brief Enable or disable the index of the paths added by addURIPath.
+  /// When enabled, the entries of each path are listed once, and findFile
+  /// skips a path that does not contain the first directory of the file
+  /// name without checking the filesystem. Entries added to the paths later
+  /// are not noticed until clearFindFileCache is called. Disabled by
+  /// default.
+  /// \param[in] _enabled True to enable the index.
+  SDFORMAT_VISIBLE
+  void setURIPathIndexEnabled(const bool _enabled);
+
+  /// \brief Get whether the index of the paths added by addURIPath is
+  /// enabled.
+  /// \return True if the index is enabled.
+  /// \sa setURIPathIndexEnabled
+  SDFORMAT_VISIBLE
+  bool uriPathIndexEnabled();
+
+  /// \brief Forget the results cached by findFile and the index of the
+  /// paths added by addURIPath.
+  SDFORMAT_VISIBLE
+  void clearFindFileCache();
+
+  /// \brief Counters of the work done by findFile.
+  /// \sa findFileStats
+  struct FindFileStats
+  {
+    /// \brief Lookups answered by a cached path.
+    uint64_t hits = 0;
+
+    /// \brief Lookups answered by a cached failure to find the file.
+    uint64_t negativeHits = 0;
+
+    /// \brief Lookups that searched for the file.
+    uint64_t misses = 0;
+
+    /// \brief Paths added by addURIPath that the index ruled out without
+    /// checking the filesystem.
+    uint64_t indexSkips = 0;
+  };
+
+  /// \brief Get the counters of the work done by findFile since the last
+  /// call to resetFindFileStats. Lookups are only counted while the cache
+  /// of findFile results is enabled, and index skips while the index of
+  /// the paths added by addURIPath is enabled.
+  /// \return The counters.
+  SDFORMAT_VISIBLE
+  FindFileStats findFileStats();
+
+  /// \brief Set the counters returned by findFileStats to zero.
+  SDFORMAT_VISIBLE
+  void resetFindFileStats();
+
 
   /// \brief Base SDF class
   class SDFORMAT_VISIBLE SDF
@@ -18,11 +18,14 @@
 #define SDF_WORLD_HH_
 
 #include <string>
+#include <vector>
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "sdf/Atmosphere.hh"
 #include "sdf/Element.hh"
 #include "sdf/Gui.hh"
+#include "sdf/Model.hh"
 #include "sdf/Scene.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
@@ -42,6 +45,25 @@ namespace sdf
   class Physics;
   class WorldPrivate;
 
+  /// \brief Poses of every frame of a world, resolved to a single frame by
+  /// World::ResolveAllPoses. The poses are index-aligned with the objects of
+  /// the world, so models[i] is the pose of ModelByIndex(i).
+  struct WorldPoses
+  {
+    /// \brief Poses of the models.
+    std::vector<ignition::math::Pose3d> models;
+
+    /// \brief Poses of the explicit frames.
+    std::vector<ignition::math::Pose3d> frames;
+
+    /// \brief Poses of the lights.
+    std::vector<ignition::math::Pose3d> lights;
+
+    /// \brief Poses of the frames of each model, resolved to the same frame
+    /// as the other poses.
+    std::vector<ModelPoses> modelContents;
+  };
+
   class SDFORMAT_VISIBLE World
   {
     /// \brief Default constructor
@@ -269,6 +291,22 @@ namespace sdf
     /// \return True if there exists a physics profile with the given name.
     public: bool PhysicsNameExists(const std::string &_name) const;
 
+    /// \brief Resolve the poses of all the models, frames and lights of the
+    /// world, and of the contents of each model, in a single pass.
+    /// \param[out] _poses The resolved poses. It is not changed if there
+    /// are errors.
+    /// \param[in] _resolveTo Name of the frame relative to which the poses
+    /// are resolved. An empty value resolves them to the world frame.
+    /// \return Errors if the frame to resolve to does not exist or the
+    /// poses can't be resolved.
+    /// \sa Model::ResolveAllPoses
+    public: Errors ResolveAllPoses(WorldPoses &_poses,
+                                   const std::string &_resolveTo = "") const;
+
+    /// \brief Allow checks run after Load to read the errors found while
+    /// building the graphs.
+    friend class LoadedGraphErrors;
+
     /// \brief Private data pointer.
     private: WorldPrivate *dataPtr = nullptr;
   };
@@ -33,6 +33,13 @@
 ///
 /// XML elements that are not part of the SDF specification are copied in
 /// place. This preserves the given XML structure and data.
+///
+/// Independent files and strings can be parsed on different threads at the
+/// same time, with the parsing functions or sdf::Root::Load, as long as each
+/// thread uses its own SDF, Element and Root objects. The paths registered
+/// with sdf::addURIPath and sdf::setFindCallback are shared by all threads,
+/// and a find callback may be called from several threads at once. URDF
+/// files are converted one at a time.
 namespace sdf
 {
   // Inline bracket to help doxygen filtering.
@@ -188,6 +195,139 @@ namespace sdf
   SDFORMAT_VISIBLE
   void addNestedModel(ElementPtr _sdf, ElementPtr _includeSDF);
 
+  /// \brief Set whether the files included by an SDF element are read in
+  /// parallel. When enabled, the model files of the <include> elements that
+  /// are children of the same element are found and parsed on a pool of
+  /// threads. The results are still added in document order, so the parsed
+  /// SDF is the same as when the files are read one at a time. The callback
+  /// set with sdf::setFindCallback may then be called from several threads
+  /// at once. This is disabled by default.
+  /// \param[in] _parallel True to read included files in parallel.
+  /// \sa bool parallelIncludes()
+  SDFORMAT_VISIBLE
+  void setParallelIncludes(const bool _parallel);
+
+  /// \brief Get whether the files included by an SDF element are read in
+  /// parallel.
+  /// \return True if included files are read in parallel.
+  /// \sa void setParallelIncludes(const bool _parallel)
+  SDFORMAT_VISIBLE
+  bool parallelIncludes();
+
+  /// \brief Set whether SDF files and strings are read with a streaming
+  /// parser. When enabled, the elements of a document are built as its XML
+  /// is read, instead of from a TinyXML document of the whole file, which
+  /// lowers the peak memory and time needed to read large files. The parsed
+  /// SDF is the same. Documents that must be converted to the current
+  /// version, URDF files, and documents with errors are still read with
+  /// TinyXML. Included files are read one at a time, even when
+  /// sdf::parallelIncludes() is enabled. This is disabled by default.
+  /// \param[in] _streaming True to read documents with the streaming
+  /// parser.
+  /// \sa bool streamingParser()
+  SDFORMAT_VISIBLE
+  void setStreamingParser(const bool _streaming);
+
+  /// \brief Get whether SDF files and strings are read with a streaming
+  /// parser.
+  /// \return True if documents are read with the streaming parser.
+  /// \sa void setStreamingParser(const bool _streaming)
+  SDFORMAT_VISIBLE
+  bool streamingParser();
+
+  /// \brief Set whether SDF files are read from binary cache files. When
+  /// enabled, readFile looks for a cache file in the directory set by
+  /// setBinaryCacheDirectory, or next to the SDF file, named after it with
+  /// ".sdfcache" appended. If the cache file was written for the current
+  /// spec version, and the SDF file did not change, the document is loaded
+  /// from it without parsing any XML. Otherwise the SDF file is read as
+  /// usual, and the cache file is written if the file was read without
+  /// errors. Files with <include> elements are not cached, since their
+  /// includes may resolve to other models the next time they are read.
+  /// Files read without conversion are not cached either. This is disabled
+  /// by default.
+  /// \param[in] _enabled True to read SDF files from binary cache files.
+  /// \sa bool binaryCache()
+  SDFORMAT_VISIBLE
+  void setBinaryCache(const bool _enabled);
+
+  /// \brief Get whether SDF files are read from binary cache files.
+  /// \return True if SDF files are read from binary cache files.
+  /// \sa void setBinaryCache(const bool _enabled)
+  SDFORMAT_VISIBLE
+  bool binaryCache();
+
+  /// \brief Set the directory that readFile reads and writes binary cache
+  /// files in, for example when the SDF files are in a read-only directory.
+  /// In this directory, each cache file is named after its SDF file and a
+  /// hash of the path of the SDF file. The directory must exist. An empty
+  /// string, the default, puts each cache file next to its SDF file.
+  /// \param[in] _directory Path of the directory.
+  /// \sa std::string binaryCacheDirectory()
+  /// \sa void setBinaryCache(const bool _enabled)
+  SDFORMAT_VISIBLE
+  void setBinaryCacheDirectory(const std::string &_directory);
+
+  /// \brief Get the directory that readFile reads and writes binary cache
+  /// files in.
+  /// \return Path of the directory, or an empty string if cache files are
+  /// next to their SDF files.
+  /// \sa void setBinaryCacheDirectory(const std::string &_directory)
+  SDFORMAT_VISIBLE
+  std::string binaryCacheDirectory();
+
+  /// \brief Write a parsed SDF document to a binary cache file. The file
+  /// records the spec version and the contents of the files the document
+  /// was read from, so readBinaryCache rejects it when one of them changes.
+  /// It does not record how the uris of <include> elements were resolved,
+  /// so a document with includes is still read from the cache file after
+  /// its includes would resolve to other models.
+  /// \param[in] _filename Path of the cache file.
+  /// \param[in] _sdf The document.
+  /// \return True if the cache file was written.
+  /// \sa bool readBinaryCache(const std::string &_filename, SDFPtr _sdf)
+  SDFORMAT_VISIBLE
+  bool writeBinaryCache(const std::string &_filename, const SDFPtr _sdf);
+
+  /// \brief Read a parsed SDF document from a binary cache file written by
+  /// writeBinaryCache.
+  /// \param[in] _filename Path of the cache file.
+  /// \param[in,out] _sdf An SDF object initialized with sdf::init, which
+  /// the document is read into. It is left unchanged if the cache file is
+  /// not read.
+  /// \return True if the document was read. False if the cache file does
+  /// not exist, is not valid, was written for another spec version, or one
+  /// of the files the document was read from changed.
+  SDFORMAT_VISIBLE
+  bool readBinaryCache(const std::string &_filename, SDFPtr _sdf);
+
+  /// \brief Set whether the models found for <include> elements are kept
+  /// in a process-wide cache. When enabled, a model directory that is
+  /// included several times is parsed once, and each include gets a copy of
+  /// the parsed model. A cached model is read again when its model.config
+  /// or model file changes size or modification time. Changes to the files
+  /// that the model itself includes are not detected, so call
+  /// clearIncludeCache after changing them. Disabling the cache also clears
+  /// it. This is disabled by default.
+  /// \param[in] _enabled True to cache included models.
+  /// \sa bool includeCache()
+  /// \sa void clearIncludeCache()
+  SDFORMAT_VISIBLE
+  void setIncludeCache(const bool _enabled);
+
+  /// \brief Get whether the models found for <include> elements are kept
+  /// in a process-wide cache.
+  /// \return True if included models are cached.
+  /// \sa void setIncludeCache(const bool _enabled)
+  SDFORMAT_VISIBLE
+  bool includeCache();
+
+  /// \brief Remove all the models from the include cache, so they are read
+  /// again the next time they are included.
+  /// \sa void setIncludeCache(const bool _enabled)
+  SDFORMAT_VISIBLE
+  void clearIncludeCache();
+
   /// \brief Convert an SDF file to a specific SDF version.
   /// \param[in] _filename Name of the SDF file to convert.
   /// \param[in] _version Version to convert _filename to.
@@ -222,6 +362,8 @@ namespace sdf
   /// leads to a model, link, or world frame.
   /// This checks recursively and should check the files exhaustively
   /// rather than terminating early when the first error is found.
+  /// Graphs that were built by Root::Load are not built again; the errors
+  /// found while loading them are reported instead.
   /// \param[in] _root sdf Root object to check recursively.
   /// \return True if all attached_to graphs are valid.
   SDFORMAT_VISIBLE
@@ -254,6 +396,8 @@ namespace sdf
   /// leads to a model, link, or world frame.
   /// This checks recursively and should check the files exhaustively
   /// rather than terminating early when the first error is found.
+  /// Graphs that were built by Root::Load are not built again; the errors
+  /// found while loading them are reported instead.
   /// \param[in] _root sdf Root object to check recursively.
   /// \return True if all attached_to graphs are valid.
   SDFORMAT_VISIBLE
@@ -72,6 +72,14 @@ namespace sdf
   /// the SDF spec. Set this to false to copy everything.
   void copyChildren(ElementPtr _sdf, TiXmlElement *_xml,
                     const bool _onlyUnknown);
+
+  /// \brief For internal use only. Set whether the <include> elements read
+  /// on the current thread are read one at a time, even if
+  /// setParallelIncludes is enabled. This is used by threads that already
+  /// run in parallel with others, such as the workers of a BatchLoader.
+  /// \param[in] _serial True to read includes one at a time on this thread.
+  /// \return The previous value for this thread.
+  bool setSerialIncludes(const bool _serial);
   }
 }
 #endif
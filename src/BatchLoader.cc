@@ -0,0 +1,149 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "sdf/BatchLoader.hh"
+#include "sdf/Root.hh"
+#include "sdf/parser_private.hh"
+#include "SDFImplPrivate.hh"
+
+using namespace sdf;
+
+/// \brief Private data for sdf::BatchLoader
+class sdf::BatchLoaderPrivate
+{
+  /// \brief Number of worker threads, or zero to use one per hardware
+  /// thread.
+  public: unsigned int threadCount = 0;
+
+  /// \brief The Root objects of the files given to the last call to Load.
+  public: std::vector<std::unique_ptr<Root>> roots;
+};
+
+/////////////////////////////////////////////////
+BatchLoader::BatchLoader()
+  : dataPtr(new BatchLoaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BatchLoader::~BatchLoader()
+{
+}
+
+/////////////////////////////////////////////////
+void BatchLoader::SetThreadCount(const unsigned int _count)
+{
+  this->dataPtr->threadCount = _count;
+}
+
+/////////////////////////////////////////////////
+unsigned int BatchLoader::ThreadCount() const
+{
+  if (this->dataPtr->threadCount > 0)
+    return this->dataPtr->threadCount;
+
+  // hardware_concurrency returns zero if the count is not known.
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/////////////////////////////////////////////////
+std::vector<Errors> BatchLoader::Load(
+    const std::vector<std::string> &_filenames)
+{
+  std::vector<Errors> errors(_filenames.size());
+
+  this->dataPtr->roots.clear();
+  this->dataPtr->roots.reserve(_filenames.size());
+  for (size_t i = 0; i < _filenames.size(); ++i)
+    this->dataPtr->roots.emplace_back(new Root);
+
+  // An exception must not leave a worker thread, so the exception of each
+  // file is kept and rethrown once every thread is joined.
+  std::vector<std::exception_ptr> exceptions(_filenames.size());
+
+  // Each worker takes the next file that has not been started, so a few
+  // large files do not leave the other workers idle.
+  std::atomic<size_t> next(0);
+  auto worker = [&]()
+  {
+    // The workers already use every hardware thread, so the files included
+    // by each file are read on its worker rather than on more threads.
+    FindFileCacheScope scope;
+    const bool serialIncludes = setSerialIncludes(true);
+    for (size_t i = next++; i < _filenames.size(); i = next++)
+    {
+      try
+      {
+        errors[i] = this->dataPtr->roots[i]->Load(_filenames[i]);
+      }
+      catch(...)
+      {
+        exceptions[i] = std::current_exception();
+      }
+    }
+    setSerialIncludes(serialIncludes);
+  };
+
+  // The calling thread is one of the workers. If a thread can't be started,
+  // the files are loaded by the threads that were.
+  const size_t threadCount =
+    std::min<size_t>(this->ThreadCount(), _filenames.size());
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+  try
+  {
+    for (size_t i = 1; i < threadCount; ++i)
+      threads.emplace_back(worker);
+  }
+  catch(const std::system_error &)
+  {
+  }
+  worker();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  for (const std::exception_ptr &exception : exceptions)
+  {
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+uint64_t BatchLoader::RootCount() const
+{
+  return this->dataPtr->roots.size();
+}
+
+/////////////////////////////////////////////////
+const Root *BatchLoader::RootByIndex(const uint64_t _index) const
+{
+  if (_index < this->dataPtr->roots.size())
+    return this->dataPtr->roots[_index].get();
+  return nullptr;
+}
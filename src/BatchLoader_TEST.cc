@@ -0,0 +1,172 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <functional>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "sdf/BatchLoader.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/World.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(DOMBatchLoader, Construction)
+{
+  sdf::BatchLoader loader;
+  EXPECT_LE(1u, loader.ThreadCount());
+  EXPECT_EQ(0u, loader.RootCount());
+  EXPECT_EQ(nullptr, loader.RootByIndex(0));
+
+  loader.SetThreadCount(3);
+  EXPECT_EQ(3u, loader.ThreadCount());
+
+  EXPECT_TRUE(loader.Load({}).empty());
+  EXPECT_EQ(0u, loader.RootCount());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMBatchLoader, Load)
+{
+  const std::string testDir =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf");
+  const std::string modelFile =
+    sdf::filesystem::append(testDir, "model_link_relative_to.sdf");
+  const std::string missingFile =
+    sdf::filesystem::append(testDir, "does_not_exist.sdf");
+  const std::string invalidFile =
+    sdf::filesystem::append(testDir, "world_duplicate.sdf");
+
+  std::vector<std::string> files;
+  for (int i = 0; i < 10; ++i)
+    files.push_back(modelFile);
+  files.push_back(missingFile);
+  files.push_back(invalidFile);
+
+  for (unsigned int threads : {1u, 4u})
+  {
+    sdf::BatchLoader loader;
+    loader.SetThreadCount(threads);
+    std::vector<sdf::Errors> errors = loader.Load(files);
+
+    ASSERT_EQ(files.size(), errors.size());
+    ASSERT_EQ(files.size(), loader.RootCount());
+    EXPECT_EQ(nullptr, loader.RootByIndex(files.size()));
+
+    // Results are in the same order as the files.
+    for (size_t i = 0; i < 10; ++i)
+    {
+      EXPECT_TRUE(errors[i].empty());
+      const sdf::Root *root = loader.RootByIndex(i);
+      ASSERT_NE(nullptr, root);
+      ASSERT_EQ(1u, root->ModelCount());
+      EXPECT_EQ("model_link_relative_to", root->ModelByIndex(0)->Name());
+    }
+    EXPECT_FALSE(errors[10].empty());
+    EXPECT_EQ(0u, loader.RootByIndex(10)->ModelCount());
+    EXPECT_FALSE(errors[11].empty());
+  }
+}
+
+/////////////////////////////////////////////////
+/// An exception thrown while loading a file is rethrown on the calling
+/// thread, once the other files are loaded.
+TEST(DOMBatchLoader, Exception)
+{
+  const std::string testDir =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf");
+  const std::string modelFile =
+    sdf::filesystem::append(testDir, "model_link_relative_to.sdf");
+  const std::string missingFile =
+    sdf::filesystem::append(testDir, "does_not_exist.sdf");
+
+  std::vector<std::string> files(9, modelFile);
+  files[4] = missingFile;
+
+  // Looking for the missing file calls the find callback, which throws.
+  sdf::setFindCallback([](const std::string &) -> std::string
+    {
+      throw std::runtime_error("find callback");
+    });
+
+  for (unsigned int threads : {1u, 4u})
+  {
+    sdf::BatchLoader loader;
+    loader.SetThreadCount(threads);
+    EXPECT_THROW(loader.Load(files), std::runtime_error);
+
+    ASSERT_EQ(files.size(), loader.RootCount());
+    for (size_t i : {0u, 8u})
+    {
+      ASSERT_NE(nullptr, loader.RootByIndex(i));
+      EXPECT_EQ(1u, loader.RootByIndex(i)->ModelCount());
+    }
+  }
+
+  sdf::setFindCallback(std::function<std::string(const std::string &)>());
+}
+
+/////////////////////////////////////////////////
+/// With parallel includes enabled, the files included by the files of a
+/// batch are read on the worker of each file, instead of each worker
+/// starting a thread per hardware thread.
+TEST(DOMBatchLoader, ParallelIncludes)
+{
+  const std::string worldFile = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "sdf", "includes.sdf");
+
+  std::mutex mutex;
+  std::set<std::thread::id> findThreads;
+  sdf::setFindCallback([&](const std::string &_uri)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      findThreads.insert(std::this_thread::get_id());
+      return sdf::filesystem::append(PROJECT_SOURCE_PATH, "test",
+                                     "integration", "model", _uri);
+    });
+  sdf::setParallelIncludes(true);
+
+  sdf::BatchLoader loader;
+  loader.SetThreadCount(1);
+  std::vector<sdf::Errors> errors = loader.Load({worldFile, worldFile});
+
+  ASSERT_EQ(2u, errors.size());
+  for (size_t i = 0; i < errors.size(); ++i)
+  {
+    EXPECT_TRUE(errors[i].empty());
+    ASSERT_NE(nullptr, loader.RootByIndex(i));
+    ASSERT_EQ(1u, loader.RootByIndex(i)->WorldCount());
+    EXPECT_EQ(1u, loader.RootByIndex(i)->WorldByIndex(0)->ModelCount());
+  }
+
+  // The only worker is the calling thread.
+  ASSERT_FALSE(findThreads.empty());
+  EXPECT_EQ(1u, findThreads.size());
+  EXPECT_EQ(1u, findThreads.count(std::this_thread::get_id()));
+
+  sdf::setParallelIncludes(false);
+  sdf::setFindCallback(std::function<std::string(const std::string &)>());
+}
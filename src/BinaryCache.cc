@@ -0,0 +1,920 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "sdf/Console.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Types.hh"
+#include "sdf/parser.hh"
+
+#include "BinaryCache.hh"
+#include "MappedFile.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+/// \brief Identifies a binary cache file.
+static const char kMagic[4] = {'S', 'D', 'F', 'B'};
+
+/// \brief Version of the format, increased when it changes.
+static const uint32_t kFormatVersion = 1;
+
+/// \brief Written in the byte order of the machine, so files written on a
+/// machine with a different byte order are rejected.
+static const uint32_t kByteOrderMark = 0x01020304;
+
+/// \brief Element descriptions of an element that has none.
+static const uint8_t kNoDescriptions = 0;
+
+/// \brief Element descriptions taken from the description of the element
+/// in its parent, or from the SDF object for the root.
+static const uint8_t kParentDescriptions = 1;
+
+/// \brief Element descriptions taken from the spec file referenced by the
+/// description of the element in its parent.
+static const uint8_t kReferenceDescriptions = 2;
+
+/// \brief Flag of an element with copyChildren set.
+static const uint8_t kCopyChildren = 1;
+
+/// \brief Flag of an element with a value.
+static const uint8_t kHasValue = 2;
+
+/// \brief Flag of a required param.
+static const uint8_t kRequired = 1;
+
+/// \brief Flag of a param that has been set.
+static const uint8_t kSet = 2;
+
+/// \brief Flag of a param whose default value is the same as its value, in
+/// which case the default value is not stored.
+static const uint8_t kDefaultIsValue = 4;
+
+//////////////////////////////////////////////////
+/// \brief Hash the contents of a file, to tell whether it changed after it
+/// was cached. This is FNV-1a over 64 bit words, which is fast and changes
+/// with any change of the contents, but is not a cryptographic hash.
+/// \param[in] _data The contents.
+/// \param[in] _size Size of the contents in bytes.
+/// \return The hash.
+static uint64_t hashData(const char *_data, const size_t _size)
+{
+  const uint64_t prime = 1099511628211ull;
+  uint64_t hash = 14695981039346656037ull;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= _size; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, _data + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+  for (; i < _size; ++i)
+  {
+    hash = (hash ^ static_cast<unsigned char>(_data[i])) * prime;
+  }
+  return hash;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the path of the model.config file in the directory of a
+/// file. It chooses the file that is read when the model is included.
+/// \param[in] _path Path of the file.
+/// \return Path of the model.config file, or an empty string if the path
+/// has no directory.
+static std::string modelConfigPath(const std::string &_path)
+{
+  const size_t separator = _path.find_last_of("/\\");
+  if (separator == std::string::npos)
+    return "";
+  return _path.substr(0, separator + 1) + "model.config";
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the element descriptions of a spec file, such as those of a
+/// nested model, which the description of an element refers to.
+/// \param[in,out] _references Descriptions already found, keyed by the
+/// name of the spec file.
+/// \param[in] _name Name of the spec file, without the ".sdf" extension.
+/// \return Element holding the descriptions.
+static ElementPtr referencedSpec(
+    std::map<std::string, ElementPtr> &_references,
+    const std::string &_name)
+{
+  ElementPtr &spec = _references[_name];
+  if (!spec)
+  {
+    spec.reset(new Element);
+    initFile(_name + ".sdf", spec);
+  }
+  return spec;
+}
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+  /// \brief Writes the data of a cache file to a buffer.
+  class BinaryCacheWriter
+  {
+    /// \brief Write a value as its bytes.
+    /// \param[in] _value The value.
+    public: template<typename T>
+            void Raw(const T &_value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "Not a plain value");
+      this->data.append(reinterpret_cast<const char *>(&_value),
+                        sizeof(_value));
+    }
+
+    /// \brief Write an unsigned number in as few bytes as possible, seven
+    /// bits at a time.
+    /// \param[in] _value The number.
+    public: void Varint(uint64_t _value)
+    {
+      while (_value >= 0x80)
+      {
+        this->data.push_back(static_cast<char>((_value & 0x7F) | 0x80));
+        _value >>= 7;
+      }
+      this->data.push_back(static_cast<char>(_value));
+    }
+
+    /// \brief Write a string as its size and characters.
+    /// \param[in] _value The string.
+    public: void RawString(const std::string &_value)
+    {
+      this->Varint(_value.size());
+      this->data.append(_value);
+    }
+
+    /// \brief Write a string as its index in the string table.
+    /// \param[in] _value The string.
+    public: void String(const std::string &_value)
+    {
+      this->Varint(this->Index(_value));
+    }
+
+    /// \brief Write an interned string as its index in the string table.
+    /// Interned strings are looked up by address first, which saves hashing
+    /// names that are shared by many elements.
+    /// \param[in] _value The interned string.
+    public: void String(const std::string *_value)
+    {
+      auto iter = this->internedIndex.find(_value);
+      if (iter == this->internedIndex.end())
+        iter = this->internedIndex.emplace(_value, this->Index(*_value)).first;
+      this->Varint(iter->second);
+    }
+
+    /// \brief Get the index of a string in the string table, adding it to
+    /// the table if it is not there yet.
+    /// \param[in] _value The string.
+    /// \return The index.
+    private: uint64_t Index(const std::string &_value)
+    {
+      auto iter = this->stringIndex.find(_value);
+      if (iter == this->stringIndex.end())
+      {
+        iter = this->stringIndex.emplace(_value, this->strings.size()).first;
+        this->strings.push_back(&iter->first);
+      }
+      return iter->second;
+    }
+
+    /// \brief The data written.
+    public: std::string data;
+
+    /// \brief The string table, in order of index.
+    public: std::vector<const std::string *> strings;
+
+    /// \brief Index of each string in the string table.
+    public: std::unordered_map<std::string, uint64_t> stringIndex;
+
+    /// \brief Index of each interned string in the string table.
+    public: std::unordered_map<const std::string *, uint64_t> internedIndex;
+
+    /// \brief Paths of the files that elements were read from.
+    public: std::unordered_set<std::string> paths;
+
+    /// \brief Spec files referenced by element descriptions.
+    public: std::map<std::string, ElementPtr> references;
+  };
+
+  /// \brief Reads the data of a cache file. Reads past the end of the data
+  /// return zero values and mark the reader as failed.
+  class BinaryCacheReader
+  {
+    /// \brief Constructor.
+    /// \param[in] _data Start of the data.
+    /// \param[in] _size Size of the data in bytes.
+    public: BinaryCacheReader(const char *_data, const size_t _size)
+            : data(_data), end(_data + _size)
+    {
+    }
+
+    /// \brief Read a value from its bytes.
+    /// \return The value.
+    public: template<typename T>
+            T Raw()
+    {
+      T value{};
+      if (static_cast<size_t>(this->end - this->data) < sizeof(T))
+      {
+        this->ok = false;
+        this->data = this->end;
+        return value;
+      }
+      std::memcpy(&value, this->data, sizeof(T));
+      this->data += sizeof(T);
+      return value;
+    }
+
+    /// \brief Read an unsigned number written by BinaryCacheWriter::Varint.
+    /// \return The number.
+    public: uint64_t Varint()
+    {
+      uint64_t value = 0;
+      for (int shift = 0; shift < 64; shift += 7)
+      {
+        if (this->data == this->end)
+          break;
+        const auto byte = static_cast<unsigned char>(*this->data++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+          return value;
+      }
+      this->ok = false;
+      this->data = this->end;
+      return 0;
+    }
+
+    /// \brief Read a count of items that take at least one byte each.
+    /// \return The count, or 0 if it is larger than the data left.
+    public: size_t Count()
+    {
+      const uint64_t count = this->Varint();
+      if (count > static_cast<uint64_t>(this->end - this->data))
+      {
+        this->ok = false;
+        this->data = this->end;
+        return 0;
+      }
+      return static_cast<size_t>(count);
+    }
+
+    /// \brief Read a string written by BinaryCacheWriter::RawString.
+    /// \return The string.
+    public: std::string RawString()
+    {
+      const size_t size = this->Count();
+      std::string value(this->data, size);
+      this->data += size;
+      return value;
+    }
+
+    /// \brief Read a string written by BinaryCacheWriter::String.
+    /// \return The string, or an empty string if it is not in the table.
+    public: const std::string &String()
+    {
+      static const std::string empty;
+      const uint64_t index = this->Varint();
+      if (index >= this->strings.size())
+      {
+        this->ok = false;
+        return empty;
+      }
+      return this->strings[index];
+    }
+
+    /// \brief Read a string written by BinaryCacheWriter::String, and
+    /// intern it.
+    /// \return The interned string.
+    public: const std::string *InternedString()
+    {
+      const uint64_t index = this->Varint();
+      if (index >= this->strings.size())
+      {
+        this->ok = false;
+        return internString("");
+      }
+      if (!this->interned[index])
+        this->interned[index] = internString(this->strings[index]);
+      return this->interned[index];
+    }
+
+    /// \brief Read a string written by BinaryCacheWriter::String, and
+    /// share it as with sdf::shareString. Each string is copied at most
+    /// once, and the copy is shared by everything that reads it.
+    /// \param[out] _owned Owner of the string, or null if it is interned.
+    /// \return The shared string.
+    public: const std::string *SharedString(
+        std::shared_ptr<const std::string> &_owned)
+    {
+      const uint64_t index = this->Varint();
+      if (index >= this->strings.size())
+      {
+        this->ok = false;
+        _owned.reset();
+        return internString("");
+      }
+      if (!this->shared[index])
+      {
+        this->shared[index] =
+          shareString(this->strings[index], this->owned[index]);
+      }
+      _owned = this->owned[index];
+      return this->shared[index];
+    }
+
+    /// \brief The data left to read.
+    public: const char *data;
+
+    /// \brief End of the data.
+    public: const char *end;
+
+    /// \brief False if the data is not valid.
+    public: bool ok = true;
+
+    /// \brief The string table.
+    public: std::vector<std::string> strings;
+
+    /// \brief Interned copies of the strings in the table, made on first
+    /// use since most param values never need to be interned.
+    public: std::vector<const std::string *> interned;
+
+    /// \brief Shared copies of the strings in the table, made on first use.
+    public: std::vector<const std::string *> shared;
+
+    /// \brief Owners of the shared strings that are not interned.
+    public: std::vector<std::shared_ptr<const std::string>> owned;
+
+    /// \brief Root element of the SDF object that the document is read
+    /// into, which holds the element descriptions of the root.
+    public: ElementPtr root;
+
+    /// \brief Spec files referenced by element descriptions.
+    public: std::map<std::string, ElementPtr> references;
+  };
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a param value in its native type.
+/// \param[in,out] _writer Writer of the element tree.
+/// \param[in] _value The value.
+template<typename T>
+static void writeValue(BinaryCacheWriter &_writer, const T &_value)
+{
+  if constexpr (std::is_same_v<T, std::string>)
+  {
+    _writer.String(_value);
+  }
+  else if constexpr (std::is_arithmetic_v<T>)
+  {
+    _writer.Raw(_value);
+  }
+  else if constexpr (std::is_same_v<T, sdf::Time>)
+  {
+    _writer.Raw(_value.sec);
+    _writer.Raw(_value.nsec);
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Angle>)
+  {
+    _writer.Raw(_value.Radian());
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Color>)
+  {
+    _writer.Raw(_value.R());
+    _writer.Raw(_value.G());
+    _writer.Raw(_value.B());
+    _writer.Raw(_value.A());
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Vector2i> ||
+                     std::is_same_v<T, ignition::math::Vector2d>)
+  {
+    _writer.Raw(_value.X());
+    _writer.Raw(_value.Y());
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Vector3d>)
+  {
+    _writer.Raw(_value.X());
+    _writer.Raw(_value.Y());
+    _writer.Raw(_value.Z());
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Quaterniond>)
+  {
+    _writer.Raw(_value.W());
+    _writer.Raw(_value.X());
+    _writer.Raw(_value.Y());
+    _writer.Raw(_value.Z());
+  }
+  else
+  {
+    static_assert(std::is_same_v<T, ignition::math::Pose3d>,
+                  "Param type not handled by the binary cache");
+    writeValue(_writer, _value.Pos());
+    writeValue(_writer, _value.Rot());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a param value with the index of its type.
+/// \param[in,out] _writer Writer of the element tree.
+/// \param[in] _value The value.
+static void writeVariant(BinaryCacheWriter &_writer,
+    const ParamPrivate::ParamVariant &_value)
+{
+  _writer.Raw(static_cast<uint8_t>(_value.index()));
+  std::visit([&_writer](const auto &_val)
+    {
+      writeValue(_writer, _val);
+    }, _value);
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a param value written by writeValue.
+/// \param[in,out] _reader Reader of the element tree.
+/// \param[out] _value The value.
+template<typename T>
+static void readValue(BinaryCacheReader &_reader, T &_value)
+{
+  if constexpr (std::is_same_v<T, std::string>)
+  {
+    _value = _reader.String();
+  }
+  else if constexpr (std::is_same_v<T, bool>)
+  {
+    _value = _reader.Raw<uint8_t>() != 0;
+  }
+  else if constexpr (std::is_arithmetic_v<T>)
+  {
+    _value = _reader.Raw<T>();
+  }
+  else if constexpr (std::is_same_v<T, sdf::Time>)
+  {
+    _value.sec = _reader.Raw<int32_t>();
+    _value.nsec = _reader.Raw<int32_t>();
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Angle>)
+  {
+    _value.Radian(_reader.Raw<double>());
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Color>)
+  {
+    const float r = _reader.Raw<float>();
+    const float g = _reader.Raw<float>();
+    const float b = _reader.Raw<float>();
+    const float a = _reader.Raw<float>();
+    _value.Set(r, g, b, a);
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Vector2i>)
+  {
+    const int x = _reader.Raw<int>();
+    const int y = _reader.Raw<int>();
+    _value.Set(x, y);
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Vector2d>)
+  {
+    const double x = _reader.Raw<double>();
+    const double y = _reader.Raw<double>();
+    _value.Set(x, y);
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Vector3d>)
+  {
+    const double x = _reader.Raw<double>();
+    const double y = _reader.Raw<double>();
+    const double z = _reader.Raw<double>();
+    _value.Set(x, y, z);
+  }
+  else if constexpr (std::is_same_v<T, ignition::math::Quaterniond>)
+  {
+    const double w = _reader.Raw<double>();
+    const double x = _reader.Raw<double>();
+    const double y = _reader.Raw<double>();
+    const double z = _reader.Raw<double>();
+    _value.Set(w, x, y, z);
+  }
+  else
+  {
+    static_assert(std::is_same_v<T, ignition::math::Pose3d>,
+                  "Param type not handled by the binary cache");
+    readValue(_reader, _value.Pos());
+    readValue(_reader, _value.Rot());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a param value written by writeVariant.
+/// \param[in,out] _reader Reader of the element tree.
+/// \param[in] _index Index of the type of the value in the variant.
+/// \param[out] _value The value.
+template<size_t I = 0>
+static void readVariant(BinaryCacheReader &_reader, const size_t _index,
+    ParamPrivate::ParamVariant &_value)
+{
+  if constexpr (I < std::variant_size_v<ParamPrivate::ParamVariant>)
+  {
+    if (_index == I)
+      readValue(_reader, _value.emplace<I>());
+    else
+      readVariant<I + 1>(_reader, _index, _value);
+  }
+  else
+  {
+    _reader.ok = false;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a param value written by writeVariant.
+/// \param[in,out] _reader Reader of the element tree.
+/// \param[out] _value The value.
+static void readVariant(BinaryCacheReader &_reader,
+    ParamPrivate::ParamVariant &_value)
+{
+  readVariant(_reader, _reader.Raw<uint8_t>(), _value);
+}
+
+//////////////////////////////////////////////////
+std::string BinaryCache::Filename(const std::string &_source,
+    const std::string &_directory)
+{
+  if (_directory.empty())
+    return _source + ".sdfcache";
+
+  const char *digits = "0123456789abcdef";
+  uint64_t hash = hashData(_source.data(), _source.size());
+  std::string hex(2 * sizeof(hash), '0');
+  for (auto iter = hex.rbegin(); iter != hex.rend(); ++iter, hash >>= 4)
+    *iter = digits[hash & 0xF];
+
+  return filesystem::append(_directory,
+      filesystem::basename(_source) + "." + hex + ".sdfcache");
+}
+
+//////////////////////////////////////////////////
+bool BinaryCache::Write(const std::string &_filename, const SDF &_sdf,
+    const std::string &_source)
+{
+  BinaryCacheWriter body;
+  if (!_sdf.Root() || !WriteElement(_sdf.Root(), nullptr, body))
+  {
+    sdfdbg << "Unable to write the binary cache of [" << _source << "].\n";
+    return false;
+  }
+
+  // The files the document was read from are known once its elements are
+  // written, so the header is written last.
+  std::vector<std::string> sources = {_source};
+  for (const std::string &path : body.paths)
+  {
+    if (path != _source && filesystem::exists(path))
+      sources.push_back(path);
+  }
+  for (size_t i = 0, count = sources.size(); i < count; ++i)
+  {
+    const std::string config = modelConfigPath(sources[i]);
+    if (!config.empty() && filesystem::exists(config) &&
+        std::find(sources.begin(), sources.end(), config) == sources.end())
+    {
+      sources.push_back(config);
+    }
+  }
+
+  BinaryCacheWriter header;
+  header.data.append(kMagic, sizeof(kMagic));
+  header.Raw(kFormatVersion);
+  header.Raw(kByteOrderMark);
+  header.RawString(SDF::Version());
+
+  header.Varint(sources.size());
+  for (const std::string &source : sources)
+  {
+    MappedFile file(source);
+    header.RawString(source);
+    header.Raw(static_cast<int64_t>(file.Valid() ? file.Size() : -1));
+    header.Raw(file.Valid() ? hashData(file.Data(), file.Size()) : 0);
+  }
+
+  header.RawString(_sdf.FilePath());
+  header.RawString(_sdf.OriginalVersion());
+
+  header.Varint(body.strings.size());
+  for (const std::string *str : body.strings)
+    header.RawString(*str);
+
+  // Write to a temporary file and rename it, so a partly written cache
+  // file is never read.
+  const std::string tmpFilename =
+    _filename + ".tmp" + std::to_string(std::random_device()());
+  {
+    std::ofstream file(tmpFilename, std::ios::out | std::ios::binary);
+    file.write(header.data.data(), header.data.size());
+    file.write(body.data.data(), body.data.size());
+    if (!file)
+    {
+      file.close();
+      std::remove(tmpFilename.c_str());
+      sdfdbg << "Unable to write binary cache file [" << _filename << "].\n";
+      return false;
+    }
+  }
+
+#ifdef _WIN32
+  std::remove(_filename.c_str());
+#endif
+  if (std::rename(tmpFilename.c_str(), _filename.c_str()) != 0)
+  {
+    std::remove(tmpFilename.c_str());
+    sdfdbg << "Unable to write binary cache file [" << _filename << "].\n";
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BinaryCache::WriteElement(const ElementPtr &_elem,
+    const ElementPtr &_parent, BinaryCacheWriter &_writer)
+{
+  const ElementPrivate &data = *_elem->dataPtr;
+
+  // The element descriptions are shared with the spec, so only where they
+  // came from is written. The element is not cached if its descriptions
+  // would be different when it is read.
+  uint8_t descriptions = kParentDescriptions;
+  if (_parent)
+  {
+    const ElementPtr desc = _parent->GetElementDescription(*data.name);
+    ElementPtr reference;
+    if (desc && !desc->ReferenceSDF().empty())
+    {
+      reference = referencedSpec(_writer.references, desc->ReferenceSDF());
+    }
+
+    if (desc &&
+        desc->dataPtr->elementDescriptions == data.elementDescriptions)
+    {
+      descriptions = kParentDescriptions;
+    }
+    else if (reference &&
+        reference->dataPtr->elementDescriptions == data.elementDescriptions)
+    {
+      descriptions = kReferenceDescriptions;
+    }
+    else if (data.elementDescriptions.empty())
+    {
+      descriptions = kNoDescriptions;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  _writer.String(data.name);
+  _writer.Raw(descriptions);
+  _writer.String(data.required);
+  _writer.String(data.description);
+  _writer.String(data.referenceSDF);
+  _writer.String(data.path);
+  _writer.String(data.includeFilename);
+  _writer.String(data.originalVersion);
+  _writer.Raw(static_cast<uint8_t>((data.copyChildren ? kCopyChildren : 0) |
+                                   (data.value ? kHasValue : 0)));
+  _writer.paths.insert(data.path);
+
+  _writer.Varint(data.attributes.size());
+  for (const ParamPtr &attribute : data.attributes)
+    WriteParam(*attribute, _writer);
+
+  if (data.value)
+    WriteParam(*data.value, _writer);
+
+  _writer.Varint(data.elements.size());
+  for (const ElementPtr &child : data.elements)
+  {
+    if (!WriteElement(child, _elem, _writer))
+      return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BinaryCache::WriteParam(const Param &_param, BinaryCacheWriter &_writer)
+{
+  const ParamPrivate &data = *_param.dataPtr;
+
+  _writer.String(data.key);
+  _writer.String(data.typeName);
+  _writer.String(data.description);
+
+  const size_t flagsIndex = _writer.data.size();
+  uint8_t flags = (data.required ? kRequired : 0) | (data.set ? kSet : 0);
+  _writer.Raw(flags);
+
+  // Most params hold their default value, so the default is only written
+  // when its bytes differ from those of the value.
+  const size_t valueIndex = _writer.data.size();
+  writeVariant(_writer, data.value);
+  const size_t defaultIndex = _writer.data.size();
+  writeVariant(_writer, data.defaultValue);
+  if (_writer.data.compare(defaultIndex, std::string::npos, _writer.data,
+                           valueIndex, defaultIndex - valueIndex) == 0)
+  {
+    _writer.data.resize(defaultIndex);
+    _writer.data[flagsIndex] = static_cast<char>(flags | kDefaultIsValue);
+  }
+}
+
+//////////////////////////////////////////////////
+bool BinaryCache::Read(const std::string &_filename, SDFPtr _sdf)
+{
+  if (!_sdf || !_sdf->Root() || _sdf->Root()->GetFirstElement())
+    return false;
+
+  MappedFile file(_filename);
+  if (!file.Valid())
+    return false;
+
+  BinaryCacheReader reader(file.Data(), file.Size());
+  char magic[sizeof(kMagic)] = {};
+  for (char &c : magic)
+    c = reader.Raw<char>();
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Raw<uint32_t>() != kFormatVersion ||
+      reader.Raw<uint32_t>() != kByteOrderMark ||
+      reader.RawString() != SDF::Version() || !reader.ok)
+  {
+    sdfdbg << "Binary cache file [" << _filename << "] is not valid.\n";
+    return false;
+  }
+
+  for (size_t i = 0, count = reader.Count(); i < count && reader.ok; ++i)
+  {
+    const std::string source = reader.RawString();
+    const int64_t size = reader.Raw<int64_t>();
+    const uint64_t hash = reader.Raw<uint64_t>();
+
+    MappedFile sourceFile(source);
+    if (size != (sourceFile.Valid() ? static_cast<int64_t>(sourceFile.Size())
+                                    : -1) ||
+        hash != (sourceFile.Valid() ?
+                 hashData(sourceFile.Data(), sourceFile.Size()) : 0))
+    {
+      sdfdbg << "Binary cache file [" << _filename << "] is out of date, ["
+             << source << "] changed.\n";
+      return false;
+    }
+  }
+
+  const std::string filePath = reader.RawString();
+  const std::string originalVersion = reader.RawString();
+
+  const size_t stringCount = reader.Count();
+  reader.strings.reserve(stringCount);
+  for (size_t i = 0; i < stringCount && reader.ok; ++i)
+    reader.strings.push_back(reader.RawString());
+  reader.interned.resize(reader.strings.size(), nullptr);
+  reader.shared.resize(reader.strings.size(), nullptr);
+  reader.owned.resize(reader.strings.size());
+
+  reader.root = _sdf->Root();
+  ElementPtr root = ReadElement(reader, nullptr);
+  if (!root || !reader.ok || reader.data != reader.end)
+  {
+    sdfdbg << "Binary cache file [" << _filename << "] is not valid.\n";
+    return false;
+  }
+
+  if (!filePath.empty())
+  {
+    _sdf->SetFilePath(filePath);
+  }
+
+  if (_sdf->OriginalVersion().empty())
+  {
+    _sdf->SetOriginalVersion(originalVersion);
+  }
+
+  _sdf->Root(root);
+  return true;
+}
+
+//////////////////////////////////////////////////
+ElementPtr BinaryCache::ReadElement(BinaryCacheReader &_reader,
+    const ElementPtr &_parent)
+{
+  ElementPtr elem(new Element);
+  ElementPrivate &data = *elem->dataPtr;
+
+  data.name = _reader.SharedString(data.ownedName);
+  const uint8_t descriptions = _reader.Raw<uint8_t>();
+  data.required = _reader.InternedString();
+  data.description = _reader.String();
+  data.referenceSDF = _reader.InternedString();
+  data.path = _reader.String();
+  data.includeFilename = _reader.String();
+  data.originalVersion = _reader.String();
+  const uint8_t flags = _reader.Raw<uint8_t>();
+  data.copyChildren = (flags & kCopyChildren) != 0;
+  data.parent = _parent;
+  if (!_reader.ok)
+    return nullptr;
+
+  // Get the element descriptions from the same place as they came from
+  // when the element was written.
+  ElementPtr desc;
+  if (!_parent)
+  {
+    desc = _reader.root;
+    if (desc->GetName() != *data.name)
+      return nullptr;
+  }
+  else if (descriptions != kNoDescriptions)
+  {
+    desc = _parent->GetElementDescription(*data.name);
+    if (desc && descriptions == kReferenceDescriptions)
+    {
+      desc = desc->ReferenceSDF().empty() ? nullptr :
+        referencedSpec(_reader.references, desc->ReferenceSDF());
+    }
+    if (!desc)
+      return nullptr;
+  }
+
+  if (desc)
+  {
+    data.elementDescriptions = desc->dataPtr->elementDescriptions;
+    data.elementDescriptionIndex = desc->dataPtr->elementDescriptionIndex;
+  }
+
+  for (size_t i = 0, count = _reader.Count(); i < count && _reader.ok; ++i)
+    elem->AppendAttribute(ReadParam(_reader));
+
+  if (flags & kHasValue)
+    data.value = ReadParam(_reader);
+
+  for (size_t i = 0, count = _reader.Count(); i < count && _reader.ok; ++i)
+  {
+    ElementPtr child = ReadElement(_reader, elem);
+    if (!child)
+      return nullptr;
+    elem->InsertElement(child);
+  }
+
+  return _reader.ok ? elem : nullptr;
+}
+
+//////////////////////////////////////////////////
+ParamPtr BinaryCache::ReadParam(BinaryCacheReader &_reader)
+{
+  ParamPtr param(new Param());
+  ParamPrivate &data = *param->dataPtr;
+
+  data.key = _reader.SharedString(data.ownedKey);
+  data.typeName = _reader.InternedString();
+  data.description = _reader.String();
+
+  const uint8_t flags = _reader.Raw<uint8_t>();
+  data.required = (flags & kRequired) != 0;
+  data.set = (flags & kSet) != 0;
+
+  readVariant(_reader, data.value);
+  if (flags & kDefaultIsValue)
+    data.defaultValue = data.value;
+  else
+    readVariant(_reader, data.defaultValue);
+
+  return param;
+}
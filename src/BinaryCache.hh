@@ -0,0 +1,108 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_BINARYCACHE_HH
+#define SDFORMAT_BINARYCACHE_HH
+
+#include <string>
+
+#include "sdf/Element.hh"
+#include "sdf/Param.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \internal
+  class BinaryCacheReader;
+
+  /// \internal
+  class BinaryCacheWriter;
+
+  /// \brief Reads and writes parsed SDF documents in a compact binary
+  /// format, so a document can be loaded again without parsing its XML.
+  ///
+  /// A cache file starts with a header that holds the spec version and the
+  /// size and hash of each file the document was read from. It is followed
+  /// by a table of the strings of the document, each stored once, and by
+  /// the element tree. Param values are stored in their native type. The
+  /// element descriptions are not stored: each element gets them from the
+  /// description of its parent, as it does when the XML is read.
+  class BinaryCache
+  {
+    /// \brief Write a document to a cache file. The file is replaced
+    /// atomically, so a cache file is never read while it is written.
+    /// \param[in] _filename Path of the cache file.
+    /// \param[in] _sdf The document.
+    /// \param[in] _source Path of the file the document was read from. The
+    /// files that elements were included from are recorded too.
+    /// \return False if the document or the file could not be written.
+    public: static bool Write(const std::string &_filename, const SDF &_sdf,
+                              const std::string &_source);
+
+    /// \brief Read a document from a cache file.
+    /// \param[in] _filename Path of the cache file.
+    /// \param[in,out] _sdf An SDF object initialized with sdf::init, and with
+    /// no elements read yet. It is left unchanged if the file is not read.
+    /// \return False if the file does not exist, is not a valid cache file
+    /// for the current spec version, or one of its source files changed.
+    public: static bool Read(const std::string &_filename, SDFPtr _sdf);
+
+    /// \brief Get the path of the cache file of an SDF file.
+    /// \param[in] _source Path of the SDF file.
+    /// \param[in] _directory Directory of the cache file, or an empty string
+    /// to put the cache file next to the SDF file.
+    /// \return Path of the cache file. In _directory, it is named after the
+    /// SDF file and a hash of its path, so SDF files with the same name in
+    /// different directories get different cache files.
+    public: static std::string Filename(const std::string &_source,
+                                        const std::string &_directory);
+
+    /// \brief Write an element and its children.
+    /// \param[in] _elem The element.
+    /// \param[in] _parent Parent of the element, or nullptr for the root.
+    /// \param[in,out] _writer Writer of the element tree.
+    /// \return False if the element descriptions of the element can't be
+    /// found again from its parent when it is read.
+    private: static bool WriteElement(const ElementPtr &_elem,
+                                      const ElementPtr &_parent,
+                                      BinaryCacheWriter &_writer);
+
+    /// \brief Write a param.
+    /// \param[in] _param The param.
+    /// \param[in,out] _writer Writer of the element tree.
+    private: static void WriteParam(const Param &_param,
+                                    BinaryCacheWriter &_writer);
+
+    /// \brief Read an element and its children.
+    /// \param[in,out] _reader Reader of the element tree.
+    /// \param[in] _parent Parent of the element, or nullptr for the root.
+    /// \return The element, or nullptr if the data is not valid.
+    private: static ElementPtr ReadElement(BinaryCacheReader &_reader,
+                                           const ElementPtr &_parent);
+
+    /// \brief Read a param.
+    /// \param[in,out] _reader Reader of the element tree.
+    /// \return The param. Its contents are not valid if the reader failed.
+    private: static ParamPtr ReadParam(BinaryCacheReader &_reader);
+  };
+  }
+}
+#endif
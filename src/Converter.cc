@@ -17,9 +17,11 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,6 +36,194 @@
 
 using namespace sdf;
 
+/// \brief The rules of a <convert> element, compiled from the convert xml
+/// so that they can be applied to many documents without looking them up
+/// again.
+class sdf::ConvertRules
+{
+  /// \brief Operations that can be applied to an element.
+  public: enum class Operation
+  {
+    RENAME,
+    COPY,
+    MAP,
+    MOVE,
+    ADD,
+    REMOVE
+  };
+
+  /// \brief A step of the conversion. Steps are applied in the order of
+  /// the <convert> elements they are compiled from.
+  public: struct Step
+  {
+    /// \brief Rules of consecutive <convert name="..."> elements, indexed
+    /// by name. They are merged into one step and applied in a single pass
+    /// over the children, since each rule only changes the subtree of the
+    /// child it applies to.
+    std::unordered_map<std::string,
+      std::vector<const ConvertRules *>> children;
+
+    /// \brief Name of the descendants converted by a
+    /// <convert descendant_name="..."> element.
+    std::string descendantName;
+
+    /// \brief Rules of a <convert descendant_name="..."> element, or
+    /// nullptr if this step converts children.
+    const ConvertRules *descendantRules = nullptr;
+  };
+
+  /// \brief Paths of the deprecated elements, split on '/'.
+  public: std::vector<std::vector<std::string>> deprecated;
+
+  /// \brief Rules of the nested <convert> elements.
+  public: std::vector<Step> steps;
+
+  /// \brief Operations to apply to the element, in order, with the convert
+  /// xml element that describes each of them.
+  public: std::vector<std::pair<Operation, TiXmlElement *>> operations;
+
+  /// \brief Storage of the rules referenced by steps.
+  public: std::vector<std::unique_ptr<ConvertRules>> nested;
+
+  /// \brief True if the rules only convert children of the element, with
+  /// no operations, deprecations or descendant rules of their own. The
+  /// children of an element can then be converted by these rules and the
+  /// following ones in a single pass.
+  public: bool childrenOnly = false;
+};
+
+/////////////////////////////////////////////////
+/// \brief Compile the rules of a convert xml element.
+/// \param[in] _convert The convert xml element. The rules refer to its
+/// elements, so it must outlive them.
+/// \return The compiled rules.
+static std::unique_ptr<ConvertRules> compileRules(TiXmlElement *_convert)
+{
+  SDF_ASSERT(_convert != nullptr, "Convert element is NULL");
+
+  static const std::unordered_map<std::string, ConvertRules::Operation>
+    operations = {
+      {"rename", ConvertRules::Operation::RENAME},
+      {"copy", ConvertRules::Operation::COPY},
+      {"map", ConvertRules::Operation::MAP},
+      {"move", ConvertRules::Operation::MOVE},
+      {"add", ConvertRules::Operation::ADD},
+      {"remove", ConvertRules::Operation::REMOVE}};
+
+  auto rules = std::make_unique<ConvertRules>();
+
+  for (TiXmlElement *deprecatedElem =
+         _convert->FirstChildElement("deprecated");
+       deprecatedElem;
+       deprecatedElem = deprecatedElem->NextSiblingElement("deprecated"))
+  {
+    if (deprecatedElem->GetText())
+      rules->deprecated.push_back(split(deprecatedElem->GetText(), "/"));
+  }
+
+  for (TiXmlElement *convertElem = _convert->FirstChildElement("convert");
+       convertElem; convertElem = convertElem->NextSiblingElement("convert"))
+  {
+    const char *name = convertElem->Attribute("name");
+    const char *descendantName = convertElem->Attribute("descendant_name");
+    if (!name && !descendantName)
+      continue;
+
+    rules->nested.push_back(compileRules(convertElem));
+    const ConvertRules *nested = rules->nested.back().get();
+
+    if (name)
+    {
+      if (rules->steps.empty() || rules->steps.back().descendantRules)
+        rules->steps.emplace_back();
+      rules->steps.back().children[name].push_back(nested);
+    }
+    if (descendantName)
+    {
+      ConvertRules::Step step;
+      step.descendantName = descendantName;
+      step.descendantRules = nested;
+      rules->steps.push_back(std::move(step));
+    }
+  }
+
+  for (TiXmlElement *childElem = _convert->FirstChildElement();
+       childElem; childElem = childElem->NextSiblingElement())
+  {
+    auto iter = operations.find(childElem->ValueStr());
+    if (iter != operations.end())
+    {
+      rules->operations.emplace_back(iter->second, childElem);
+    }
+    else if (childElem->ValueStr() != "convert")
+    {
+      sdferr << "Unknown convert element[" << childElem->ValueStr() << "]\n";
+    }
+  }
+
+  rules->childrenOnly = rules->deprecated.empty() &&
+    rules->operations.empty() &&
+    std::none_of(rules->steps.begin(), rules->steps.end(),
+        [](const ConvertRules::Step &_step)
+        {
+          return _step.descendantRules != nullptr;
+        });
+
+  return rules;
+}
+
+/// \brief A conversion of the embedded conversionMap, compiled once.
+struct CompiledConversion
+{
+  /// \brief Version that the conversion converts to.
+  std::string toVersion;
+
+  /// \brief The parsed convert xml, referred to by rules.
+  std::unique_ptr<TiXmlDocument> doc;
+
+  /// \brief The compiled rules, or nullptr if the xml has errors.
+  std::unique_ptr<ConvertRules> rules;
+
+  /// \brief Description of the error when parsing the xml, if any.
+  std::string error;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the conversions of the embedded conversionMap, keyed by the
+/// version they convert from. They are parsed and compiled on first use,
+/// and then shared by all threads, which only read them.
+/// \return The compiled conversions.
+static const std::map<std::string, CompiledConversion> &compiledConversions()
+{
+  static const std::map<std::string, CompiledConversion> conversions = []()
+  {
+    // The conversionMap in EmbeddedSdf.hh has keys that represent a version
+    // of SDF to convert from. The values in conversionmap are pairs, where
+    // the first element is the SDF version that the second element will
+    // convert to. For example, the following will convert from 1.4 to 1.5
+    // according to "conversion_xml":
+    //
+    // {"1.4", {"1.5", "conversion_xml"}}
+    std::map<std::string, CompiledConversion> result;
+    for (const auto &entry : conversionMap)
+    {
+      CompiledConversion &conversion = result[entry.first];
+      conversion.toVersion = entry.second.first;
+      conversion.doc = std::make_unique<TiXmlDocument>();
+      conversion.doc->Parse(entry.second.second.c_str());
+      TiXmlElement *convertElem = conversion.doc->FirstChildElement("convert");
+      if (conversion.doc->Error())
+        conversion.error = conversion.doc->ErrorDesc();
+      else if (!convertElem)
+        conversion.error = "missing <convert> element";
+      else
+        conversion.rules = compileRules(convertElem);
+    }
+    return result;
+  }();
+  return conversions;
+}
+
 /////////////////////////////////////////////////
 bool Converter::Convert(TiXmlDocument *_doc, const std::string &_toVersion,
                         bool _quiet)
@@ -72,40 +262,35 @@ bool Converter::Convert(TiXmlDocument *_doc, const std::string &_toVersion,
 
   elem->SetAttribute("version", _toVersion);
 
-  // The conversionMap in EmbeddedSdf.hh has keys that represent a version
-  // of SDF to convert from. The values in conversionmap are pairs, where
-  // the first element is the SDF version that the second element will
-  // convert to. For example, the following will convert from 1.4 to 1.5
-  // according to "conversion_xml":
-  //
-  // {"1.4", {"1.5", "conversion_xml"}}
-  std::map<std::string, std::pair<std::string, std::string> >::const_iterator
-    fromIter = conversionMap.find(origVersion);
+  const std::map<std::string, CompiledConversion> &conversions =
+    compiledConversions();
+  auto fromIter = conversions.find(origVersion);
 
   std::string toVer = "";
 
-  // Starting with the original SDF version, perform all the conversions
+  // Starting with the original SDF version, collect all the conversions
   // necessary in order to reach the _toVersion.
-  while (fromIter != conversionMap.end() && fromIter->first != _toVersion)
+  std::vector<const ConvertRules *> chain;
+  while (fromIter != conversions.end() && fromIter->first != _toVersion)
   {
     // Get the SDF to version.
-    toVer = fromIter->second.first;
+    toVer = fromIter->second.toVersion;
 
-    // Parse and apply the conversion XML.
-    TiXmlDocument xmlDoc;
-    xmlDoc.Parse(fromIter->second.second.c_str());
-    if (xmlDoc.Error())
+    if (!fromIter->second.rules)
     {
       sdferr << "Error parsing XML from string: "
-             << xmlDoc.ErrorDesc() << '\n';
+             << fromIter->second.error << '\n';
       return false;
     }
-    ConvertImpl(elem, xmlDoc.FirstChildElement("convert"));
+    chain.push_back(fromIter->second.rules.get());
 
-    // Get the next conversion XML map element.
-    fromIter = conversionMap.find(toVer);
+    // Get the next conversion.
+    fromIter = conversions.find(toVer);
   }
 
+  // Apply the conversions in a single walk where possible.
+  ConvertChain(elem, chain);
+
   // Check that we actually converted to the desired final version.
   if (toVer != _toVersion)
   {
@@ -123,17 +308,15 @@ void Converter::Convert(TiXmlDocument *_doc, TiXmlDocument *_convertDoc)
   SDF_ASSERT(_doc != NULL, "SDF XML doc is NULL");
   SDF_ASSERT(_convertDoc != NULL, "Convert XML doc is NULL");
 
-  ConvertImpl(_doc->FirstChildElement(), _convertDoc->FirstChildElement());
+  ConvertImpl(_doc->FirstChildElement(),
+              *compileRules(_convertDoc->FirstChildElement()));
 }
 
 /////////////////////////////////////////////////
-void Converter::ConvertDescendantsImpl(TiXmlElement *_e, TiXmlElement *_c)
+void Converter::ConvertDescendantsImpl(TiXmlElement *_e,
+                                       const std::string &_name,
+                                       const ConvertRules &_rules)
 {
-  if (!_c->Attribute("descendant_name"))
-  {
-    return;
-  }
-
   if (_e->ValueStr() == "plugin")
   {
     return;
@@ -144,77 +327,113 @@ void Converter::ConvertDescendantsImpl(TiXmlElement *_e, TiXmlElement *_c)
     return;
   }
 
-  std::string name = _c->Attribute("descendant_name");
   TiXmlElement *e = _e->FirstChildElement();
   while (e)
   {
-    if (name == e->ValueStr())
+    if (_name == e->ValueStr())
     {
-      ConvertImpl(e, _c);
+      ConvertImpl(e, _rules);
     }
-    ConvertDescendantsImpl(e, _c);
+    ConvertDescendantsImpl(e, _name, _rules);
     e = e->NextSiblingElement();
   }
 }
 
 /////////////////////////////////////////////////
-void Converter::ConvertImpl(TiXmlElement *_elem, TiXmlElement *_convert)
+void Converter::ConvertImpl(TiXmlElement *_elem, const ConvertRules &_rules)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_convert != NULL, "Convert element is NULL");
 
-  CheckDeprecation(_elem, _convert);
+  CheckDeprecation(_elem, _rules);
 
-  for (TiXmlElement *convertElem = _convert->FirstChildElement("convert");
-       convertElem; convertElem = convertElem->NextSiblingElement("convert"))
+  for (const ConvertRules::Step &step : _rules.steps)
   {
-    if (convertElem->Attribute("name"))
+    if (step.descendantRules)
     {
-      TiXmlElement *elem = _elem->FirstChildElement(
-          convertElem->Attribute("name"));
-      while (elem)
-      {
-        ConvertImpl(elem, convertElem);
-        elem = elem->NextSiblingElement(convertElem->Attribute("name"));
-      }
+      ConvertDescendantsImpl(_elem, step.descendantName,
+                             *step.descendantRules);
+      continue;
     }
-    if (convertElem->Attribute("descendant_name"))
+
+    for (TiXmlElement *elem = _elem->FirstChildElement(); elem;
+         elem = elem->NextSiblingElement())
     {
-      ConvertDescendantsImpl(_elem, convertElem);
+      auto iter = step.children.find(elem->ValueStr());
+      if (iter != step.children.end())
+        ConvertChain(elem, iter->second);
     }
   }
 
-  for (TiXmlElement *childElem = _convert->FirstChildElement();
-       childElem; childElem = childElem->NextSiblingElement())
+  for (const auto &operation : _rules.operations)
   {
-    if (childElem->ValueStr() == "rename")
-    {
-      Rename(_elem, childElem);
-    }
-    else if (childElem->ValueStr() == "copy")
-    {
-      Move(_elem, childElem, true);
-    }
-    else if (childElem->ValueStr() == "map")
-    {
-      Map(_elem, childElem);
-    }
-    else if (childElem->ValueStr() == "move")
-    {
-      Move(_elem, childElem, false);
-    }
-    else if (childElem->ValueStr() == "add")
+    switch (operation.first)
     {
-      Add(_elem, childElem);
+      case ConvertRules::Operation::RENAME:
+        Rename(_elem, operation.second);
+        break;
+      case ConvertRules::Operation::COPY:
+        Move(_elem, operation.second, true);
+        break;
+      case ConvertRules::Operation::MAP:
+        Map(_elem, operation.second);
+        break;
+      case ConvertRules::Operation::MOVE:
+        Move(_elem, operation.second, false);
+        break;
+      case ConvertRules::Operation::ADD:
+        Add(_elem, operation.second);
+        break;
+      case ConvertRules::Operation::REMOVE:
+        Remove(_elem, operation.second);
+        break;
     }
-    else if (childElem->ValueStr() == "remove")
+  }
+}
+
+/////////////////////////////////////////////////
+void Converter::ConvertChain(TiXmlElement *_elem,
+                             const std::vector<const ConvertRules *> &_chain)
+{
+  size_t i = 0;
+  while (i < _chain.size())
+  {
+    if (!_chain[i]->childrenOnly)
     {
-      Remove(_elem, childElem);
+      ConvertImpl(_elem, *_chain[i]);
+      ++i;
+      continue;
     }
-    else if (childElem->ValueStr() != "convert")
+
+    // Rules that only convert children leave the children of _elem, and
+    // their names, unchanged. Applying each rule to all the children in
+    // turn therefore gives the same result as applying all the rules to
+    // each child in turn, which needs a single pass.
+    size_t end = i;
+    while (end < _chain.size() && _chain[end]->childrenOnly)
+      ++end;
+
+    std::vector<const ConvertRules *> childChain;
+    for (TiXmlElement *elem = _elem->FirstChildElement(); elem;
+         elem = elem->NextSiblingElement())
     {
-      sdferr << "Unknown convert element[" << childElem->ValueStr() << "]\n";
+      childChain.clear();
+      for (size_t k = i; k < end; ++k)
+      {
+        for (const ConvertRules::Step &step : _chain[k]->steps)
+        {
+          auto iter = step.children.find(elem->ValueStr());
+          if (iter != step.children.end())
+          {
+            childChain.insert(childChain.end(), iter->second.begin(),
+                              iter->second.end());
+          }
+        }
+      }
+
+      if (!childChain.empty())
+        ConvertChain(elem, childChain);
     }
+    i = end;
   }
 }
 
@@ -721,16 +940,12 @@ const char *Converter::GetValue(const char *_valueElem, const char *_valueAttr,
 }
 
 /////////////////////////////////////////////////
-void Converter::CheckDeprecation(TiXmlElement *_elem, TiXmlElement *_convert)
+void Converter::CheckDeprecation(TiXmlElement *_elem,
+                                 const ConvertRules &_rules)
 {
   // Process deprecated elements
-  for (TiXmlElement *deprecatedElem = _convert->FirstChildElement("deprecated");
-       deprecatedElem;
-       deprecatedElem = deprecatedElem->NextSiblingElement("deprecated"))
+  for (const std::vector<std::string> &valueSplit : _rules.deprecated)
   {
-    std::string value = deprecatedElem->GetText();
-    std::vector<std::string> valueSplit = split(value, "/");
-
     bool found = false;
     TiXmlElement *e = _elem;
     std::ostringstream stream;
@@ -1881,6 +1881,89 @@ TEST(Converter, MuchNewerVersion)
   ASSERT_TRUE(sdf::Converter::Convert(&xmlDoc, "1.6"));
 }
 
+////////////////////////////////////////////////////
+/// Rules for the same element in separate <convert> elements are applied
+/// in order, to each matching element.
+TEST(Converter, RepeatedConvertNames)
+{
+  std::string xmlString = getRepeatedXmlString();
+  TiXmlDocument xmlDoc;
+  xmlDoc.Parse(xmlString.c_str());
+
+  std::stringstream convertStream;
+  convertStream << "<convert name='elemA'>"
+                << "  <convert name='elemB'>"
+                << "    <convert name='elemC'>"
+                << "      <convert name='elemD'>"
+                << "        <add attribute='attrD' value='D'/>"
+                << "      </convert>"
+                << "    </convert>"
+                << "  </convert>"
+                << "  <convert name='elemB'>"
+                << "    <convert name='elemC'>"
+                << "      <convert name='elemD'>"
+                << "        <move>"
+                << "          <from attribute='attrD'/>"
+                << "          <to attribute='attrE'/>"
+                << "        </move>"
+                << "      </convert>"
+                << "    </convert>"
+                << "  </convert>"
+                << "</convert>";
+  TiXmlDocument convertXmlDoc;
+  convertXmlDoc.Parse(convertStream.str().c_str());
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  TiXmlElement *convertedElem = xmlDoc.FirstChildElement("elemA")
+    ->FirstChildElement("elemB")->FirstChildElement("elemC");
+  ASSERT_NE(nullptr, convertedElem);
+  int count = 0;
+  for (TiXmlElement *elemD = convertedElem->FirstChildElement("elemD");
+       elemD; elemD = elemD->NextSiblingElement("elemD"))
+  {
+    EXPECT_EQ(nullptr, elemD->Attribute("attrD"));
+    ASSERT_NE(nullptr, elemD->Attribute("attrE"));
+    EXPECT_STREQ("D", elemD->Attribute("attrE"));
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+}
+
+////////////////////////////////////////////////////
+/// The embedded conversions give the same result each time they are used.
+TEST(Converter, RepeatedVersionConversion)
+{
+  std::string xmlString(
+      "<sdf version='1.4'>"
+      "  <world name='default'>"
+      "    <physics type='ode'>"
+      "      <gravity>0 0 -9.8</gravity>"
+      "    </physics>"
+      "  </world>"
+      "</sdf>");
+
+  std::string firstResult;
+  for (int i = 0; i < 3; ++i)
+  {
+    TiXmlDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    ASSERT_TRUE(sdf::Converter::Convert(&xmlDoc, "1.6"));
+
+    TiXmlElement *worldElem =
+      xmlDoc.FirstChildElement("sdf")->FirstChildElement("world");
+    ASSERT_NE(nullptr, worldElem);
+    EXPECT_NE(nullptr, worldElem->FirstChildElement("gravity"));
+    EXPECT_EQ(nullptr,
+        worldElem->FirstChildElement("physics")->FirstChildElement("gravity"));
+
+    std::ostringstream result;
+    result << xmlDoc;
+    if (i == 0)
+      firstResult = result.str();
+    EXPECT_EQ(firstResult, result.str());
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
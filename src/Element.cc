@@ -16,21 +16,32 @@
  */
 
 #include <algorithm>
+#include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "sdf/Assert.hh"
 #include "sdf/Element.hh"
 #include "sdf/Filesystem.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
+/// \brief Number of child elements, attributes or element descriptions
+/// from which lookups by name use a hash index instead of a linear search.
+static const std::size_t nameIndexThreshold = 16;
+
 /////////////////////////////////////////////////
 Element::Element()
   : dataPtr(new ElementPrivate)
 {
+  static const std::string *emptyString = internString("");
+  this->dataPtr->name = emptyString;
+  this->dataPtr->required = emptyString;
   this->dataPtr->copyChildren = false;
-  this->dataPtr->referenceSDF = "";
+  this->dataPtr->referenceSDF = emptyString;
 }
 
 /////////////////////////////////////////////////
@@ -66,25 +77,32 @@ void Element::SetParent(const ElementPtr _parent)
 /////////////////////////////////////////////////
 void Element::SetName(const std::string &_name)
 {
-  this->dataPtr->name = _name;
+  this->dataPtr->name = shareString(_name, this->dataPtr->ownedName);
+
+  // Keep the parent's index of child elements by name up to date.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent && !parent->dataPtr->elementIndex.empty())
+  {
+    parent->RebuildElementIndex();
+  }
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::GetName() const
 {
-  return this->dataPtr->name;
+  return *this->dataPtr->name;
 }
 
 /////////////////////////////////////////////////
 void Element::SetRequired(const std::string &_req)
 {
-  this->dataPtr->required = _req;
+  this->dataPtr->required = internString(_req);
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::GetRequired() const
 {
-  return this->dataPtr->required;
+  return *this->dataPtr->required;
 }
 
 /////////////////////////////////////////////////
@@ -102,13 +120,13 @@ bool Element::GetCopyChildren() const
 /////////////////////////////////////////////////
 void Element::SetReferenceSDF(const std::string &_value)
 {
-  this->dataPtr->referenceSDF = _value;
+  this->dataPtr->referenceSDF = internString(_value);
 }
 
 /////////////////////////////////////////////////
 std::string Element::ReferenceSDF() const
 {
-  return this->dataPtr->referenceSDF;
+  return *this->dataPtr->referenceSDF;
 }
 
 /////////////////////////////////////////////////
@@ -117,7 +135,7 @@ void Element::AddValue(const std::string &_type,
                        bool _required,
                        const std::string &_description)
 {
-  this->dataPtr->value = this->CreateParam(this->dataPtr->name,
+  this->dataPtr->value = this->CreateParam(*this->dataPtr->name,
       _type, _defaultValue, _required, _description);
 }
 
@@ -139,16 +157,37 @@ void Element::AddAttribute(const std::string &_key,
                            bool _required,
                            const std::string &_description)
 {
-  this->dataPtr->attributes.push_back(
+  this->AppendAttribute(
       this->CreateParam(_key, _type, _defaultValue, _required, _description));
 }
 
+/////////////////////////////////////////////////
+void Element::AppendAttribute(ParamPtr _param)
+{
+  this->dataPtr->attributes.push_back(_param);
+
+  if (!this->dataPtr->attributeIndex.empty())
+  {
+    this->dataPtr->attributeIndex.emplace(
+        _param->GetKey(), this->dataPtr->attributes.size() - 1);
+  }
+  else if (this->dataPtr->attributes.size() >= nameIndexThreshold)
+  {
+    for (std::size_t i = 0; i < this->dataPtr->attributes.size(); ++i)
+    {
+      this->dataPtr->attributeIndex.emplace(
+          this->dataPtr->attributes[i]->GetKey(), i);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 ElementPtr Element::Clone() const
 {
   ElementPtr clone(new Element);
   clone->dataPtr->description = this->dataPtr->description;
   clone->dataPtr->name = this->dataPtr->name;
+  clone->dataPtr->ownedName = this->dataPtr->ownedName;
   clone->dataPtr->required = this->dataPtr->required;
   clone->dataPtr->copyChildren = this->dataPtr->copyChildren;
   clone->dataPtr->includeFilename = this->dataPtr->includeFilename;
@@ -160,21 +199,22 @@ ElementPtr Element::Clone() const
   for (aiter = this->dataPtr->attributes.begin();
        aiter != this->dataPtr->attributes.end(); ++aiter)
   {
-    clone->dataPtr->attributes.push_back((*aiter)->Clone());
+    clone->AppendAttribute((*aiter)->Clone());
   }
 
-  ElementPtr_V::const_iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
-  {
-    clone->dataPtr->elementDescriptions.push_back((*eiter)->Clone());
-  }
+  // Element descriptions are immutable once built, so they are shared
+  // with the clone instead of being copied.
+  clone->dataPtr->elementDescriptions = this->dataPtr->elementDescriptions;
+  clone->dataPtr->elementDescriptionIndex =
+    this->dataPtr->elementDescriptionIndex;
 
+  ElementPtr_V::const_iterator eiter;
   for (eiter = this->dataPtr->elements.begin();
        eiter != this->dataPtr->elements.end(); ++eiter)
   {
-    clone->dataPtr->elements.push_back((*eiter)->Clone());
-    clone->dataPtr->elements.back()->SetParent(clone);
+    ElementPtr elem = (*eiter)->Clone();
+    elem->SetParent(clone);
+    clone->InsertElement(elem);
   }
 
   if (this->dataPtr->value)
@@ -188,21 +228,24 @@ ElementPtr Element::Clone() const
 /////////////////////////////////////////////////
 void Element::Copy(const ElementPtr _elem)
 {
-  this->dataPtr->name = _elem->GetName();
-  this->dataPtr->description = _elem->GetDescription();
-  this->dataPtr->required = _elem->GetRequired();
+  if (this->dataPtr->name != _elem->dataPtr->name)
+  {
+    this->SetName(_elem->GetName());
+  }
+  this->dataPtr->description = _elem->dataPtr->description;
+  this->dataPtr->required = _elem->dataPtr->required;
   this->dataPtr->copyChildren = _elem->GetCopyChildren();
   this->dataPtr->includeFilename = _elem->dataPtr->includeFilename;
-  this->dataPtr->referenceSDF = _elem->ReferenceSDF();
+  this->dataPtr->referenceSDF = _elem->dataPtr->referenceSDF;
   this->dataPtr->originalVersion = _elem->OriginalVersion();
-  this->dataPtr->path = _elem->FilePath();
+  this->dataPtr->path = _elem->dataPtr->path;
 
   for (Param_V::iterator iter = _elem->dataPtr->attributes.begin();
        iter != _elem->dataPtr->attributes.end(); ++iter)
   {
     if (!this->HasAttribute((*iter)->GetKey()))
     {
-      this->dataPtr->attributes.push_back((*iter)->Clone());
+      this->AppendAttribute((*iter)->Clone());
     }
     ParamPtr param = this->GetAttribute((*iter)->GetKey());
     (*param) = (**iter);
@@ -220,30 +263,27 @@ void Element::Copy(const ElementPtr _elem)
     }
   }
 
-  this->dataPtr->elementDescriptions.clear();
-  for (ElementPtr_V::const_iterator iter =
-       _elem->dataPtr->elementDescriptions.begin();
-       iter != _elem->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    this->dataPtr->elementDescriptions.push_back((*iter)->Clone());
-  }
+  this->dataPtr->elementDescriptions = _elem->dataPtr->elementDescriptions;
+  this->dataPtr->elementDescriptionIndex =
+    _elem->dataPtr->elementDescriptionIndex;
 
   this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.clear();
   for (ElementPtr_V::iterator iter = _elem->dataPtr->elements.begin();
        iter != _elem->dataPtr->elements.end(); ++iter)
   {
     ElementPtr elem = (*iter)->Clone();
     elem->Copy(*iter);
     elem->SetParent(shared_from_this());
-    this->dataPtr->elements.push_back(elem);
+    this->InsertElement(elem);
   }
 }
 
 /////////////////////////////////////////////////
 void Element::PrintDescription(const std::string &_prefix) const
 {
-  std::cout << _prefix << "<element name ='" << this->dataPtr->name
-            << "' required ='" << this->dataPtr->required << "'";
+  std::cout << _prefix << "<element name ='" << *this->dataPtr->name
+            << "' required ='" << *this->dataPtr->required << "'";
 
   if (this->dataPtr->value)
   {
@@ -310,8 +350,8 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
     (*eiter)->PrintDocRightPane(childHTML, _spacing + 4, _index);
   }
 
-  stream << "<a name=\"" << this->dataPtr->name << start
-         << "\">&lt" << this->dataPtr->name << "&gt</a>";
+  stream << "<a name=\"" << *this->dataPtr->name << start
+         << "\">&lt" << *this->dataPtr->name << "&gt</a>";
 
   stream << "<div style='padding-left:" << _spacing << "px;'>\n";
 
@@ -328,7 +368,7 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
   }
 
   stream << "<font style='font-weight:bold'>Required: </font>"
-         << this->dataPtr->required << "&nbsp;&nbsp;&nbsp;\n";
+         << *this->dataPtr->required << "&nbsp;&nbsp;&nbsp;\n";
 
   stream << "<font style='font-weight:bold'>Type: </font>";
   if (this->dataPtr->value)
@@ -407,8 +447,8 @@ void Element::PrintDocLeftPane(std::string &_html, int _spacing,
   }
 
   stream << "<a id='" << start << "' onclick='highlight(" << start
-         << ");' href=\"#" << this->dataPtr->name << start
-         << "\">&lt" << this->dataPtr->name << "&gt</a>";
+         << ");' href=\"#" << *this->dataPtr->name << start
+         << "\">&lt" << *this->dataPtr->name << "&gt</a>";
 
   stream << "<div style='padding-left:" << _spacing << "px;'>\n";
 
@@ -417,10 +457,34 @@ void Element::PrintDocLeftPane(std::string &_html, int _spacing,
   _html += "</div>\n";
 }
 
+/////////////////////////////////////////////////
+/// \brief Write the prefix and indentation of a line.
+/// \param[out] _out Stream to write to.
+/// \param[in] _prefix Prefix of the line.
+/// \param[in] _depth Number of levels to indent the line after the prefix.
+static void writeIndent(std::ostream &_out, const std::string &_prefix,
+                        unsigned int _depth)
+{
+  static const char spaces[] = "                                ";
+  const std::streamsize maxSpaces = sizeof(spaces) - 1;
+
+  _out.write(_prefix.data(), static_cast<std::streamsize>(_prefix.size()));
+  std::streamsize count = 2 * static_cast<std::streamsize>(_depth);
+  while (count > 0)
+  {
+    const std::streamsize n = std::min(count, maxSpaces);
+    _out.write(spaces, n);
+    count -= n;
+  }
+}
+
+/////////////////////////////////////////////////
 void Element::PrintValuesImpl(const std::string &_prefix,
-                              std::ostringstream &_out) const
+                              unsigned int _depth,
+                              std::ostream &_out) const
 {
-  _out << _prefix << "<" << this->dataPtr->name;
+  writeIndent(_out, _prefix, _depth);
+  _out << "<" << *this->dataPtr->name;
 
   Param_V::const_iterator aiter;
   for (aiter = this->dataPtr->attributes.begin();
@@ -433,8 +497,9 @@ void Element::PrintValuesImpl(const std::string &_prefix,
     // attributes with their default values.
     if ((*aiter)->GetSet() || (*aiter)->GetRequired())
     {
-      _out << " " << (*aiter)->GetKey() << "='"
-           << (*aiter)->GetAsString() << "'";
+      _out << " " << (*aiter)->GetKey() << "='";
+      (*aiter)->WriteValue(_out);
+      _out << "'";
     }
   }
 
@@ -445,16 +510,18 @@ void Element::PrintValuesImpl(const std::string &_prefix,
     for (eiter = this->dataPtr->elements.begin();
          eiter != this->dataPtr->elements.end(); ++eiter)
     {
-      (*eiter)->ToString(_prefix + "  ", _out);
+      (*eiter)->ToString(_prefix, _depth + 1, _out);
     }
-    _out << _prefix << "</" << this->dataPtr->name << ">\n";
+    writeIndent(_out, _prefix, _depth);
+    _out << "</" << *this->dataPtr->name << ">\n";
   }
   else
   {
     if (this->dataPtr->value)
     {
-      _out << ">" << this->dataPtr->value->GetAsString()
-           << "</" << this->dataPtr->name << ">\n";
+      _out << ">";
+      this->dataPtr->value->WriteValue(_out);
+      _out << "</" << *this->dataPtr->name << ">\n";
     }
     else
     {
@@ -466,30 +533,36 @@ void Element::PrintValuesImpl(const std::string &_prefix,
 /////////////////////////////////////////////////
 void Element::PrintValues(std::string _prefix) const
 {
-  std::ostringstream ss;
-  PrintValuesImpl(_prefix, ss);
-  std::cout << ss.str();
+  this->PrintValues(std::cout, _prefix);
+}
+
+/////////////////////////////////////////////////
+void Element::PrintValues(std::ostream &_out,
+                          const std::string &_prefix) const
+{
+  this->PrintValuesImpl(_prefix, 0, _out);
 }
 
 /////////////////////////////////////////////////
 std::string Element::ToString(const std::string &_prefix) const
 {
   std::ostringstream out;
-  this->ToString(_prefix, out);
+  this->ToString(_prefix, 0, out);
   return out.str();
 }
 
 /////////////////////////////////////////////////
-void Element::ToString(const std::string &_prefix,
-                       std::ostringstream &_out) const
+void Element::ToString(const std::string &_prefix, unsigned int _depth,
+                       std::ostream &_out) const
 {
   if (this->dataPtr->includeFilename.empty())
   {
-    PrintValuesImpl(_prefix, _out);
+    PrintValuesImpl(_prefix, _depth, _out);
   }
   else
   {
-    _out << _prefix << "<include filename='"
+    writeIndent(_out, _prefix, _depth);
+    _out << "<include filename='"
          << this->dataPtr->includeFilename << "'/>\n";
   }
 }
@@ -516,6 +589,16 @@ bool Element::GetAttributeSet(const std::string &_key) const
 /////////////////////////////////////////////////
 ParamPtr Element::GetAttribute(const std::string &_key) const
 {
+  if (!this->dataPtr->attributeIndex.empty())
+  {
+    auto iter = this->dataPtr->attributeIndex.find(_key);
+    if (iter != this->dataPtr->attributeIndex.end())
+    {
+      return this->dataPtr->attributes[iter->second];
+    }
+    return ParamPtr();
+  }
+
   Param_V::const_iterator iter;
   for (iter = this->dataPtr->attributes.begin();
       iter != this->dataPtr->attributes.end(); ++iter)
@@ -566,6 +649,16 @@ ElementPtr Element::GetElementDescription(unsigned int _index) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementDescription(const std::string &_key) const
 {
+  if (this->dataPtr->elementDescriptionIndex)
+  {
+    auto iter = this->dataPtr->elementDescriptionIndex->find(_key);
+    if (iter != this->dataPtr->elementDescriptionIndex->end())
+    {
+      return this->dataPtr->elementDescriptions[iter->second];
+    }
+    return ElementPtr();
+  }
+
   ElementPtr_V::const_iterator iter;
   for (iter = this->dataPtr->elementDescriptions.begin();
        iter != this->dataPtr->elementDescriptions.end(); ++iter)
@@ -594,6 +687,16 @@ bool Element::HasElement(const std::string &_name) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementImpl(const std::string &_name) const
 {
+  if (!this->dataPtr->elementIndex.empty())
+  {
+    auto iter = this->dataPtr->elementIndex.find(_name);
+    if (iter != this->dataPtr->elementIndex.end())
+    {
+      return this->dataPtr->elements[iter->second];
+    }
+    return ElementPtr();
+  }
+
   ElementPtr_V::const_iterator iter;
   for (iter = this->dataPtr->elements.begin();
        iter != this->dataPtr->elements.end(); ++iter)
@@ -626,9 +729,20 @@ ElementPtr Element::GetNextElement(const std::string &_name) const
   auto parent = this->dataPtr->parent.lock();
   if (parent)
   {
+    // Start from the cached index of this element in its parent, and only
+    // search for it if the index is stale.
     ElementPtr_V::const_iterator iter;
-    iter = std::find(parent->dataPtr->elements.begin(),
-        parent->dataPtr->elements.end(), shared_from_this());
+    const std::size_t index = this->dataPtr->indexInParent;
+    if (index < parent->dataPtr->elements.size() &&
+        parent->dataPtr->elements[index].get() == this)
+    {
+      iter = parent->dataPtr->elements.begin() + index;
+    }
+    else
+    {
+      iter = std::find(parent->dataPtr->elements.begin(),
+          parent->dataPtr->elements.end(), shared_from_this());
+    }
 
     if (iter == parent->dataPtr->elements.end())
     {
@@ -742,7 +856,18 @@ ElementPtr Element::GetElement(const std::string &_name)
 /////////////////////////////////////////////////
 void Element::InsertElement(ElementPtr _elem)
 {
+  _elem->dataPtr->indexInParent = this->dataPtr->elements.size();
   this->dataPtr->elements.push_back(_elem);
+
+  if (!this->dataPtr->elementIndex.empty())
+  {
+    this->dataPtr->elementIndex.emplace(
+        _elem->GetName(), _elem->dataPtr->indexInParent);
+  }
+  else if (this->dataPtr->elements.size() >= nameIndexThreshold)
+  {
+    this->RebuildElementIndex();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -757,40 +882,35 @@ ElementPtr Element::AddElement(const std::string &_name)
   // if this element is a reference sdf and does not have any element
   // descriptions then get them from its parent
   auto parent = this->dataPtr->parent.lock();
-  if (!this->dataPtr->referenceSDF.empty() &&
+  if (!this->dataPtr->referenceSDF->empty() &&
       this->dataPtr->elementDescriptions.empty() && parent &&
-      parent->GetName() == this->dataPtr->name)
+      parent->dataPtr->name == this->dataPtr->name)
   {
-    for (unsigned int i = 0; i < parent->GetElementDescriptionCount(); ++i)
-    {
-      this->dataPtr->elementDescriptions.push_back(
-          parent->GetElementDescription(i)->Clone());
-    }
+    this->dataPtr->elementDescriptions = parent->dataPtr->elementDescriptions;
+    this->dataPtr->elementDescriptionIndex =
+      parent->dataPtr->elementDescriptionIndex;
   }
 
-  ElementPtr_V::const_iterator iter, iter2;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  ElementPtr desc = this->GetElementDescription(_name);
+  if (desc)
   {
-    if ((*iter)->dataPtr->name == _name)
-    {
-      ElementPtr elem = (*iter)->Clone();
-      elem->SetParent(shared_from_this());
-      this->dataPtr->elements.push_back(elem);
+    ElementPtr elem = desc->Clone();
+    elem->SetParent(shared_from_this());
+    this->InsertElement(elem);
 
-      // Add all child elements.
-      for (iter2 = elem->dataPtr->elementDescriptions.begin();
-           iter2 != elem->dataPtr->elementDescriptions.end(); ++iter2)
+    // Add all child elements.
+    ElementPtr_V::const_iterator iter;
+    for (iter = elem->dataPtr->elementDescriptions.begin();
+         iter != elem->dataPtr->elementDescriptions.end(); ++iter)
+    {
+      // Add only required child element
+      if ((*iter)->GetRequired() == "1")
       {
-        // Add only required child element
-        if ((*iter2)->GetRequired() == "1")
-        {
-          elem->AddElement((*iter2)->dataPtr->name);
-        }
+        elem->AddElement(*(*iter)->dataPtr->name);
       }
-
-      return this->dataPtr->elements.back();
     }
+
+    return elem;
   }
 
   sdferr << "Missing element description for [" << _name << "]\n";
@@ -815,6 +935,7 @@ void Element::ClearElements()
   }
 
   this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.clear();
 }
 
 /////////////////////////////////////////////////
@@ -851,17 +972,12 @@ void Element::Reset()
     (*iter).reset();
   }
 
-  for (ElementPtr_V::iterator iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    if (*iter)
-    {
-      (*iter)->Reset();
-    }
-    (*iter).reset();
-  }
+  // Element descriptions may be shared with other elements and the spec
+  // cache, so they are only released here and not reset.
   this->dataPtr->elements.clear();
+  this->dataPtr->elementIndex.clear();
   this->dataPtr->elementDescriptions.clear();
+  this->dataPtr->elementDescriptionIndex.reset();
 
   this->dataPtr->value.reset();
 
@@ -872,6 +988,20 @@ void Element::Reset()
 void Element::AddElementDescription(ElementPtr _elem)
 {
   this->dataPtr->elementDescriptions.push_back(_elem);
+
+  // The index is shared with clones of this element, so build a new one
+  // rather than modifying it.
+  if (this->dataPtr->elementDescriptions.size() >= nameIndexThreshold)
+  {
+    auto index = std::make_shared<std::unordered_map<std::string,
+                                                     std::size_t>>();
+    for (std::size_t i = 0;
+         i < this->dataPtr->elementDescriptions.size(); ++i)
+    {
+      index->emplace(this->dataPtr->elementDescriptions[i]->GetName(), i);
+    }
+    this->dataPtr->elementDescriptionIndex = index;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -934,7 +1064,8 @@ void Element::RemoveFromParent()
 
     if (iter != parent->dataPtr->elements.end())
     {
-      parent->dataPtr->elements.erase(iter);
+      parent->UpdateChildIndices(
+          parent->dataPtr->elements.erase(iter));
       parent.reset();
     }
   }
@@ -952,7 +1083,36 @@ void Element::RemoveChild(ElementPtr _child)
   if (iter != this->dataPtr->elements.end())
   {
     _child->SetParent(ElementPtr());
-    this->dataPtr->elements.erase(iter);
+    this->UpdateChildIndices(this->dataPtr->elements.erase(iter));
+  }
+}
+
+/////////////////////////////////////////////////
+void Element::UpdateChildIndices(ElementPtr_V::const_iterator _start)
+{
+  for (auto iter = _start; iter != this->dataPtr->elements.end(); ++iter)
+  {
+    (*iter)->dataPtr->indexInParent =
+      iter - this->dataPtr->elements.begin();
+  }
+  this->RebuildElementIndex();
+}
+
+/////////////////////////////////////////////////
+void Element::RebuildElementIndex()
+{
+  this->dataPtr->elementIndex.clear();
+  if (this->dataPtr->elements.size() < nameIndexThreshold)
+  {
+    return;
+  }
+
+  // emplace keeps the first element with each name, which matches the
+  // result of a linear search.
+  for (std::size_t i = 0; i < this->dataPtr->elements.size(); ++i)
+  {
+    this->dataPtr->elementIndex.emplace(
+        this->dataPtr->elements[i]->GetName(), i);
   }
 }
 
@@ -15,6 +15,11 @@
  *
  */
 
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "sdf/Element.hh"
@@ -283,6 +288,12 @@ TEST(Element, Clone)
   ASSERT_NE(newelem->GetFirstElement(), nullptr);
   ASSERT_EQ(newelem->GetElementDescriptionCount(), 1UL);
   ASSERT_EQ(newelem->GetAttributeCount(), 1UL);
+
+  // Element descriptions are shared, not copied
+  EXPECT_EQ(desc, newelem->GetElementDescription(0));
+
+  // Attributes are copied
+  EXPECT_NE(parent->GetAttribute("test"), newelem->GetAttribute("test"));
 }
 
 /////////////////////////////////////////////////
@@ -448,6 +459,34 @@ TEST(Element, ToStringInclude)
   ASSERT_EQ(stringval, "myprefix<include filename='foo.txt'/>\n");
 }
 
+/////////////////////////////////////////////////
+TEST(Element, PrintValuesToStream)
+{
+  // Nest deeper than the indentation written in one piece.
+  const int depth = 20;
+  sdf::ElementPtr root = std::make_shared<sdf::Element>();
+  root->SetName("e0");
+  root->AddAttribute("test", "double", "0.5", true, "test description");
+  sdf::ElementPtr parent = root;
+  for (int i = 1; i <= depth; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("e" + std::to_string(i));
+    child->AddValue("pose", "1 2 3 0 0 0", false, "pose description");
+    parent->InsertElement(child);
+    parent = child;
+  }
+
+  std::ostringstream out;
+  root->PrintValues(out, "myprefix");
+  EXPECT_EQ(root->ToString("myprefix"), out.str());
+
+  const std::string deepest =
+    "myprefix" + std::string(2 * depth, ' ') + "<e20>1 2 3 0 0 0</e20>\n";
+  EXPECT_NE(std::string::npos, out.str().find(deepest));
+  EXPECT_EQ(0u, out.str().find("myprefix<e0 test='0.5'>\n"));
+}
+
 /////////////////////////////////////////////////
 TEST(Element, DocLeftPane)
 {
@@ -629,6 +668,100 @@ TEST(Element, GetNextElementMultiple)
   ASSERT_EQ(child2->GetNextElement(""), nullptr);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, GetNextElementAfterRemove)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> children;
+  for (int i = 0; i < 4; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("child" + std::to_string(i));
+    child->SetParent(parent);
+    parent->InsertElement(child);
+    children.push_back(child);
+  }
+
+  EXPECT_EQ(children[1], children[0]->GetNextElement());
+  EXPECT_EQ(children[2], children[0]->GetNextElement("child2"));
+
+  parent->RemoveChild(children[1]);
+  EXPECT_EQ(children[2], children[0]->GetNextElement());
+  EXPECT_EQ(children[3], children[2]->GetNextElement());
+  EXPECT_EQ(nullptr, children[1]->GetNextElement());
+
+  children[2]->RemoveFromParent();
+  EXPECT_EQ(children[3], children[0]->GetNextElement());
+  EXPECT_EQ(nullptr, children[3]->GetNextElement());
+
+  sdf::ElementPtr clone = parent->Clone();
+  sdf::ElementPtr first = clone->GetFirstElement();
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, first->GetNextElement());
+  EXPECT_EQ("child3", first->GetNextElement()->GetName());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, GetElementManyChildren)
+{
+  // Use enough children that lookups by name are indexed.
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> children;
+  for (int i = 0; i < 40; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("child" + std::to_string(i % 20));
+    child->SetParent(parent);
+    parent->InsertElement(child);
+    children.push_back(child);
+  }
+
+  // The first child with a given name is returned.
+  EXPECT_EQ(children[5], parent->GetElementImpl("child5"));
+  EXPECT_EQ(children[19], parent->GetElementImpl("child19"));
+  EXPECT_FALSE(parent->HasElement("child20"));
+
+  // Removing a child returns the next one with the same name.
+  parent->RemoveChild(children[5]);
+  EXPECT_EQ(children[25], parent->GetElementImpl("child5"));
+  EXPECT_EQ(children[19], parent->GetElementImpl("child19"));
+
+  // Renaming a child is reflected in lookups.
+  children[3]->SetName("renamed");
+  EXPECT_EQ(children[3], parent->GetElementImpl("renamed"));
+  EXPECT_EQ(children[23], parent->GetElementImpl("child3"));
+
+  // Clones are indexed too.
+  sdf::ElementPtr clone = parent->Clone();
+  ASSERT_NE(nullptr, clone->GetElementImpl("renamed"));
+  EXPECT_NE(children[3], clone->GetElementImpl("renamed"));
+  EXPECT_EQ(clone, clone->GetElementImpl("renamed")->GetParent());
+
+  parent->ClearElements();
+  EXPECT_FALSE(parent->HasElement("child0"));
+}
+
+/////////////////////////////////////////////////
+TEST(Element, GetAttributeManyAttributes)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  for (int i = 0; i < 40; ++i)
+  {
+    elem->AddAttribute("attr" + std::to_string(i), "int", std::to_string(i),
+        false);
+  }
+
+  ASSERT_NE(nullptr, elem->GetAttribute("attr0"));
+  ASSERT_NE(nullptr, elem->GetAttribute("attr39"));
+  EXPECT_EQ("39", elem->GetAttribute("attr39")->GetAsString());
+  EXPECT_EQ(nullptr, elem->GetAttribute("attr40"));
+
+  sdf::ElementPtr clone = elem->Clone();
+  ASSERT_NE(nullptr, clone->GetAttribute("attr39"));
+  EXPECT_NE(elem->GetAttribute("attr39"), clone->GetAttribute("attr39"));
+  EXPECT_EQ("39", clone->GetAttribute("attr39")->GetAsString());
+}
+
 /////////////////////////////////////////////////
 TEST(Element, CountNamedElements)
 {
@@ -15,6 +15,7 @@
  *
 */
 #include <string>
+#include <vector>
 
 #include "sdf/Element.hh"
 #include "sdf/Error.hh"
@@ -453,6 +454,7 @@ Errors buildPoseRelativeToGraph(
   // add implicit model frame vertex first
   const std::string sourceName = "__model__";
   _out.sourceName = sourceName;
+  _out.rootPoses.clear();
   auto modelFrameId =
       _out.graph.AddVertex(sourceName, sdf::FrameType::MODEL).Id();
   _out.map[sourceName] = modelFrameId;
@@ -684,6 +686,7 @@ Errors buildPoseRelativeToGraph(
   // add implicit world frame vertex first
   const std::string sourceName = "world";
   _out.sourceName = sourceName;
+  _out.rootPoses.clear();
   auto worldFrameId =
       _out.graph.AddVertex(sourceName, sdf::FrameType::WORLD).Id();
   _out.map[sourceName] = worldFrameId;
@@ -825,6 +828,127 @@ Errors buildPoseRelativeToGraph(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Size the arrays of a FrameTree and fill in its vertices.
+/// \param[out] _tree Tree to fill.
+/// \param[in] _graph Graph to read from.
+template<typename EdgeType, typename GraphType>
+static void initFrameTree(FrameTree<EdgeType> &_tree, const GraphType &_graph)
+{
+  const auto vertices = _graph.Vertices();
+  if (vertices.empty())
+    return;
+
+  const std::size_t size = vertices.rbegin()->first + 1;
+  _tree.parent.assign(size, ignition::math::graph::kNullId);
+  _tree.parentEdgeCount.assign(size, 0u);
+  _tree.edge.assign(size, EdgeType());
+  _tree.type.assign(size, FrameType::FRAME);
+  _tree.name.assign(size, nullptr);
+  for (auto const &vertexPair : vertices)
+  {
+    auto const &vertex = vertexPair.second.get();
+    _tree.type[vertexPair.first] = vertex.Data();
+    _tree.name[vertexPair.first] = &vertex.Name();
+  }
+}
+
+/////////////////////////////////////////////////
+FrameTree<ignition::math::Pose3d> buildFrameTree(
+    const PoseRelativeToGraph &_graph)
+{
+  FrameTree<ignition::math::Pose3d> tree;
+  initFrameTree(tree, _graph.graph);
+
+  // Edges point from the relative-to frame to the frame.
+  for (auto const &edgePair : _graph.graph.Edges())
+  {
+    auto const &edge = edgePair.second.get();
+    const auto child = edge.Vertices().second;
+    tree.parent[child] = edge.Vertices().first;
+    tree.edge[child] = edge.Data();
+    ++tree.parentEdgeCount[child];
+  }
+
+  return tree;
+}
+
+/////////////////////////////////////////////////
+FrameTree<bool> buildFrameTree(const FrameAttachedToGraph &_graph)
+{
+  FrameTree<bool> tree;
+  initFrameTree(tree, _graph.graph);
+
+  // Edges point from the frame to its attached-to frame.
+  for (auto const &edgePair : _graph.graph.Edges())
+  {
+    auto const &edge = edgePair.second.get();
+    const auto child = edge.Vertices().first;
+    tree.parent[child] = edge.Vertices().second;
+    tree.edge[child] = edge.Data();
+    ++tree.parentEdgeCount[child];
+  }
+
+  return tree;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that following the parents from every named vertex of a
+/// FrameTree leads to a valid root without a cycle. Each vertex is visited
+/// once, since the result of a vertex is kept for the vertices below it.
+/// \param[in] _tree The tree.
+/// \param[in] _map Map from vertex names to ids, giving the vertices to
+/// check.
+/// \param[in] _isRoot Function that tells whether a vertex without a
+/// parent is a valid root.
+/// \return True if every vertex leads to a valid root.
+template<typename EdgeType, typename MapType, typename RootFunction>
+static bool allVerticesReachRoot(const FrameTree<EdgeType> &_tree,
+    const MapType &_map, RootFunction _isRoot)
+{
+  using VertexId = ignition::math::graph::VertexId;
+  enum class State : char { UNKNOWN, VISITING, REACHES_ROOT };
+
+  const std::size_t size = _tree.name.size();
+  std::vector<State> state(size, State::UNKNOWN);
+  std::vector<VertexId> path;
+
+  for (auto const &namePair : _map)
+  {
+    VertexId id = namePair.second;
+    if (id >= size || !_tree.name[id])
+      return false;
+
+    path.clear();
+    while (state[id] != State::REACHES_ROOT)
+    {
+      // A vertex on the current path means a cycle.
+      if (state[id] == State::VISITING)
+        return false;
+      state[id] = State::VISITING;
+      path.push_back(id);
+
+      if (_tree.parentEdgeCount[id] > 1)
+        return false;
+      if (_tree.parentEdgeCount[id] == 0)
+      {
+        if (!_isRoot(id))
+          return false;
+        break;
+      }
+
+      id = _tree.parent[id];
+      if (id >= size || !_tree.name[id])
+        return false;
+    }
+
+    for (VertexId v : path)
+      state[v] = State::REACHES_ROOT;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
 {
@@ -876,33 +1000,37 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
   }
 
   // Check number of outgoing edges for each vertex
-  auto vertices = _in.graph.Vertices();
-  for (auto vertexPair : vertices)
+  const FrameTree<bool> tree = buildFrameTree(_in);
+  for (std::size_t id = 0; id < tree.name.size(); ++id)
   {
+    if (!tree.name[id])
+      continue;
+    const std::string &vertexName = *tree.name[id];
+
     // Vertex names should not be empty
-    if (vertexPair.second.get().Name().empty())
+    if (vertexName.empty())
     {
       errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
           "FrameAttachedToGraph error, "
           "vertex with empty name detected."});
     }
 
-    auto outDegree = _in.graph.OutDegree(vertexPair.first);
+    auto outDegree = tree.parentEdgeCount[id];
     if (outDegree > 1)
     {
       errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
           "FrameAttachedToGraph error, "
           "too many outgoing edges at a vertex with name [" +
-          vertexPair.second.get().Name() + "]."});
+          vertexName + "]."});
     }
     else if (sdf::FrameType::MODEL == scopeFrameType)
     {
-      switch (vertexPair.second.get().Data())
+      switch (tree.type[id])
       {
         case sdf::FrameType::WORLD:
           errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
               "FrameAttachedToGraph error, "
-              "vertex with name [" + vertexPair.second.get().Name() + "]" +
+              "vertex with name [" + vertexName + "]" +
               "should not have type WORLD in MODEL attached_to graph."});
           break;
         case sdf::FrameType::LINK:
@@ -911,7 +1039,7 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
             errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
                 "FrameAttachedToGraph error, "
                 "LINK vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] should have no outgoing edges "
                 "in MODEL attached_to graph."});
           }
@@ -922,7 +1050,7 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
             errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
                 "FrameAttachedToGraph error, "
                 "Non-LINK vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] is disconnected; it should have 1 outgoing edge " +
                 "in MODEL attached_to graph."});
           }
@@ -931,7 +1059,7 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
             errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
                 "FrameAttachedToGraph error, "
                 "Non-LINK vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] has " + std::to_string(outDegree) +
                 " outgoing edges; it should only have 1 "
                 "outgoing edge in MODEL attached_to graph."});
@@ -942,7 +1070,7 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
     else
     {
       // scopeFrameType must be sdf::FrameType::WORLD
-      switch (vertexPair.second.get().Data())
+      switch (tree.type[id])
       {
         case sdf::FrameType::JOINT:
         case sdf::FrameType::LINK:
@@ -973,7 +1101,22 @@ Errors validateFrameAttachedToGraph(const FrameAttachedToGraph &_in)
     }
   }
 
-  // check graph for cycles by finding sink from each vertex
+  // Check graph for cycles by finding sink from each vertex. The compact
+  // form finds them all in one pass; if it finds a problem, each vertex is
+  // resolved on its own to report the errors.
+  const bool worldScope = _in.scopeName == "world";
+  auto isBody = [&tree, worldScope](ignition::math::graph::VertexId _id)
+  {
+    if (worldScope)
+    {
+      return tree.type[_id] == FrameType::WORLD ||
+             tree.type[_id] == FrameType::MODEL;
+    }
+    return tree.type[_id] == FrameType::LINK;
+  };
+  if (allVerticesReachRoot(tree, _in.map, isBody))
+    return errors;
+
   for (auto const &namePair : _in.map)
   {
     std::string resolvedBody;
@@ -1035,33 +1178,37 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
   }
 
   // Check number of incoming edges for each vertex
-  auto vertices = _in.graph.Vertices();
-  for (auto vertexPair : vertices)
+  const FrameTree<ignition::math::Pose3d> tree = buildFrameTree(_in);
+  for (std::size_t id = 0; id < tree.name.size(); ++id)
   {
+    if (!tree.name[id])
+      continue;
+    const std::string &vertexName = *tree.name[id];
+
     // Vertex names should not be empty
-    if (vertexPair.second.get().Name().empty())
+    if (vertexName.empty())
     {
       errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
           "PoseRelativeToGraph error, "
           "vertex with empty name detected."});
     }
 
-    auto inDegree = _in.graph.InDegree(vertexPair.first);
+    auto inDegree = tree.parentEdgeCount[id];
     if (inDegree > 1)
     {
       errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
           "PoseRelativeToGraph error, "
           "too many incoming edges at a vertex with name [" +
-          vertexPair.second.get().Name() + "]."});
+          vertexName + "]."});
     }
     else if (sdf::FrameType::MODEL == sourceFrameType)
     {
-      switch (vertexPair.second.get().Data())
+      switch (tree.type[id])
       {
         case sdf::FrameType::WORLD:
           errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
               "PoseRelativeToGraph error, "
-              "vertex with name [" + vertexPair.second.get().Name() + "]" +
+              "vertex with name [" + vertexName + "]" +
               "should not have type WORLD in MODEL relative_to graph."});
           break;
         case sdf::FrameType::MODEL:
@@ -1070,7 +1217,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
             errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
                 "PoseRelativeToGraph error, "
                 "MODEL vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] should have no incoming edges "
                 "in MODEL relative_to graph."});
           }
@@ -1081,7 +1228,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
             errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
                 "PoseRelativeToGraph error, "
                 "Non-MODEL vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] is disconnected; it should have 1 incoming edge " +
                 "in MODEL relative_to graph."});
           }
@@ -1090,7 +1237,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
             errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
                 "PoseRelativeToGraph error, "
                 "Non-MODEL vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] has " + std::to_string(inDegree) +
                 " incoming edges; it should only have 1 "
                 "incoming edge in MODEL relative_to graph."});
@@ -1101,7 +1248,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
     else
     {
       // sourceFrameType must be sdf::FrameType::WORLD
-      switch (vertexPair.second.get().Data())
+      switch (tree.type[id])
       {
         case sdf::FrameType::JOINT:
         case sdf::FrameType::LINK:
@@ -1124,7 +1271,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
             errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
                 "PoseRelativeToGraph error, "
                 "MODEL / FRAME vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] is disconnected; it should have 1 incoming edge " +
                 "in WORLD relative_to graph."});
           }
@@ -1133,7 +1280,7 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
             errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
                 "PoseRelativeToGraph error, "
                 "MODEL / FRAME vertex with name [" +
-                vertexPair.second.get().Name() +
+                vertexName +
                 "] has " + std::to_string(inDegree) +
                 " incoming edges; it should only have 1 "
                 "incoming edge in WORLD relative_to graph."});
@@ -1143,7 +1290,17 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
     }
   }
 
-  // check graph for cycles by resolving pose of each vertex relative to root
+  // Check graph for cycles by resolving pose of each vertex relative to
+  // root. The compact form finds them all in one pass; if it finds a
+  // problem, each vertex is resolved on its own to report the errors.
+  const auto sourceId = sourceVertex.Id();
+  auto isSource = [sourceId](ignition::math::graph::VertexId _id)
+  {
+    return _id == sourceId;
+  };
+  if (allVerticesReachRoot(tree, _in.map, isSource))
+    return errors;
+
   for (auto const &namePair : _in.map)
   {
     ignition::math::Pose3d pose;
@@ -1154,6 +1311,279 @@ Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in)
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Compute the pose of every vertex of a PoseRelativeToGraph
+/// relative to its source vertex, using the compact form of the graph.
+/// \param[in] _graph Graph to read from.
+/// \param[out] _poses Poses indexed by VertexId.
+/// \return False if the graph is not a tree rooted at its source vertex.
+static bool posesRelativeToSource(
+    const PoseRelativeToGraph &_graph,
+    std::vector<ignition::math::Pose3d> &_poses)
+{
+  using VertexId = ignition::math::graph::VertexId;
+
+  auto sourceIt = _graph.map.find(_graph.sourceName);
+  if (sourceIt == _graph.map.end())
+    return false;
+  const VertexId sourceId = sourceIt->second;
+
+  const FrameTree<ignition::math::Pose3d> tree = buildFrameTree(_graph);
+  const std::size_t size = tree.name.size();
+  if (sourceId >= size)
+    return false;
+
+  // Each pose is computed once, after the pose of its relative-to frame.
+  std::vector<ignition::math::Pose3d> poses(size);
+  std::vector<bool> done(size, false);
+  std::vector<bool> visiting(size, false);
+  std::vector<VertexId> path;
+  for (VertexId id = 0; id < size; ++id)
+  {
+    if (!tree.name[id])
+      continue;
+
+    // Walk up to a vertex whose pose is known.
+    path.clear();
+    VertexId v = id;
+    while (!done[v])
+    {
+      if (visiting[v] || tree.parentEdgeCount[v] > 1)
+        return false;
+      if (tree.parentEdgeCount[v] == 0)
+      {
+        if (v != sourceId)
+          return false;
+        done[v] = true;
+        break;
+      }
+      visiting[v] = true;
+      path.push_back(v);
+      v = tree.parent[v];
+      if (v >= size || !tree.name[v])
+        return false;
+    }
+
+    // Compose the poses back down to the vertex.
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+      poses[*it] = poses[tree.parent[*it]] * tree.edge[*it];
+      done[*it] = true;
+    }
+  }
+
+  _poses = std::move(poses);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void cachePoseRelativeToRoot(PoseRelativeToGraph &_graph)
+{
+  _graph.rootPoses.clear();
+
+  std::vector<ignition::math::Pose3d> poses;
+  if (posesRelativeToSource(_graph, poses))
+    _graph.rootPoses = std::move(poses);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a vertex is a given vertex or one of its
+/// descendants in a graph that forms a tree, by visiting the descendants.
+/// \param[in] _graph The graph.
+/// \param[in] _rootId Id of the vertex at the top of the subtree.
+/// \param[in] _id Id of the vertex to look for.
+/// \param[in] _edgesFromParent True if the edges of the graph point from
+/// parents to children, as in a PoseRelativeToGraph, and false if they
+/// point from children to parents, as in a FrameAttachedToGraph.
+/// \return True if _id is in the subtree.
+template<typename VertexType, typename EdgeType>
+static bool isInSubtree(
+    const ignition::math::graph::DirectedGraph<VertexType, EdgeType> &_graph,
+    const ignition::math::graph::VertexId _rootId,
+    const ignition::math::graph::VertexId _id,
+    const bool _edgesFromParent)
+{
+  std::vector<ignition::math::graph::VertexId> toVisit{_rootId};
+  while (!toVisit.empty())
+  {
+    const auto id = toVisit.back();
+    toVisit.pop_back();
+    if (id == _id)
+      return true;
+
+    const auto edges = _edgesFromParent ?
+        _graph.IncidentsFrom(id) : _graph.IncidentsTo(id);
+    for (auto const &edgePair : edges)
+    {
+      auto const &vertices = edgePair.second.get().Vertices();
+      toVisit.push_back(_edgesFromParent ? vertices.second : vertices.first);
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+Errors updatePoseRelativeTo(
+    PoseRelativeToGraph &_graph,
+    const std::string &_vertexName,
+    const std::string &_relativeTo,
+    const ignition::math::Pose3d &_rawPose)
+{
+  using VertexId = ignition::math::graph::VertexId;
+  Errors errors;
+
+  if (_graph.rootPoses.empty())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph error: the graph must be valid and its poses "
+        "cached before it can be updated."});
+    return errors;
+  }
+
+  auto vertexIt = _graph.map.find(_vertexName);
+  if (vertexIt == _graph.map.end())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "PoseRelativeToGraph unable to find unique frame with name [" +
+        _vertexName + "] in graph."});
+    return errors;
+  }
+  const VertexId vertexId = vertexIt->second;
+
+  if (_vertexName == _graph.sourceName)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "The pose of source frame [" + _vertexName + "] can't be "
+        "changed in its own PoseRelativeToGraph."});
+    return errors;
+  }
+
+  auto relativeToIt = _graph.map.find(_relativeTo);
+  if (relativeToIt == _graph.map.end())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "relative_to name[" + _relativeTo +
+        "] specified by frame with name[" + _vertexName +
+        "] does not match a frame name in the PoseRelativeToGraph."});
+    return errors;
+  }
+  const VertexId relativeToId = relativeToIt->second;
+
+  // In a valid graph every vertex but the source has one incoming edge.
+  const auto incoming = _graph.graph.IncidentsTo(vertexId);
+  if (incoming.size() != 1)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph error: frame with name [" + _vertexName +
+        "] should have 1 incoming edge but has " +
+        std::to_string(incoming.size()) + "."});
+    return errors;
+  }
+  const auto oldEdgeId = incoming.begin()->first;
+  const VertexId oldRelativeToId =
+      incoming.begin()->second.get().Vertices().first;
+
+  // A new relative-to frame must not be posed relative to this vertex.
+  if (relativeToId != oldRelativeToId &&
+      isInSubtree(_graph.graph, vertexId, relativeToId, true))
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_CYCLE,
+        "relative_to name[" + _relativeTo +
+        "] specified by frame with name[" + _vertexName +
+        "] is posed relative to that frame, causing a graph cycle."});
+    return errors;
+  }
+
+  _graph.graph.RemoveEdge(oldEdgeId);
+  _graph.graph.AddEdge({relativeToId, vertexId}, _rawPose);
+
+  // Update the cached poses of the vertex and its descendants, parents
+  // before children.
+  _graph.rootPoses[vertexId] = _graph.rootPoses[relativeToId] * _rawPose;
+  std::vector<VertexId> toUpdate{vertexId};
+  for (std::size_t i = 0; i < toUpdate.size(); ++i)
+  {
+    const VertexId parentId = toUpdate[i];
+    for (auto const &edgePair : _graph.graph.IncidentsFrom(parentId))
+    {
+      auto const &edge = edgePair.second.get();
+      const VertexId childId = edge.Vertices().second;
+      _graph.rootPoses[childId] = _graph.rootPoses[parentId] * edge.Data();
+      toUpdate.push_back(childId);
+    }
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors updateFrameAttachedTo(
+    FrameAttachedToGraph &_graph,
+    const std::string &_vertexName,
+    const std::string &_attachedTo)
+{
+  using VertexId = ignition::math::graph::VertexId;
+  Errors errors;
+
+  auto vertexIt = _graph.map.find(_vertexName);
+  if (vertexIt == _graph.map.end())
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "FrameAttachedToGraph unable to find unique frame with name [" +
+        _vertexName + "] in graph."});
+    return errors;
+  }
+  const VertexId vertexId = vertexIt->second;
+
+  if (_graph.graph.VertexFromId(vertexId).Data() != FrameType::FRAME)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "Vertex with name [" + _vertexName + "] is not an explicit frame, "
+        "so its attached_to can't be changed."});
+    return errors;
+  }
+
+  auto attachedToIt = _graph.map.find(_attachedTo);
+  if (attachedToIt == _graph.map.end())
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "attached_to name[" + _attachedTo +
+        "] specified by frame with name[" + _vertexName +
+        "] does not match a frame name in the FrameAttachedToGraph."});
+    return errors;
+  }
+  const VertexId attachedToId = attachedToIt->second;
+
+  // In a valid graph every explicit frame has one outgoing edge.
+  const auto outgoing = _graph.graph.IncidentsFrom(vertexId);
+  if (outgoing.size() != 1)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+        "FrameAttachedToGraph error: frame with name [" + _vertexName +
+        "] should have 1 outgoing edge but has " +
+        std::to_string(outgoing.size()) + "."});
+    return errors;
+  }
+  const auto oldEdgeId = outgoing.begin()->first;
+  if (outgoing.begin()->second.get().Vertices().second == attachedToId)
+    return errors;
+
+  // The new attached-to frame must not be attached to this frame.
+  if (isInSubtree(_graph.graph, vertexId, attachedToId, false))
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_CYCLE,
+        "attached_to name[" + _attachedTo +
+        "] specified by frame with name[" + _vertexName +
+        "] is attached to that frame, causing a graph cycle."});
+    return errors;
+  }
+
+  _graph.graph.RemoveEdge(oldEdgeId);
+  _graph.graph.AddEdge({vertexId, attachedToId}, true);
+
+  return errors;
+}
+
 /////////////////////////////////////////////////
 Errors resolveFrameAttachedToBody(
     std::string &_attachedToBody,
@@ -1237,6 +1667,12 @@ Errors resolvePoseRelativeToRoot(
   }
   auto vertexId = _graph.map.at(_vertexName);
 
+  if (vertexId < _graph.rootPoses.size())
+  {
+    _pose = _graph.rootPoses[vertexId];
+    return errors;
+  }
+
   auto incomingVertexEdges = FindSourceVertex(_graph.graph, vertexId, errors);
 
   if (!errors.empty())
@@ -1294,5 +1730,47 @@ Errors resolvePose(
 
   return errors;
 }
+/////////////////////////////////////////////////
+Errors resolveAllPoses(
+    std::vector<ignition::math::Pose3d> &_poses,
+    const PoseRelativeToGraph &_graph,
+    const std::string &_resolveTo)
+{
+  Errors errors;
+
+  auto resolveToIt = _graph.map.find(_resolveTo);
+  if (resolveToIt == _graph.map.end())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "PoseRelativeToGraph unable to find unique frame with name [" +
+        _resolveTo + "] in graph."});
+    return errors;
+  }
+
+  // Use the cached poses if there are any.
+  std::vector<ignition::math::Pose3d> computedPoses;
+  const std::vector<ignition::math::Pose3d> *rootPoses = &_graph.rootPoses;
+  if (rootPoses->empty())
+  {
+    if (!posesRelativeToSource(_graph, computedPoses))
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+          "PoseRelativeToGraph error: not every frame can be reached from "
+          "the source vertex [" + _graph.sourceName + "]."});
+      return errors;
+    }
+    rootPoses = &computedPoses;
+  }
+
+  const ignition::math::Pose3d inverse =
+      (*rootPoses)[resolveToIt->second].Inverse();
+  _poses.resize(rootPoses->size());
+  for (std::size_t i = 0; i < rootPoses->size(); ++i)
+  {
+    _poses[i] = inverse * (*rootPoses)[i];
+  }
+
+  return errors;
+}
 }
 }
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/graph/Graph.hh>
@@ -97,6 +98,90 @@ namespace sdf
 
     /// \brief Name of source vertex, either __model__ or world.
     std::string sourceName;
+
+    /// \brief Pose of each vertex relative to the source vertex, indexed by
+    /// VertexId. It is filled by cachePoseRelativeToRoot and is empty until
+    /// then, or if the graph is not a valid tree.
+    std::vector<Pose3d> rootPoses;
+  };
+
+  /// \brief Compact form of a frame graph in which each vertex has a single
+  /// parent, stored as a structure of arrays indexed by VertexId. In a
+  /// PoseRelativeToGraph the parent of a frame is its relative-to frame, and
+  /// in a FrameAttachedToGraph it is its attached-to frame. It is built in
+  /// one pass over the graph, and lets the graph be validated and resolved
+  /// without building maps of incident edges at every step.
+  template<typename EdgeType>
+  struct FrameTree
+  {
+    /// \brief Parent of each vertex, or kNullId if it has no parent or the
+    /// id is not used by a vertex.
+    std::vector<ignition::math::graph::VertexId> parent;
+
+    /// \brief Number of edges from each vertex to a parent. A tree has at
+    /// most one. If there are more, parent holds one of them.
+    std::vector<std::size_t> parentEdgeCount;
+
+    /// \brief Data of the edge between each vertex and its parent.
+    std::vector<EdgeType> edge;
+
+    /// \brief FrameType of each vertex.
+    std::vector<FrameType> type;
+
+    /// \brief Name of each vertex, pointing into the graph it was built
+    /// from, or nullptr if the id is not used by a vertex.
+    std::vector<const std::string *> name;
+  };
+
+  /// \brief Build the compact form of a PoseRelativeToGraph, in which the
+  /// parent of each vertex is its relative-to frame. It refers to the names
+  /// of the graph, so it must not outlive changes to the graph.
+  /// \param[in] _graph Graph to read from.
+  /// \return The compact form of the graph.
+  FrameTree<ignition::math::Pose3d> buildFrameTree(
+      const PoseRelativeToGraph &_graph);
+
+  /// \brief Build the compact form of a FrameAttachedToGraph, in which the
+  /// parent of each vertex is its attached-to frame. It refers to the names
+  /// of the graph, so it must not outlive changes to the graph.
+  /// \param[in] _graph Graph to read from.
+  /// \return The compact form of the graph.
+  FrameTree<bool> buildFrameTree(const FrameAttachedToGraph &_graph);
+
+  /// \brief Errors found while building and validating a graph.
+  struct GraphErrors
+  {
+    /// \brief Errors found while building the graph.
+    Errors build;
+
+    /// \brief Errors found while validating the graph.
+    Errors validate;
+  };
+
+  /// \brief Read-only access to the errors found by Model::Load and
+  /// World::Load while building and validating their graphs. Checks that
+  /// run after loading use them instead of building the graphs again.
+  class LoadedGraphErrors
+  {
+    /// \brief Get the errors of the FrameAttachedToGraph of a model.
+    /// \param[in] _model The model.
+    /// \return The errors, or nullptr if Load did not build the graph.
+    public: static const GraphErrors *FrameAttachedTo(const Model *_model);
+
+    /// \brief Get the errors of the FrameAttachedToGraph of a world.
+    /// \param[in] _world The world.
+    /// \return The errors, or nullptr if Load did not build the graph.
+    public: static const GraphErrors *FrameAttachedTo(const World *_world);
+
+    /// \brief Get the errors of the PoseRelativeToGraph of a model.
+    /// \param[in] _model The model.
+    /// \return The errors, or nullptr if Load did not build the graph.
+    public: static const GraphErrors *PoseRelativeTo(const Model *_model);
+
+    /// \brief Get the errors of the PoseRelativeToGraph of a world.
+    /// \param[in] _world The world.
+    /// \return The errors, or nullptr if Load did not build the graph.
+    public: static const GraphErrors *PoseRelativeTo(const World *_world);
   };
 
   /// \brief Build a FrameAttachedToGraph for a model.
@@ -140,6 +225,50 @@ namespace sdf
   /// \return Errors.
   Errors validatePoseRelativeToGraph(const PoseRelativeToGraph &_in);
 
+  /// \brief Compute the pose of every vertex relative to the source vertex
+  /// in a single pass from the source, and store them in the rootPoses of
+  /// the graph. Afterwards resolvePoseRelativeToRoot reads the stored pose
+  /// instead of walking the graph. The stored poses are cleared if a vertex
+  /// can't be reached from the source, so this should be called after
+  /// validatePoseRelativeToGraph succeeds, and again after the graph
+  /// is changed.
+  /// \param[in,out] _graph Graph whose poses are computed.
+  void cachePoseRelativeToRoot(PoseRelativeToGraph &_graph);
+
+  /// \brief Change the relative-to frame and raw pose of a vertex of a
+  /// valid PoseRelativeToGraph in place. Only the vertex and the vertices
+  /// posed relative to it are visited: they are checked for the new
+  /// relative-to frame to avoid a cycle, and their cached root poses are
+  /// updated. The graph is not changed if there are errors.
+  /// \param[in,out] _graph Graph to update. Its root poses must have been
+  /// cached by cachePoseRelativeToRoot.
+  /// \param[in] _vertexName Name of the vertex to update.
+  /// \param[in] _relativeTo Name of the new relative-to vertex. It is the
+  /// vertex the edge starts from, so default values such as an empty
+  /// relative_to must already be replaced by the frame they refer to.
+  /// \param[in] _rawPose Raw pose of the vertex relative to _relativeTo.
+  /// \return Errors.
+  Errors updatePoseRelativeTo(
+      PoseRelativeToGraph &_graph,
+      const std::string &_vertexName,
+      const std::string &_relativeTo,
+      const ignition::math::Pose3d &_rawPose);
+
+  /// \brief Change the attached-to frame of an explicit frame of a valid
+  /// FrameAttachedToGraph in place. Only the frame and the frames attached
+  /// to it are visited to check that the new attached-to frame doesn't
+  /// cause a cycle. Since the rest of the graph is valid, the frame then
+  /// leads to a valid body. The graph is not changed if there are errors.
+  /// \param[in,out] _graph Graph to update.
+  /// \param[in] _vertexName Name of the frame to update.
+  /// \param[in] _attachedTo Name of the new attached-to vertex. An empty
+  /// attached_to must already be replaced by the scope name.
+  /// \return Errors.
+  Errors updateFrameAttachedTo(
+      FrameAttachedToGraph &_graph,
+      const std::string &_vertexName,
+      const std::string &_attachedTo);
+
   /// \brief Resolve the attached-to body for a given frame. Following the
   /// edges of the frame attached-to graph from a given frame must lead
   /// to a link or world frame.
@@ -178,6 +307,19 @@ namespace sdf
       const PoseRelativeToGraph &_graph,
       const std::string &_frameName,
       const std::string &_resolveTo);
+
+  /// \brief Resolve the pose of every frame of a graph relative to a named
+  /// frame in a single pass over the graph. The cached poses of the graph
+  /// are used if cachePoseRelativeToRoot was called.
+  /// \param[out] _poses Poses of the frames, indexed by VertexId.
+  /// \param[in] _graph PoseRelativeToGraph to read from.
+  /// \param[in] _resolveTo Name of frame relative to which the poses are
+  /// to be resolved.
+  /// \return Errors.
+  Errors resolveAllPoses(
+      std::vector<ignition::math::Pose3d> &_poses,
+      const PoseRelativeToGraph &_graph,
+      const std::string &_resolveTo);
   }
 }
 #endif
@@ -15,6 +15,7 @@
  *
  */
 
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -286,3 +287,255 @@ TEST(FrameSemantics, buildPoseRelativeToGraph)
         "PoseRelativeToGraph unable to find unique frame with name ["
         "invalid] in graph."));
 }
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, cachePoseRelativeToRoot)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  // Load the SDF file
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+
+  // Get the first model
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  sdf::PoseRelativeToGraph graph;
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(graph, model).empty());
+  EXPECT_TRUE(sdf::validatePoseRelativeToGraph(graph).empty());
+  EXPECT_TRUE(graph.rootPoses.empty());
+
+  // Resolve each frame by walking the graph.
+  std::map<std::string, ignition::math::Pose3d> expectedPoses;
+  for (auto const &namePair : graph.map)
+  {
+    ignition::math::Pose3d pose;
+    EXPECT_TRUE(
+        sdf::resolvePoseRelativeToRoot(pose, graph, namePair.first).empty());
+    expectedPoses[namePair.first] = pose;
+  }
+
+  sdf::cachePoseRelativeToRoot(graph);
+  EXPECT_EQ(8u, graph.rootPoses.size());
+
+  // The cached poses match the poses resolved by walking the graph.
+  for (auto const &namePair : graph.map)
+  {
+    EXPECT_EQ(expectedPoses[namePair.first],
+              graph.rootPoses[namePair.second]) << namePair.first;
+    ignition::math::Pose3d pose;
+    EXPECT_TRUE(
+        sdf::resolvePoseRelativeToRoot(pose, graph, namePair.first).empty());
+    EXPECT_EQ(expectedPoses[namePair.first], pose) << namePair.first;
+  }
+
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePose(pose, graph, "F4", "F3").empty());
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 4, 0, -IGN_PI/2, 0), pose);
+
+  // Unknown frames are still reported.
+  EXPECT_EQ(1u, sdf::resolvePose(pose, graph, "invalid", "P").size());
+
+  // Rebuilding the graph clears the cache.
+  sdf::PoseRelativeToGraph rebuilt;
+  rebuilt.rootPoses.resize(3);
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(rebuilt, model).empty());
+  EXPECT_TRUE(rebuilt.rootPoses.empty());
+
+  // A vertex that can't be reached from the source leaves the cache empty.
+  const std::string disconnected = "disconnected";
+  rebuilt.map[disconnected] = rebuilt.graph.AddVertex(
+      disconnected, sdf::FrameType::FRAME).Id();
+  sdf::cachePoseRelativeToRoot(rebuilt);
+  EXPECT_TRUE(rebuilt.rootPoses.empty());
+  EXPECT_FALSE(
+      sdf::resolvePoseRelativeToRoot(pose, rebuilt, disconnected).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, buildFrameTree)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  // Load the SDF file
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+
+  // Get the first model
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  sdf::PoseRelativeToGraph poseGraph;
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(poseGraph, model).empty());
+  const auto poseTree = sdf::buildFrameTree(poseGraph);
+  ASSERT_EQ(8u, poseTree.name.size());
+
+  // The parent of each vertex is its relative-to frame.
+  auto modelId = poseGraph.map.at("__model__");
+  auto pId = poseGraph.map.at("P");
+  auto f1Id = poseGraph.map.at("F1");
+  EXPECT_EQ("__model__", *poseTree.name[modelId]);
+  EXPECT_EQ(ignition::math::graph::kNullId, poseTree.parent[modelId]);
+  EXPECT_EQ(0u, poseTree.parentEdgeCount[modelId]);
+  EXPECT_EQ(sdf::FrameType::MODEL, poseTree.type[modelId]);
+  EXPECT_EQ(modelId, poseTree.parent[pId]);
+  EXPECT_EQ(1u, poseTree.parentEdgeCount[pId]);
+  EXPECT_EQ(sdf::FrameType::LINK, poseTree.type[pId]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0), poseTree.edge[pId]);
+  EXPECT_EQ(pId, poseTree.parent[f1Id]);
+  EXPECT_EQ(sdf::FrameType::FRAME, poseTree.type[f1Id]);
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), poseTree.edge[f1Id]);
+
+  sdf::FrameAttachedToGraph attachedGraph;
+  EXPECT_TRUE(
+      sdf::buildFrameAttachedToGraph(attachedGraph, model).empty());
+  const auto attachedTree = sdf::buildFrameTree(attachedGraph);
+  ASSERT_EQ(attachedGraph.graph.Vertices().size(), attachedTree.name.size());
+
+  // The parent of each vertex is its attached-to frame, and links have no
+  // parent. Joints are attached to their child link, frames without
+  // attached_to to the model frame, and the model frame to its canonical
+  // link.
+  auto jId = attachedGraph.map.at("J");
+  auto cId = attachedGraph.map.at("C");
+  auto f3Id = attachedGraph.map.at("F3");
+  auto attachedModelId = attachedGraph.map.at("__model__");
+  EXPECT_EQ(cId, attachedTree.parent[jId]);
+  EXPECT_EQ(attachedModelId, attachedTree.parent[f3Id]);
+  EXPECT_EQ(attachedGraph.map.at("P"), attachedTree.parent[attachedModelId]);
+  EXPECT_EQ(1u, attachedTree.parentEdgeCount[f3Id]);
+  EXPECT_EQ(0u, attachedTree.parentEdgeCount[cId]);
+  EXPECT_EQ(ignition::math::graph::kNullId, attachedTree.parent[cId]);
+  EXPECT_EQ(sdf::FrameType::JOINT, attachedTree.type[jId]);
+
+  // An empty graph gives an empty tree.
+  sdf::PoseRelativeToGraph emptyGraph;
+  EXPECT_TRUE(sdf::buildFrameTree(emptyGraph).name.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, updatePoseRelativeTo)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  // Load the SDF file
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+
+  // Get the first model
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  sdf::PoseRelativeToGraph graph;
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(graph, model).empty());
+  EXPECT_TRUE(sdf::validatePoseRelativeToGraph(graph).empty());
+
+  // The root poses must be cached first.
+  const ignition::math::Pose3d newPose(0, 1, 0, 0, 0, 0);
+  sdf::Errors errors = sdf::updatePoseRelativeTo(graph, "F3", "J", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+  sdf::cachePoseRelativeToRoot(graph);
+
+  // The updated poses match the poses computed from the whole graph.
+  auto expectCachedPoses = [&graph]()
+  {
+    sdf::PoseRelativeToGraph copy = graph;
+    sdf::cachePoseRelativeToRoot(copy);
+    ASSERT_EQ(copy.rootPoses.size(), graph.rootPoses.size());
+    for (auto const &namePair : graph.map)
+    {
+      EXPECT_EQ(copy.rootPoses[namePair.second],
+                graph.rootPoses[namePair.second]) << namePair.first;
+    }
+  };
+
+  // Change the raw pose of F3, which F4 is relative to.
+  const auto oldF4Pose = graph.rootPoses[graph.map.at("F4")];
+  EXPECT_TRUE(sdf::updatePoseRelativeTo(graph, "F3", "J", newPose).empty());
+  expectCachedPoses();
+  EXPECT_NE(oldF4Pose, graph.rootPoses[graph.map.at("F4")]);
+
+  // Pose F3 relative to P instead.
+  EXPECT_TRUE(sdf::updatePoseRelativeTo(graph, "F3", "P", newPose).empty());
+  expectCachedPoses();
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0),
+            graph.rootPoses[graph.map.at("F3")]);
+  EXPECT_TRUE(sdf::validatePoseRelativeToGraph(graph).empty());
+
+  // Cycles, unknown frames and the source frame are errors, and leave the
+  // graph unchanged.
+  const auto rootPoses = graph.rootPoses;
+  errors = sdf::updatePoseRelativeTo(graph, "F3", "F4", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  errors = sdf::updatePoseRelativeTo(graph, "C", "F2", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  errors = sdf::updatePoseRelativeTo(graph, "F3", "F3", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  errors = sdf::updatePoseRelativeTo(graph, "F3", "invalid", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  errors = sdf::updatePoseRelativeTo(graph, "invalid", "P", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  errors = sdf::updatePoseRelativeTo(graph, "__model__", "P", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  EXPECT_EQ(rootPoses, graph.rootPoses);
+  EXPECT_TRUE(sdf::validatePoseRelativeToGraph(graph).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, updateFrameAttachedTo)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  // Load the SDF file
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+
+  // Get the first model
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  sdf::FrameAttachedToGraph graph;
+  EXPECT_TRUE(sdf::buildFrameAttachedToGraph(graph, model).empty());
+  EXPECT_TRUE(sdf::validateFrameAttachedToGraph(graph).empty());
+
+  // The frames are attached to the model frame, and so to link P.
+  std::string body;
+  EXPECT_TRUE(sdf::resolveFrameAttachedToBody(body, graph, "F4").empty());
+  EXPECT_EQ("P", body);
+
+  // Attach F4 to F3 and F3 to J, whose child link is C.
+  EXPECT_TRUE(sdf::updateFrameAttachedTo(graph, "F4", "F3").empty());
+  EXPECT_TRUE(sdf::updateFrameAttachedTo(graph, "F3", "J").empty());
+  EXPECT_TRUE(sdf::validateFrameAttachedToGraph(graph).empty());
+  EXPECT_TRUE(sdf::resolveFrameAttachedToBody(body, graph, "F4").empty());
+  EXPECT_EQ("C", body);
+
+  // Cycles, unknown frames and implicit frames are errors.
+  sdf::Errors errors = sdf::updateFrameAttachedTo(graph, "F3", "F4");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_CYCLE, errors[0].Code());
+  errors = sdf::updateFrameAttachedTo(graph, "F3", "F3");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_CYCLE, errors[0].Code());
+  errors = sdf::updateFrameAttachedTo(graph, "F3", "invalid");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_INVALID, errors[0].Code());
+  errors = sdf::updateFrameAttachedTo(graph, "J", "P");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_INVALID, errors[0].Code());
+  EXPECT_TRUE(sdf::validateFrameAttachedToGraph(graph).empty());
+  EXPECT_TRUE(sdf::resolveFrameAttachedToBody(body, graph, "F4").empty());
+  EXPECT_EQ("C", body);
+}
@@ -15,6 +15,7 @@
  *
 */
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <ignition/math/Inertial.hh>
@@ -22,6 +23,7 @@
 #include <ignition/math/Vector3.hh>
 
 #include "sdf/Collision.hh"
+#include "sdf/Console.hh"
 #include "sdf/Error.hh"
 #include "sdf/Light.hh"
 #include "sdf/Link.hh"
@@ -68,8 +70,92 @@ class sdf::LinkPrivate
 
   /// \brief Weak pointer to model's Pose Relative-To Graph.
   public: std::weak_ptr<const sdf::PoseRelativeToGraph> poseRelativeToGraph;
+
+  /// \brief Flag of the deferred loading of the contents of the link, or
+  /// nullptr if they were loaded by Load. A link is only copied after its
+  /// contents are loaded, so copies may share the flag.
+  public: std::shared_ptr<std::once_flag> deferredLoad;
+
+  /// \brief Errors found while loading the deferred contents.
+  public: Errors deferredErrors;
 };
 
+/////////////////////////////////////////////////
+/// \brief Load the visuals, collisions, lights, sensors and inertial of a
+/// link, which are loaded on first access when lazy loading is enabled.
+/// \param[in,out] _data Private data of the link, with its element set.
+/// \return Errors found while loading.
+static Errors loadContents(LinkPrivate &_data)
+{
+  Errors errors;
+  const ElementPtr &sdf = _data.sdf;
+
+  // Load all the visuals.
+  Errors visLoadErrors = loadUniqueRepeated<Visual>(sdf, "visual",
+      _data.visuals);
+  errors.insert(errors.end(), visLoadErrors.begin(), visLoadErrors.end());
+
+  // Load all the collisions.
+  Errors collLoadErrors = loadUniqueRepeated<Collision>(sdf, "collision",
+      _data.collisions);
+  errors.insert(errors.end(), collLoadErrors.begin(), collLoadErrors.end());
+
+  // Load all the lights.
+  Errors lightLoadErrors = loadUniqueRepeated<Light>(sdf, "light",
+      _data.lights);
+  errors.insert(errors.end(), lightLoadErrors.begin(), lightLoadErrors.end());
+
+  // Load all the sensors.
+  Errors sensorLoadErrors = loadUniqueRepeated<Sensor>(sdf, "sensor",
+      _data.sensors);
+  errors.insert(errors.end(), sensorLoadErrors.begin(), sensorLoadErrors.end());
+
+  ignition::math::Vector3d xxyyzz = ignition::math::Vector3d::One;
+  ignition::math::Vector3d xyxzyz = ignition::math::Vector3d::Zero;
+  ignition::math::Pose3d inertiaPose;
+  std::string inertiaFrame = "";
+  double mass = 1.0;
+
+  if (sdf->HasElement("inertial"))
+  {
+    sdf::ElementPtr inertialElem = sdf->GetElement("inertial");
+
+    if (inertialElem->HasElement("pose"))
+      loadPose(inertialElem->GetElement("pose"), inertiaPose, inertiaFrame);
+
+    // Get the mass.
+    mass = inertialElem->Get<double>("mass", 1.0).first;
+
+    if (inertialElem->HasElement("inertia"))
+    {
+      sdf::ElementPtr inertiaElem = inertialElem->GetElement("inertia");
+
+      xxyyzz.X(inertiaElem->Get<double>("ixx", 1.0).first);
+      xxyyzz.Y(inertiaElem->Get<double>("iyy", 1.0).first);
+      xxyyzz.Z(inertiaElem->Get<double>("izz", 1.0).first);
+
+      xyxzyz.X(inertiaElem->Get<double>("ixy", 0.0).first);
+      xyxzyz.Y(inertiaElem->Get<double>("ixz", 0.0).first);
+      xyxzyz.Z(inertiaElem->Get<double>("iyz", 0.0).first);
+    }
+  }
+  if (!_data.inertial.SetMassMatrix(
+      ignition::math::MassMatrix3d(mass, xxyyzz, xyxzyz)))
+  {
+    errors.push_back({ErrorCode::LINK_INERTIA_INVALID,
+                     "A link named " +
+                     _data.name +
+                     " has invalid inertia."});
+  }
+
+  /// \todo: Handle inertia frame properly
+  _data.inertial.SetPose(inertiaPose);
+
+  _data.enableWind = sdf->Get<bool>("enable_wind", _data.enableWind).first;
+
+  return errors;
+}
+
 /////////////////////////////////////////////////
 Link::Link()
   : dataPtr(new LinkPrivate)
@@ -85,8 +171,11 @@ Link::~Link()
 
 /////////////////////////////////////////////////
 Link::Link(const Link &_link)
-  : dataPtr(new LinkPrivate(*_link.dataPtr))
 {
+  // Copies don't share the deferred loading, so the contents are loaded
+  // before they are copied.
+  _link.LoadDeferred();
+  this->dataPtr = new LinkPrivate(*_link.dataPtr);
 }
 
 /////////////////////////////////////////////////
@@ -143,70 +232,18 @@ Errors Link::Load(ElementPtr _sdf)
   // Load the pose. Ignore the return value since the pose is optional.
   loadPose(_sdf, this->dataPtr->pose, this->dataPtr->poseRelativeTo);
 
-  // Load all the visuals.
-  Errors visLoadErrors = loadUniqueRepeated<Visual>(_sdf, "visual",
-      this->dataPtr->visuals);
-  errors.insert(errors.end(), visLoadErrors.begin(), visLoadErrors.end());
-
-  // Load all the collisions.
-  Errors collLoadErrors = loadUniqueRepeated<Collision>(_sdf, "collision",
-      this->dataPtr->collisions);
-  errors.insert(errors.end(), collLoadErrors.begin(), collLoadErrors.end());
-
-  // Load all the lights.
-  Errors lightLoadErrors = loadUniqueRepeated<Light>(_sdf, "light",
-      this->dataPtr->lights);
-  errors.insert(errors.end(), lightLoadErrors.begin(), lightLoadErrors.end());
-
-  // Load all the sensors.
-  Errors sensorLoadErrors = loadUniqueRepeated<Sensor>(_sdf, "sensor",
-      this->dataPtr->sensors);
-  errors.insert(errors.end(), sensorLoadErrors.begin(), sensorLoadErrors.end());
-
-  ignition::math::Vector3d xxyyzz = ignition::math::Vector3d::One;
-  ignition::math::Vector3d xyxzyz = ignition::math::Vector3d::Zero;
-  ignition::math::Pose3d inertiaPose;
-  std::string inertiaFrame = "";
-  double mass = 1.0;
-
-  if (_sdf->HasElement("inertial"))
+  // The contents of the link are not needed to build the graphs of the
+  // model, so they can be loaded when they are first accessed.
+  if (lazyLoading())
   {
-    sdf::ElementPtr inertialElem = _sdf->GetElement("inertial");
-
-    if (inertialElem->HasElement("pose"))
-      loadPose(inertialElem->GetElement("pose"), inertiaPose, inertiaFrame);
-
-    // Get the mass.
-    mass = inertialElem->Get<double>("mass", 1.0).first;
-
-    if (inertialElem->HasElement("inertia"))
-    {
-      sdf::ElementPtr inertiaElem = inertialElem->GetElement("inertia");
-
-      xxyyzz.X(inertiaElem->Get<double>("ixx", 1.0).first);
-      xxyyzz.Y(inertiaElem->Get<double>("iyy", 1.0).first);
-      xxyyzz.Z(inertiaElem->Get<double>("izz", 1.0).first);
-
-      xyxzyz.X(inertiaElem->Get<double>("ixy", 0.0).first);
-      xyxzyz.Y(inertiaElem->Get<double>("ixz", 0.0).first);
-      xyxzyz.Z(inertiaElem->Get<double>("iyz", 0.0).first);
-    }
+    this->dataPtr->deferredLoad = std::make_shared<std::once_flag>();
   }
-  if (!this->dataPtr->inertial.SetMassMatrix(
-      ignition::math::MassMatrix3d(mass, xxyyzz, xyxzyz)))
+  else
   {
-    errors.push_back({ErrorCode::LINK_INERTIA_INVALID,
-                     "A link named " +
-                     this->Name() +
-                     " has invalid inertia."});
+    Errors contentErrors = loadContents(*this->dataPtr);
+    errors.insert(errors.end(), contentErrors.begin(), contentErrors.end());
   }
 
-  /// \todo: Handle inertia frame properly
-  this->dataPtr->inertial.SetPose(inertiaPose);
-
-  this->dataPtr->enableWind = _sdf->Get<bool>("enable_wind",
-      this->dataPtr->enableWind).first;
-
   return errors;
 }
 
@@ -225,12 +262,14 @@ void Link::SetName(const std::string &_name) const
 /////////////////////////////////////////////////
 uint64_t Link::VisualCount() const
 {
+  this->LoadDeferred();
   return this->dataPtr->visuals.size();
 }
 
 /////////////////////////////////////////////////
 const Visual *Link::VisualByIndex(const uint64_t _index) const
 {
+  this->LoadDeferred();
   if (_index < this->dataPtr->visuals.size())
     return &this->dataPtr->visuals[_index];
   return nullptr;
@@ -239,6 +278,7 @@ const Visual *Link::VisualByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::VisualNameExists(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &v : this->dataPtr->visuals)
   {
     if (v.Name() == _name)
@@ -252,12 +292,14 @@ bool Link::VisualNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 uint64_t Link::CollisionCount() const
 {
+  this->LoadDeferred();
   return this->dataPtr->collisions.size();
 }
 
 /////////////////////////////////////////////////
 const Collision *Link::CollisionByIndex(const uint64_t _index) const
 {
+  this->LoadDeferred();
   if (_index < this->dataPtr->collisions.size())
     return &this->dataPtr->collisions[_index];
   return nullptr;
@@ -266,6 +308,7 @@ const Collision *Link::CollisionByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::CollisionNameExists(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &c : this->dataPtr->collisions)
   {
     if (c.Name() == _name)
@@ -279,12 +322,14 @@ bool Link::CollisionNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 uint64_t Link::LightCount() const
 {
+  this->LoadDeferred();
   return this->dataPtr->lights.size();
 }
 
 /////////////////////////////////////////////////
 const Light *Link::LightByIndex(const uint64_t _index) const
 {
+  this->LoadDeferred();
   if (_index < this->dataPtr->lights.size())
     return &this->dataPtr->lights[_index];
   return nullptr;
@@ -299,12 +344,14 @@ bool Link::LightNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 uint64_t Link::SensorCount() const
 {
+  this->LoadDeferred();
   return this->dataPtr->sensors.size();
 }
 
 /////////////////////////////////////////////////
 const Sensor *Link::SensorByIndex(const uint64_t _index) const
 {
+  this->LoadDeferred();
   if (_index < this->dataPtr->sensors.size())
     return &this->dataPtr->sensors[_index];
   return nullptr;
@@ -313,6 +360,7 @@ const Sensor *Link::SensorByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::SensorNameExists(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &s : this->dataPtr->sensors)
   {
     if (s.Name() == _name)
@@ -326,6 +374,7 @@ bool Link::SensorNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Sensor *Link::SensorByName(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &s : this->dataPtr->sensors)
   {
     if (s.Name() == _name)
@@ -339,12 +388,14 @@ const Sensor *Link::SensorByName(const std::string &_name) const
 /////////////////////////////////////////////////
 const ignition::math::Inertiald &Link::Inertial() const
 {
+  this->LoadDeferred();
   return this->dataPtr->inertial;
 }
 
 /////////////////////////////////////////////////
 bool Link::SetInertial(const ignition::math::Inertiald &_inertial)
 {
+  this->LoadDeferred();
   this->dataPtr->inertial = _inertial;
   return _inertial.MassMatrix().IsValid();
 }
@@ -403,29 +454,56 @@ void Link::SetPoseRelativeToGraph(
 {
   this->dataPtr->poseRelativeToGraph = _graph;
 
-  // Pass graph to child elements.
+  // Pass graph to child elements. Children loaded later get it when they
+  // are loaded.
+  this->SetChildPoseRelativeToGraph();
+}
+
+/////////////////////////////////////////////////
+void Link::SetChildPoseRelativeToGraph() const
+{
+  const auto &graph = this->dataPtr->poseRelativeToGraph;
   for (auto &collision : this->dataPtr->collisions)
   {
     collision.SetXmlParentName(this->dataPtr->name);
-    collision.SetPoseRelativeToGraph(_graph);
+    collision.SetPoseRelativeToGraph(graph);
   }
   for (auto &light : this->dataPtr->lights)
   {
     light.SetXmlParentName(this->dataPtr->name);
-    light.SetPoseRelativeToGraph(_graph);
+    light.SetPoseRelativeToGraph(graph);
   }
   for (auto &sensor : this->dataPtr->sensors)
   {
     sensor.SetXmlParentName(this->dataPtr->name);
-    sensor.SetPoseRelativeToGraph(_graph);
+    sensor.SetPoseRelativeToGraph(graph);
   }
   for (auto &visual : this->dataPtr->visuals)
   {
     visual.SetXmlParentName(this->dataPtr->name);
-    visual.SetPoseRelativeToGraph(_graph);
+    visual.SetPoseRelativeToGraph(graph);
   }
 }
 
+/////////////////////////////////////////////////
+void Link::LoadDeferred() const
+{
+  if (!this->dataPtr->deferredLoad)
+    return;
+
+  std::call_once(*this->dataPtr->deferredLoad, [this]()
+  {
+    LinkPrivate &data = *this->dataPtr;
+    data.deferredErrors = loadContents(data);
+    this->SetChildPoseRelativeToGraph();
+    for (const Error &error : data.deferredErrors)
+    {
+      sdferr << "Error loading link [" << data.name << "]: "
+             << error.Message() << "\n";
+    }
+  });
+}
+
 /////////////////////////////////////////////////
 sdf::SemanticPose Link::SemanticPose() const
 {
@@ -439,6 +517,7 @@ sdf::SemanticPose Link::SemanticPose() const
 /////////////////////////////////////////////////
 const Visual *Link::VisualByName(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &v : this->dataPtr->visuals)
   {
     if (v.Name() == _name)
@@ -452,6 +531,7 @@ const Visual *Link::VisualByName(const std::string &_name) const
 /////////////////////////////////////////////////
 const Collision *Link::CollisionByName(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &c : this->dataPtr->collisions)
   {
     if (c.Name() == _name)
@@ -465,6 +545,7 @@ const Collision *Link::CollisionByName(const std::string &_name) const
 /////////////////////////////////////////////////
 const Light *Link::LightByName(const std::string &_name) const
 {
+  this->LoadDeferred();
   for (auto const &c : this->dataPtr->lights)
   {
     if (c.Name() == _name)
@@ -484,11 +565,20 @@ sdf::ElementPtr Link::Element() const
 /////////////////////////////////////////////////
 bool Link::EnableWind() const
 {
+  this->LoadDeferred();
   return this->dataPtr->enableWind;
 }
 
 /////////////////////////////////////////////////
 void Link::SetEnableWind(const bool _enableWind)
 {
+  this->LoadDeferred();
   this->dataPtr->enableWind =_enableWind;
 }
+
+/////////////////////////////////////////////////
+Errors Link::ValidateAll() const
+{
+  this->LoadDeferred();
+  return this->dataPtr->deferredErrors;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#include "MappedFile.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string &_filename)
+{
+#ifndef _WIN32
+  const int fd = open(_filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) ||
+      fileStat.st_size <= 0)
+  {
+    close(fd);
+    return;
+  }
+  const size_t fileSize = static_cast<size_t>(fileStat.st_size);
+
+  // Reserve room for the file and at least one more byte, so the contents
+  // are always followed by a null character. The bytes of the last page of
+  // the file past its end are zero, and when the file ends on a page
+  // boundary, the next page is zero filled anonymous memory.
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t reservedSize = ((fileSize + pageSize) / pageSize) * pageSize;
+  void *reserved = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED)
+  {
+    close(fd);
+    return;
+  }
+
+  // Map the file privately over the start of the reserved memory, so pages
+  // are only copied if they are written to.
+  void *mapped = mmap(reserved, fileSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_FIXED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    munmap(reserved, reservedSize);
+    return;
+  }
+
+  this->data = static_cast<char *>(mapped);
+  this->size = fileSize;
+  this->mappedSize = reservedSize;
+#else
+  std::ifstream file(_filename, std::ios::in | std::ios::binary);
+  if (!file)
+    return;
+
+  this->buffer.assign(std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>());
+  if (this->buffer.empty())
+    return;
+
+  this->size = this->buffer.size();
+  this->buffer.push_back('\0');
+  this->data = this->buffer.data();
+#endif
+}
+
+/////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if (this->data)
+    munmap(this->data, this->mappedSize);
+#endif
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Valid() const
+{
+  return this->data != nullptr;
+}
+
+/////////////////////////////////////////////////
+char *MappedFile::Data() const
+{
+  return this->data;
+}
+
+/////////////////////////////////////////////////
+size_t MappedFile::Size() const
+{
+  return this->size;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_MAPPEDFILE_HH
+#define SDFORMAT_MAPPEDFILE_HH
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Private, writable view of the contents of a file. The file is
+  /// memory mapped where supported, so its contents are paged in from the
+  /// page cache instead of being copied to the heap. Changes to the contents
+  /// are never written back to the file.
+  class MappedFile
+  {
+    /// \brief Constructor. Maps the file.
+    /// \param[in] _filename Path of the file.
+    public: explicit MappedFile(const std::string &_filename);
+
+    /// \brief Destructor. Unmaps the file.
+    public: ~MappedFile();
+
+    /// \brief No copy constructor.
+    public: MappedFile(const MappedFile &) = delete;
+
+    /// \brief No assignment operator.
+    public: MappedFile &operator=(const MappedFile &) = delete;
+
+    /// \brief Get whether the file was mapped.
+    /// \return False if the file could not be opened, is empty or is not a
+    /// regular file.
+    public: bool Valid() const;
+
+    /// \brief Get the contents of the file. The contents are followed by a
+    /// null character, so they can be used as a C string.
+    /// \return The contents, or nullptr if the file was not mapped.
+    public: char *Data() const;
+
+    /// \brief Get the size of the file.
+    /// \return Size of the file in bytes, not counting the null character.
+    public: size_t Size() const;
+
+    /// \brief Start of the contents.
+    private: char *data = nullptr;
+
+    /// \brief Size of the file.
+    private: size_t size = 0;
+
+    /// \brief Size of the memory mapping, which is larger than the file.
+    private: size_t mappedSize = 0;
+
+    /// \brief Contents of the file, on platforms without memory mapping.
+    private: std::vector<char> buffer;
+  };
+  }
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "MappedFile.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _contents Contents of the file.
+void writeFile(const std::string &_path, const std::string &_contents)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  file << _contents;
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Contents)
+{
+  const std::string path =
+    std::string(PROJECT_BINARY_DIR) + "/mapped_file_test.txt";
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+  // Include sizes that end on a page boundary, where there is no room for
+  // the null character in the last page of the file.
+  for (size_t size : {size_t(1), size_t(100), pageSize - 1, pageSize,
+                      2 * pageSize})
+  {
+    const std::string contents(size, 'a');
+    writeFile(path, contents);
+
+    sdf::MappedFile file(path);
+    ASSERT_TRUE(file.Valid());
+    EXPECT_EQ(size, file.Size());
+    EXPECT_EQ(size, std::strlen(file.Data()));
+    EXPECT_EQ(contents, std::string(file.Data(), file.Size()));
+
+    // Writes are private to the mapping.
+    file.Data()[0] = 'b';
+    std::ifstream reread(path);
+    EXPECT_EQ('a', reread.get());
+  }
+
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Invalid)
+{
+  sdf::MappedFile missing(std::string(PROJECT_BINARY_DIR) + "/missing.txt");
+  EXPECT_FALSE(missing.Valid());
+  EXPECT_EQ(nullptr, missing.Data());
+  EXPECT_EQ(0u, missing.Size());
+
+  sdf::MappedFile directory(PROJECT_BINARY_DIR);
+  EXPECT_FALSE(directory.Valid());
+
+  const std::string path =
+    std::string(PROJECT_BINARY_DIR) + "/mapped_file_empty.txt";
+  writeFile(path, "");
+  sdf::MappedFile empty(path);
+  EXPECT_FALSE(empty.Valid());
+  std::remove(path.c_str());
+}
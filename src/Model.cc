@@ -20,12 +20,16 @@
 #include <vector>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/SemanticVersion.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Error.hh"
 #include "sdf/Frame.hh"
 #include "sdf/Joint.hh"
+#include "sdf/Light.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "FrameSemantics.hh"
 #include "Utils.hh"
 
@@ -73,9 +77,17 @@ class sdf::ModelPrivate
   /// \brief Frame Attached-To Graph constructed during Load.
   public: std::shared_ptr<sdf::FrameAttachedToGraph> frameAttachedToGraph;
 
+  /// \brief Errors found while building and validating the Frame
+  /// Attached-To Graph.
+  public: sdf::GraphErrors frameAttachedToGraphErrors;
+
   /// \brief Pose Relative-To Graph constructed during Load.
   public: std::shared_ptr<sdf::PoseRelativeToGraph> poseGraph;
 
+  /// \brief Errors found while building and validating the Pose
+  /// Relative-To Graph.
+  public: sdf::GraphErrors poseGraphErrors;
+
   /// \brief Pose Relative-To Graph in parent (world) scope.
   public: std::weak_ptr<const sdf::PoseRelativeToGraph> parentPoseGraph;
 };
@@ -328,6 +340,8 @@ Errors Model::Load(ElementPtr _sdf)
       validateFrameAttachedToGraph(*this->dataPtr->frameAttachedToGraph);
     errors.insert(errors.end(), validateFrameAttachedGraphErrors.begin(),
                                 validateFrameAttachedGraphErrors.end());
+    this->dataPtr->frameAttachedToGraphErrors =
+        {frameAttachedToGraphErrors, validateFrameAttachedGraphErrors};
     for (auto &frame : this->dataPtr->frames)
     {
       frame.SetFrameAttachedToGraph(this->dataPtr->frameAttachedToGraph);
@@ -344,6 +358,13 @@ Errors Model::Load(ElementPtr _sdf)
     validatePoseRelativeToGraph(*this->dataPtr->poseGraph);
   errors.insert(errors.end(), validatePoseGraphErrors.begin(),
                               validatePoseGraphErrors.end());
+  this->dataPtr->poseGraphErrors = {poseGraphErrors, validatePoseGraphErrors};
+  if (validatePoseGraphErrors.empty())
+  {
+    // Resolve every frame to the model frame once, so poses resolved later
+    // don't walk the graph.
+    cachePoseRelativeToRoot(*this->dataPtr->poseGraph);
+  }
   for (auto &link : this->dataPtr->links)
   {
     link.SetPoseRelativeToGraph(this->dataPtr->poseGraph);
@@ -617,6 +638,308 @@ sdf::SemanticPose Model::SemanticPose() const
       this->dataPtr->parentPoseGraph);
 }
 
+/////////////////////////////////////////////////
+/// \brief Resolve the poses of the visuals, collisions, sensors or lights
+/// of a link from the resolved poses of the frames of the model.
+/// \param[out] _out Poses of the objects, index-aligned with the link.
+/// \param[in] _link The link.
+/// \param[in] _count Link function that returns the number of objects.
+/// \param[in] _byIndex Link function that returns an object by index.
+/// \param[in] _graph Pose relative-to graph of the model.
+/// \param[in] _framePoses Resolved poses of the frames, indexed by
+/// VertexId.
+/// \param[out] _errors Errors are added to it.
+template<typename T>
+static void resolveLinkChildPoses(
+    std::vector<ignition::math::Pose3d> &_out,
+    const Link &_link,
+    uint64_t (Link::*_count)() const,
+    const T *(Link::*_byIndex)(const uint64_t) const,
+    const PoseRelativeToGraph &_graph,
+    const std::vector<ignition::math::Pose3d> &_framePoses,
+    Errors &_errors)
+{
+  const uint64_t count = (_link.*_count)();
+  _out.resize(count);
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    const T *obj = (_link.*_byIndex)(i);
+    const std::string &relativeTo = obj->PoseRelativeTo().empty() ?
+        _link.Name() : obj->PoseRelativeTo();
+    auto it = _graph.map.find(relativeTo);
+    if (it == _graph.map.end())
+    {
+      _errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+          "PoseRelativeToGraph unable to find unique frame with name [" +
+          relativeTo + "] in graph."});
+      continue;
+    }
+    _out[i] = _framePoses[it->second] * obj->RawPose();
+  }
+}
+
+/////////////////////////////////////////////////
+Errors Model::ResolveAllPoses(ModelPoses &_poses,
+                              const std::string &_resolveTo) const
+{
+  Errors errors;
+
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+  const PoseRelativeToGraph &graph = *this->dataPtr->poseGraph;
+
+  // The links, joints and frames are vertices of the graph, and the other
+  // objects are posed relative to one of them.
+  std::vector<ignition::math::Pose3d> framePoses;
+  errors = resolveAllPoses(framePoses, graph,
+      _resolveTo.empty() ? "__model__" : _resolveTo);
+  if (!errors.empty())
+    return errors;
+
+  auto vertexPose = [&](const std::string &_name)
+  {
+    auto it = graph.map.find(_name);
+    if (it == graph.map.end())
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+          "PoseRelativeToGraph unable to find unique frame with name [" +
+          _name + "] in graph."});
+      return ignition::math::Pose3d::Zero;
+    }
+    return framePoses[it->second];
+  };
+
+  ModelPoses poses;
+  const std::size_t linkCount = this->dataPtr->links.size();
+  poses.links.resize(linkCount);
+  poses.visuals.resize(linkCount);
+  poses.collisions.resize(linkCount);
+  poses.sensors.resize(linkCount);
+  poses.lights.resize(linkCount);
+  for (std::size_t l = 0; l < linkCount; ++l)
+  {
+    const Link &link = this->dataPtr->links[l];
+    poses.links[l] = vertexPose(link.Name());
+    resolveLinkChildPoses(poses.visuals[l], link, &Link::VisualCount,
+        &Link::VisualByIndex, graph, framePoses, errors);
+    resolveLinkChildPoses(poses.collisions[l], link, &Link::CollisionCount,
+        &Link::CollisionByIndex, graph, framePoses, errors);
+    resolveLinkChildPoses(poses.sensors[l], link, &Link::SensorCount,
+        &Link::SensorByIndex, graph, framePoses, errors);
+    resolveLinkChildPoses(poses.lights[l], link, &Link::LightCount,
+        &Link::LightByIndex, graph, framePoses, errors);
+  }
+
+  poses.joints.reserve(this->dataPtr->joints.size());
+  for (auto const &joint : this->dataPtr->joints)
+    poses.joints.push_back(vertexPose(joint.Name()));
+
+  poses.frames.reserve(this->dataPtr->frames.size());
+  for (auto const &frame : this->dataPtr->frames)
+    poses.frames.push_back(vertexPose(frame.Name()));
+
+  if (errors.empty())
+    _poses = std::move(poses);
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the vertex from which the edge to a link starts in the pose
+/// relative-to graph of its model.
+/// \param[in] _link The link.
+/// \param[in] _relativeTo Pose relative-to frame of the link.
+/// \return Name of the vertex.
+static std::string poseGraphParent(const Link &/*_link*/,
+    const std::string &_relativeTo)
+{
+  return _relativeTo.empty() ? "__model__" : _relativeTo;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the vertex from which the edge to a joint starts in the pose
+/// relative-to graph of its model.
+/// \param[in] _joint The joint.
+/// \param[in] _relativeTo Pose relative-to frame of the joint.
+/// \return Name of the vertex.
+static std::string poseGraphParent(const Joint &_joint,
+    const std::string &_relativeTo)
+{
+  return _relativeTo.empty() ? _joint.ChildLinkName() : _relativeTo;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the vertex from which the edge to a frame starts in the pose
+/// relative-to graph of its model.
+/// \param[in] _frame The frame.
+/// \param[in] _relativeTo Pose relative-to frame of the frame.
+/// \return Name of the vertex.
+static std::string poseGraphParent(const Frame &_frame,
+    const std::string &_relativeTo)
+{
+  if (!_relativeTo.empty())
+    return _relativeTo;
+  return _frame.AttachedTo().empty() ? "__model__" : _frame.AttachedTo();
+}
+
+/////////////////////////////////////////////////
+/// \brief Call a function with the link, joint or frame of a model that has
+/// a given name.
+/// \param[in] _data Private data of the model.
+/// \param[in] _name Name of the link, joint or frame.
+/// \param[in] _function Function that takes the object and returns Errors.
+/// \return Errors returned by the function, or an error if there is no
+/// such object.
+template<typename Function>
+static Errors updatePosedObject(ModelPrivate &_data,
+    const std::string &_name, Function _function)
+{
+  Errors errors;
+
+  if (!_data.poseGraph)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  for (auto &link : _data.links)
+  {
+    if (link.Name() == _name)
+      return _function(link);
+  }
+  for (auto &joint : _data.joints)
+  {
+    if (joint.Name() == _name)
+      return _function(joint);
+  }
+  for (auto &frame : _data.frames)
+  {
+    if (frame.Name() == _name)
+      return _function(frame);
+  }
+
+  errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+      "No link, joint or frame with name [" + _name + "] found in model "
+      "with name [" + _data.name + "]."});
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors Model::UpdateRawPose(const std::string &_name,
+                           const ignition::math::Pose3d &_pose)
+{
+  auto &graph = this->dataPtr->poseGraph;
+  return updatePosedObject(*this->dataPtr, _name, [&](auto &_obj)
+  {
+    Errors errors = updatePoseRelativeTo(*graph, _name,
+        poseGraphParent(_obj, _obj.PoseRelativeTo()), _pose);
+    if (errors.empty())
+      _obj.SetRawPose(_pose);
+    return errors;
+  });
+}
+
+/////////////////////////////////////////////////
+Errors Model::UpdatePoseRelativeTo(const std::string &_name,
+                                  const std::string &_relativeTo)
+{
+  auto &graph = this->dataPtr->poseGraph;
+  return updatePosedObject(*this->dataPtr, _name, [&](auto &_obj)
+  {
+    Errors errors = updatePoseRelativeTo(*graph, _name,
+        poseGraphParent(_obj, _relativeTo), _obj.RawPose());
+    if (errors.empty())
+      _obj.SetPoseRelativeTo(_relativeTo);
+    return errors;
+  });
+}
+
+/////////////////////////////////////////////////
+Errors Model::UpdateFrameAttachedTo(const std::string &_frameName,
+                                   const std::string &_attachedTo)
+{
+  Errors errors;
+
+  Frame *frame = nullptr;
+  for (auto &f : this->dataPtr->frames)
+  {
+    if (f.Name() == _frameName)
+    {
+      frame = &f;
+      break;
+    }
+  }
+  if (nullptr == frame)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "No frame with name [" + _frameName + "] found in model with name [" +
+        this->dataPtr->name + "]."});
+    return errors;
+  }
+  if (!this->dataPtr->poseGraph)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  const std::string oldAttachedTo =
+      frame->AttachedTo().empty() ? "__model__" : frame->AttachedTo();
+  const std::string newAttachedTo =
+      _attachedTo.empty() ? "__model__" : _attachedTo;
+
+  // Static models have no FrameAttachedToGraph.
+  auto &attachedToGraph = this->dataPtr->frameAttachedToGraph;
+  if (attachedToGraph)
+  {
+    const GraphErrors &graphErrors = this->dataPtr->frameAttachedToGraphErrors;
+    if (!graphErrors.build.empty() || !graphErrors.validate.empty())
+    {
+      errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+          "FrameAttachedToGraph of model with name [" + this->dataPtr->name +
+          "] has errors, so it can't be updated."});
+      return errors;
+    }
+    errors = updateFrameAttachedTo(*attachedToGraph, _frameName,
+        newAttachedTo);
+    if (!errors.empty())
+      return errors;
+  }
+
+  // Without a relative-to frame, the frame is posed relative to the frame
+  // it is attached to.
+  if (frame->PoseRelativeTo().empty())
+  {
+    errors = updatePoseRelativeTo(*this->dataPtr->poseGraph, _frameName,
+        newAttachedTo, frame->RawPose());
+    if (!errors.empty())
+    {
+      // Restore the attached-to frame, which was valid.
+      if (attachedToGraph)
+        updateFrameAttachedTo(*attachedToGraph, _frameName, oldAttachedTo);
+      return errors;
+    }
+  }
+  else if (!attachedToGraph && this->dataPtr->poseGraph->map.count(
+        newAttachedTo) != 1)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "attached_to name[" + newAttachedTo +
+        "] specified by frame with name[" + _frameName +
+        "] does not match a link, joint, or frame name "
+        "in model with name[" + this->dataPtr->name + "]."});
+    return errors;
+  }
+
+  frame->SetAttachedTo(_attachedTo);
+  return errors;
+}
+
 /////////////////////////////////////////////////
 const Link *Model::LinkByName(const std::string &_name) const
 {
@@ -635,3 +958,19 @@ sdf::ElementPtr Model::Element() const
 {
   return this->dataPtr->sdf;
 }
+
+/////////////////////////////////////////////////
+const GraphErrors *LoadedGraphErrors::FrameAttachedTo(const Model *_model)
+{
+  if (!_model->dataPtr->frameAttachedToGraph)
+    return nullptr;
+  return &_model->dataPtr->frameAttachedToGraphErrors;
+}
+
+/////////////////////////////////////////////////
+const GraphErrors *LoadedGraphErrors::PoseRelativeTo(const Model *_model)
+{
+  if (!_model->dataPtr->poseGraph)
+    return nullptr;
+  return &_model->dataPtr->poseGraphErrors;
+}
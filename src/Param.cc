@@ -16,17 +16,25 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <cstdint>
 #include <locale>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 
-#include <locale.h>
 #include <math.h>
 
 #include "sdf/Assert.hh"
 #include "sdf/Param.hh"
 #include "sdf/Types.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -55,22 +63,86 @@ namespace sdf
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Get a value of the type named by a param type name.
+/// \param[in] _typeName Type name, such as "double" or "pose".
+/// \return Value holding the ParamVariant alternative for the type, or
+/// nullptr if the type name is not known.
+static const ParamPrivate::ParamVariant *typeValueFromName(
+    const std::string &_typeName)
+{
+  using ParamVariant = ParamPrivate::ParamVariant;
+  static const std::unordered_map<std::string, ParamVariant> kTypeValues =
+  {
+    {"bool", ParamVariant(std::in_place_type<bool>)},
+    {"char", ParamVariant(std::in_place_type<char>)},
+    {"std::string", ParamVariant(std::in_place_type<std::string>)},
+    {"string", ParamVariant(std::in_place_type<std::string>)},
+    {"int", ParamVariant(std::in_place_type<int>)},
+    {"uint64_t", ParamVariant(std::in_place_type<std::uint64_t>)},
+    {"unsigned int", ParamVariant(std::in_place_type<unsigned int>)},
+    {"double", ParamVariant(std::in_place_type<double>)},
+    {"float", ParamVariant(std::in_place_type<float>)},
+    {"sdf::Time", ParamVariant(std::in_place_type<sdf::Time>)},
+    {"time", ParamVariant(std::in_place_type<sdf::Time>)},
+    {"ignition::math::Color",
+      ParamVariant(std::in_place_type<ignition::math::Color>)},
+    {"color", ParamVariant(std::in_place_type<ignition::math::Color>)},
+    {"ignition::math::Vector2i",
+      ParamVariant(std::in_place_type<ignition::math::Vector2i>)},
+    {"vector2i", ParamVariant(std::in_place_type<ignition::math::Vector2i>)},
+    {"ignition::math::Vector2d",
+      ParamVariant(std::in_place_type<ignition::math::Vector2d>)},
+    {"vector2d", ParamVariant(std::in_place_type<ignition::math::Vector2d>)},
+    {"ignition::math::Vector3d",
+      ParamVariant(std::in_place_type<ignition::math::Vector3d>)},
+    {"vector3", ParamVariant(std::in_place_type<ignition::math::Vector3d>)},
+    {"ignition::math::Pose3d",
+      ParamVariant(std::in_place_type<ignition::math::Pose3d>)},
+    {"pose", ParamVariant(std::in_place_type<ignition::math::Pose3d>)},
+    {"Pose", ParamVariant(std::in_place_type<ignition::math::Pose3d>)},
+    {"ignition::math::Quaterniond",
+      ParamVariant(std::in_place_type<ignition::math::Quaterniond>)},
+    {"quaternion",
+      ParamVariant(std::in_place_type<ignition::math::Quaterniond>)},
+  };
+
+  auto iter = kTypeValues.find(_typeName);
+  if (iter == kTypeValues.end())
+    return nullptr;
+  return &iter->second;
+}
+
 //////////////////////////////////////////////////
 Param::Param(const std::string &_key, const std::string &_typeName,
              const std::string &_default, bool _required,
              const std::string &_description)
   : dataPtr(new ParamPrivate)
 {
-  this->dataPtr->key = _key;
+  this->dataPtr->key = shareString(_key, this->dataPtr->ownedKey);
   this->dataPtr->required = _required;
-  this->dataPtr->typeName = _typeName;
+  this->dataPtr->typeName = internString(_typeName);
   this->dataPtr->description = _description;
   this->dataPtr->set = false;
 
+  const ParamPrivate::ParamVariant *typeValue = typeValueFromName(_typeName);
+  if (!typeValue)
+  {
+    sdferr << "Unknown parameter type[" << _typeName << "]\n";
+  }
+  SDF_ASSERT(typeValue != nullptr, "Invalid parameter");
+  this->dataPtr->value = *typeValue;
+
   SDF_ASSERT(this->ValueFromString(_default), "Invalid parameter");
   this->dataPtr->defaultValue = this->dataPtr->value;
 }
 
+//////////////////////////////////////////////////
+Param::Param()
+  : dataPtr(new ParamPrivate)
+{
+}
+
 //////////////////////////////////////////////////
 Param::~Param()
 {
@@ -248,37 +320,122 @@ void Param::Update()
     catch(...)
     {
       sdferr << "Unable to set value using Update for key["
-             << this->dataPtr->key << "]\n";
+             << *this->dataPtr->key << "]\n";
     }
   }
 }
 
 //////////////////////////////////////////////////
-std::string Param::GetAsString() const
+/// \brief Buffer large enough for any value formatted by formatNumber.
+using NumberBuffer = std::array<char, 32>;
+
+//////////////////////////////////////////////////
+/// \brief Format a numeric value the way StringStreamClassicLocale does,
+/// without allocating. Floating point values use 6 significant digits,
+/// like the default precision of a stream.
+/// \param[in] _value Value to format.
+/// \param[out] _buf Buffer to write the formatted value to.
+/// \return Number of characters written, or 0 if the value does not hold a
+/// number and must be streamed instead.
+static size_t formatNumber(const ParamPrivate::ParamVariant &_value,
+                           NumberBuffer &_buf)
 {
-  StringStreamClassicLocale ss;
+  return std::visit([&_buf](const auto &_v) -> size_t
+    {
+      using T = std::decay_t<decltype(_v)>;
+      char *first = _buf.data();
+      char *last = first + _buf.size();
+      std::to_chars_result result{first, std::errc()};
+      if constexpr (std::is_same_v<T, bool>)
+      {
+        *first = _v ? '1' : '0';
+        return 1;
+      }
+      else if constexpr (std::is_floating_point_v<T>)
+      {
+        result = std::to_chars(first, last, _v, std::chars_format::general,
+                               6);
+      }
+      else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, char>)
+      {
+        result = std::to_chars(first, last, _v);
+      }
+      else
+      {
+        return 0;
+      }
 
-  ss << ParamStreamer{ this->dataPtr->value };
-  return ss.str();
+      if (result.ec != std::errc())
+        return 0;
+      return static_cast<size_t>(result.ptr - first);
+    }, _value);
 }
 
 //////////////////////////////////////////////////
-std::string Param::GetDefaultAsString() const
+/// \brief Convert a value to a string.
+/// \param[in] _value Value to convert.
+/// \return The value as a string.
+static std::string valueAsString(const ParamPrivate::ParamVariant &_value)
 {
+  NumberBuffer buf;
+  const size_t size = formatNumber(_value, buf);
+  if (size > 0)
+    return std::string(buf.data(), size);
+
   StringStreamClassicLocale ss;
 
-  ss << ParamStreamer{ this->dataPtr->defaultValue };
+  ss << ParamStreamer{ _value };
   return ss.str();
 }
 
+//////////////////////////////////////////////////
+std::string Param::GetAsString() const
+{
+  return valueAsString(this->dataPtr->value);
+}
+
+//////////////////////////////////////////////////
+void Param::WriteValue(std::ostream &_out) const
+{
+  NumberBuffer buf;
+  const size_t size = formatNumber(this->dataPtr->value, buf);
+  if (size > 0)
+  {
+    _out.write(buf.data(), static_cast<std::streamsize>(size));
+    return;
+  }
+
+  if (auto str = std::get_if<std::string>(&this->dataPtr->value))
+  {
+    _out.write(str->data(), static_cast<std::streamsize>(str->size()));
+    return;
+  }
+
+  // Stream other types directly only if _out formats them the same way as
+  // GetAsString would.
+  const bool defaultFormat = _out.getloc() == std::locale::classic() &&
+    _out.flags() == (std::ios_base::skipws | std::ios_base::dec) &&
+    _out.precision() == 6 && _out.width() == 0;
+  if (defaultFormat)
+    _out << ParamStreamer{ this->dataPtr->value };
+  else
+    _out << this->GetAsString();
+}
+
+//////////////////////////////////////////////////
+std::string Param::GetDefaultAsString() const
+{
+  return valueAsString(this->dataPtr->defaultValue);
+}
+
 //////////////////////////////////////////////////
 bool Param::ValueFromString(const std::string &_value)
 {
   // Under some circumstances, latin locales (es_ES or pt_BR) will return a
   // comma for decimal position instead of a dot, making the conversion
-  // to fail. See bug #60 for more information. Force to use always C
-  setlocale(LC_NUMERIC, "C");
-
+  // to fail. See bug #60 for more information. All parsing below is done
+  // with std::from_chars, std::stoi/stoul or StringStreamClassicLocale, none
+  // of which depend on the global C locale, so it is never changed here.
   std::string tmp(_value);
   std::string lowerTmp = lowercase(_value);
 
@@ -297,151 +454,88 @@ bool Param::ValueFromString(const std::string &_value)
   try
   {
     // Try to use stoi and stoul for integers, and
-    // stof and stod for scalar floating point values.
+    // std::from_chars for scalar floating point values.
     int numericBase = 10;
     if (isHex)
     {
       numericBase = 16;
     }
 
-    if (this->dataPtr->typeName == "bool")
-    {
-      if (lowerTmp == "true" || lowerTmp == "1")
+    // The type of the value was chosen from the type name when the param
+    // was constructed, so parse directly into the alternative it holds.
+    return std::visit([&](auto &_val) -> bool
       {
-        this->dataPtr->value = true;
-      }
-      else if (lowerTmp == "false" || lowerTmp == "0")
-      {
-        this->dataPtr->value = false;
-      }
-      else
-      {
-        sdferr << "Invalid boolean value\n";
-        return false;
-      }
-    }
-    else if (this->dataPtr->typeName == "char")
-    {
-      this->dataPtr->value = tmp[0];
-    }
-    else if (this->dataPtr->typeName == "std::string" ||
-             this->dataPtr->typeName == "string")
-    {
-      this->dataPtr->value = tmp;
-    }
-    else if (this->dataPtr->typeName == "int")
-    {
-      this->dataPtr->value = std::stoi(tmp, nullptr, numericBase);
-    }
-    else if (this->dataPtr->typeName == "uint64_t")
-    {
-      StringStreamClassicLocale ss(tmp);
-      std::uint64_t u64tmp;
-
-      ss >> u64tmp;
-      this->dataPtr->value = u64tmp;
-    }
-    else if (this->dataPtr->typeName == "unsigned int")
-    {
-      this->dataPtr->value = static_cast<unsigned int>(
-          std::stoul(tmp, nullptr, numericBase));
-    }
-    else if (this->dataPtr->typeName == "double")
-    {
-      this->dataPtr->value = std::stod(tmp);
-    }
-    else if (this->dataPtr->typeName == "float")
-    {
-      this->dataPtr->value = std::stof(tmp);
-    }
-    else if (this->dataPtr->typeName == "sdf::Time" ||
-             this->dataPtr->typeName == "time")
-    {
-      StringStreamClassicLocale ss(tmp);
-      sdf::Time timetmp;
-
-      ss >> timetmp;
-      this->dataPtr->value = timetmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Color" ||
-             this->dataPtr->typeName == "color")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Color colortmp;
-
-      ss >> colortmp;
-      this->dataPtr->value = colortmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Vector2i" ||
-             this->dataPtr->typeName == "vector2i")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Vector2i vectmp;
-
-      ss >> vectmp;
-      this->dataPtr->value = vectmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Vector2d" ||
-             this->dataPtr->typeName == "vector2d")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Vector2d vectmp;
-
-      ss >> vectmp;
-      this->dataPtr->value = vectmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Vector3d" ||
-             this->dataPtr->typeName == "vector3")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Vector3d vectmp;
-
-      ss >> vectmp;
-      this->dataPtr->value = vectmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Pose3d" ||
-             this->dataPtr->typeName == "pose" ||
-             this->dataPtr->typeName == "Pose")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Pose3d posetmp;
-
-      ss >> posetmp;
-      this->dataPtr->value = posetmp;
-    }
-    else if (this->dataPtr->typeName == "ignition::math::Quaterniond" ||
-             this->dataPtr->typeName == "quaternion")
-    {
-      StringStreamClassicLocale ss(tmp);
-      ignition::math::Quaterniond quattmp;
-
-      ss >> quattmp;
-      this->dataPtr->value = quattmp;
-    }
-    else
-    {
-      sdferr << "Unknown parameter type[" << this->dataPtr->typeName << "]\n";
-      return false;
-    }
+        using T = std::decay_t<decltype(_val)>;
+        if constexpr (std::is_same_v<T, bool>)
+        {
+          if (lowerTmp == "true" || lowerTmp == "1")
+          {
+            _val = true;
+          }
+          else if (lowerTmp == "false" || lowerTmp == "0")
+          {
+            _val = false;
+          }
+          else
+          {
+            sdferr << "Invalid boolean value\n";
+            return false;
+          }
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+          _val = tmp[0];
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+          _val = tmp;
+        }
+        else if constexpr (std::is_same_v<T, int>)
+        {
+          _val = std::stoi(tmp, nullptr, numericBase);
+        }
+        else if constexpr (std::is_same_v<T, unsigned int>)
+        {
+          _val = static_cast<unsigned int>(
+              std::stoul(tmp, nullptr, numericBase));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+          _val = parseFloatingPoint<double>(tmp, isHex);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+          _val = parseFloatingPoint<float>(tmp, isHex);
+        }
+        else
+        {
+          StringStreamClassicLocale ss(tmp);
+          T parsed{};
+
+          ss >> parsed;
+          _val = parsed;
+        }
+        return true;
+      }, this->dataPtr->value);
   }
-  // Catch invalid argument exception from std::stoi/stoul/stod/stof
+  // Catch invalid argument exception from std::stoi/stoul and
+  // parseFloatingPoint
   catch(std::invalid_argument &)
   {
     sdferr << "Invalid argument. Unable to set value ["
            << _value << " ] for key["
-           << this->dataPtr->key << "].\n";
+           << *this->dataPtr->key << "].\n";
     return false;
   }
-  // Catch out of range exception from std::stoi/stoul/stod/stof
+  // Catch out of range exception from std::stoi/stoul and
+  // parseFloatingPoint
   catch(std::out_of_range &)
   {
     sdferr << "Out of range. Unable to set value ["
            << _value << " ] for key["
-           << this->dataPtr->key << "].\n";
+           << *this->dataPtr->key << "].\n";
     return false;
   }
-
-  return true;
 }
 
 //////////////////////////////////////////////////
@@ -480,17 +574,24 @@ void Param::Reset()
 //////////////////////////////////////////////////
 ParamPtr Param::Clone() const
 {
-  ParamPtr clone(new Param(this->dataPtr->key, this->dataPtr->typeName,
-                            this->GetAsString(), this->dataPtr->required,
-                            this->dataPtr->description));
+  // Copy the value directly rather than parsing its string form. As before,
+  // the current value becomes the default value of the clone.
+  ParamPtr clone(new Param());
+  clone->dataPtr->key = this->dataPtr->key;
+  clone->dataPtr->ownedKey = this->dataPtr->ownedKey;
+  clone->dataPtr->required = this->dataPtr->required;
   clone->dataPtr->set = this->dataPtr->set;
+  clone->dataPtr->typeName = this->dataPtr->typeName;
+  clone->dataPtr->description = this->dataPtr->description;
+  clone->dataPtr->value = this->dataPtr->value;
+  clone->dataPtr->defaultValue = this->dataPtr->value;
   return clone;
 }
 
 //////////////////////////////////////////////////
 const std::string &Param::GetTypeName() const
 {
-  return this->dataPtr->typeName;
+  return *this->dataPtr->typeName;
 }
 
 /////////////////////////////////////////////////
@@ -508,7 +609,7 @@ std::string Param::GetDescription() const
 /////////////////////////////////////////////////
 const std::string &Param::GetKey() const
 {
-  return this->dataPtr->key;
+  return *this->dataPtr->key;
 }
 
 /////////////////////////////////////////////////
@@ -16,7 +16,15 @@
  */
 
 #include <any>
+#include <atomic>
+#include <clocale>
 #include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -391,6 +399,189 @@ TEST(Param, SetTemplate)
   EXPECT_DOUBLE_EQ(value, 25.456);
 }
 
+////////////////////////////////////////////////////
+/// Values of the param's own type are stored without being formatted as a
+/// string, so they keep full precision.
+TEST(Param, SetTemplateKeepsPrecision)
+{
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  EXPECT_FALSE(doubleParam.GetSet());
+  EXPECT_TRUE(doubleParam.Set<double>(0.1234567891234));
+  EXPECT_TRUE(doubleParam.GetSet());
+  double value;
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(0.1234567891234, value);
+
+  sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false, "description");
+  const ignition::math::Pose3d pose(0.123456789, 2, 3, 0, 0, 0.987654321);
+  EXPECT_TRUE(poseParam.Set(pose));
+  ignition::math::Pose3d poseValue;
+  EXPECT_TRUE(poseParam.Get(poseValue));
+  EXPECT_EQ(pose, poseValue);
+
+  // Clones copy the value instead of parsing its string form.
+  sdf::ParamPtr clone = poseParam.Clone();
+  EXPECT_TRUE(clone->Get(poseValue));
+  EXPECT_EQ(pose, poseValue);
+  EXPECT_TRUE(clone->GetSet());
+  EXPECT_EQ("pose", clone->GetTypeName());
+  EXPECT_EQ("key", clone->GetKey());
+
+  // Values of another type are still converted through a string.
+  sdf::Param intParam("key", "int", "0", false, "description");
+  EXPECT_TRUE(intParam.Set(12.0));
+  int intValue;
+  EXPECT_TRUE(intParam.Get(intValue));
+  EXPECT_EQ(12, intValue);
+
+  // Strings are still trimmed.
+  sdf::Param stringParam("key", "string", "", false, "description");
+  EXPECT_TRUE(stringParam.Set(std::string("  name ")));
+  EXPECT_EQ("name", stringParam.GetAsString());
+}
+
+////////////////////////////////////////////////////
+/// Rotations set directly are normalized, as they are when set from a
+/// string.
+TEST(Param, SetTemplateNormalizesRotation)
+{
+  sdf::Param quatParam("key", "quaternion", "0 0 0", false, "description");
+  EXPECT_TRUE(quatParam.Set(ignition::math::Quaterniond(2, 0, 0, 0)));
+  ignition::math::Quaterniond quatValue;
+  EXPECT_TRUE(quatParam.Get(quatValue));
+  EXPECT_DOUBLE_EQ(1.0, quatValue.W());
+  EXPECT_DOUBLE_EQ(0.0, quatValue.X());
+
+  sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false, "description");
+  EXPECT_TRUE(poseParam.Set(ignition::math::Pose3d(
+      ignition::math::Vector3d(1, 2, 3),
+      ignition::math::Quaterniond(0, 0, 0, 3))));
+  ignition::math::Pose3d poseValue;
+  EXPECT_TRUE(poseParam.Get(poseValue));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3), poseValue.Pos());
+  EXPECT_DOUBLE_EQ(0.0, poseValue.Rot().W());
+  EXPECT_DOUBLE_EQ(1.0, poseValue.Rot().Z());
+}
+
+////////////////////////////////////////////////////
+/// Floating point values are parsed without changing the global C locale,
+/// in any of the formats accepted by std::stod.
+TEST(Param, ParseDoubleKeepsLocale)
+{
+  const std::string locale = setlocale(LC_NUMERIC, nullptr);
+
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  double value;
+  EXPECT_TRUE(doubleParam.SetFromString(" +2.5e3"));
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(2500.0, value);
+  EXPECT_TRUE(doubleParam.SetFromString("-0.125"));
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(-0.125, value);
+  EXPECT_TRUE(doubleParam.SetFromString("0x10"));
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(16.0, value);
+  EXPECT_FALSE(doubleParam.SetFromString("abc"));
+  EXPECT_FALSE(doubleParam.SetFromString("1e999"));
+
+  sdf::Param floatParam("key", "float", "0", false, "description");
+  float floatValue;
+  EXPECT_TRUE(floatParam.SetFromString("0.5"));
+  EXPECT_TRUE(floatParam.Get<float>(floatValue));
+  EXPECT_FLOAT_EQ(0.5f, floatValue);
+
+  EXPECT_EQ(locale, setlocale(LC_NUMERIC, nullptr));
+}
+
+////////////////////////////////////////////////////
+/// Params can be parsed on several threads at once.
+TEST(Param, ParseConcurrently)
+{
+  const int threadCount = 8;
+  const int iterations = 2000;
+  std::atomic<int> failures(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([t, &failures]()
+    {
+      sdf::Param doubleParam("key", "double", "0", false, "description");
+      sdf::Param intParam("key", "int", "0", false, "description");
+      sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false,
+                           "description");
+      for (int i = 0; i < iterations; ++i)
+      {
+        const double expected = t + i * 0.25;
+        double doubleValue;
+        int intValue;
+        ignition::math::Pose3d poseValue;
+        if (!doubleParam.SetFromString(std::to_string(expected)) ||
+            !doubleParam.Get<double>(doubleValue) ||
+            doubleValue != expected ||
+            !intParam.SetFromString(std::to_string(i)) ||
+            !intParam.Get<int>(intValue) || intValue != i ||
+            !poseParam.SetFromString("1.5 2 3 0 0 0.5") ||
+            !poseParam.Get<ignition::math::Pose3d>(poseValue) ||
+            poseValue != ignition::math::Pose3d(1.5, 2, 3, 0, 0, 0.5))
+        {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0, failures);
+}
+
+////////////////////////////////////////////////////
+/// WriteValue writes the same text as GetAsString, including for streams
+/// that don't use the default format.
+TEST(Param, WriteValue)
+{
+  const std::vector<std::pair<std::string, std::string>> values = {
+    {"double", "0.1"},
+    {"double", "1e-7"},
+    {"double", "123456789"},
+    {"float", "-2.5"},
+    {"int", "-42"},
+    {"unsigned int", "42"},
+    {"uint64_t", "18446744073709551615"},
+    {"bool", "true"},
+    {"char", "c"},
+    {"string", "some text"},
+    {"vector3", "0.1 2 -3.5"},
+    {"pose", "1 2 3 0 0 1.5"}};
+
+  std::vector<sdf::ParamPtr> params;
+  for (const auto &value : values)
+  {
+    params.push_back(std::make_shared<sdf::Param>(
+        "key", value.first, value.second, false));
+  }
+
+  EXPECT_EQ("0.1", params[0]->GetAsString());
+  EXPECT_EQ("1e-07", params[1]->GetAsString());
+  EXPECT_EQ("1.23457e+08", params[2]->GetAsString());
+  EXPECT_EQ("18446744073709551615", params[6]->GetAsString());
+  EXPECT_EQ("1", params[7]->GetAsString());
+
+  for (const auto &param : params)
+  {
+    std::ostringstream out;
+    param->WriteValue(out);
+    EXPECT_EQ(param->GetAsString(), out.str());
+
+    std::ostringstream formatted;
+    formatted.precision(2);
+    formatted.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    param->WriteValue(formatted);
+    EXPECT_EQ(param->GetAsString(), formatted.str());
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -20,6 +20,7 @@
 
 #include "sdf/Actor.hh"
 #include "sdf/Light.hh"
+#include "sdf/Link.hh"
 #include "sdf/Model.hh"
 #include "sdf/Root.hh"
 #include "sdf/Types.hh"
@@ -50,8 +51,24 @@ class sdf::RootPrivate
 
   /// \brief The SDF element pointer generated during load.
   public: sdf::ElementPtr sdf;
+
+  /// \brief True if the contents of links are loaded on first access.
+  public: bool lazyLoading = false;
 };
 
+/////////////////////////////////////////////////
+/// \brief Load the deferred contents of the links of a model.
+/// \param[in] _model The model.
+/// \param[out] _errors Errors found while loading are added to it.
+static void validateModel(const Model &_model, Errors &_errors)
+{
+  for (uint64_t l = 0; l < _model.LinkCount(); ++l)
+  {
+    Errors linkErrors = _model.LinkByIndex(l)->ValidateAll();
+    _errors.insert(_errors.end(), linkErrors.begin(), linkErrors.end());
+  }
+}
+
 /////////////////////////////////////////////////
 Root::Root()
   : dataPtr(new RootPrivate)
@@ -141,6 +158,9 @@ Errors Root::Load(SDFPtr _sdf)
 
   this->dataPtr->version = versionPair.first;
 
+  // Pass the lazy loading setting to the links loaded below.
+  LazyLoadingScope lazyLoadingScope(this->dataPtr->lazyLoading);
+
   // Read all the worlds
   if (this->dataPtr->sdf->HasElement("world"))
   {
@@ -206,6 +226,32 @@ void Root::SetVersion(const std::string &_version)
   this->dataPtr->version = _version;
 }
 
+/////////////////////////////////////////////////
+void Root::SetLazyLoading(const bool _lazy)
+{
+  this->dataPtr->lazyLoading = _lazy;
+}
+
+/////////////////////////////////////////////////
+bool Root::LazyLoading() const
+{
+  return this->dataPtr->lazyLoading;
+}
+
+/////////////////////////////////////////////////
+Errors Root::ValidateAll() const
+{
+  Errors errors;
+  for (const World &world : this->dataPtr->worlds)
+  {
+    for (uint64_t m = 0; m < world.ModelCount(); ++m)
+      validateModel(*world.ModelByIndex(m), errors);
+  }
+  for (const Model &model : this->dataPtr->models)
+    validateModel(model, errors);
+  return errors;
+}
+
 /////////////////////////////////////////////////
 uint64_t Root::WorldCount() const
 {
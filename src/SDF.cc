@@ -15,13 +15,19 @@
  *
  */
 
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <functional>
 #include <list>
+#include <locale>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 #include "sdf/parser.hh"
@@ -46,24 +52,198 @@ static URIPathMap g_uriPathMap;
 
 static std::function<std::string(const std::string &)> g_findFileCB;
 
+/// \brief Protects g_uriPathMap, g_findFileCB, g_findFileResults,
+/// g_uriPathIndex, g_findFileGeneration and g_findFileCacheScopes, so files
+/// can be found while parsing on several threads.
+static std::mutex g_findFileMutex;
+
+/// \brief Whether findFile caches its results in g_findFileResults.
+static std::atomic<bool> g_findFileCacheEnabled(false);
+
+/// \brief Whether findFile uses g_uriPathIndex.
+static std::atomic<bool> g_uriPathIndexEnabled(false);
+
+/// \brief Results of findFile, keyed by its arguments. An empty path is a
+/// file that was not found.
+static std::map<std::tuple<std::string, bool, bool>, std::string>
+  g_findFileResults;
+
+/// \brief Names of the entries of each path added by addURIPath.
+static std::map<std::string,
+  std::shared_ptr<const std::unordered_set<std::string>>> g_uriPathIndex;
+
+/// \brief Incremented each time g_findFileResults and g_uriPathIndex are
+/// cleared, so that results found before are not stored.
+static uint64_t g_findFileGeneration = 0;
+
+/// \brief Number of FindFileCacheScope objects on all threads.
+static uint64_t g_findFileCacheScopes = 0;
+
+/// \brief Number of FindFileCacheScope objects on this thread.
+static thread_local uint64_t t_findFileCacheScopes = 0;
+
+/// \brief Counters returned by findFileStats.
+static std::atomic<uint64_t> g_findFileHits(0);
+static std::atomic<uint64_t> g_findFileNegativeHits(0);
+static std::atomic<uint64_t> g_findFileMisses(0);
+static std::atomic<uint64_t> g_uriPathIndexSkips(0);
+
 std::string SDF::version = SDF_VERSION;
 
+/// \brief Protects SDF::version.
+static std::mutex g_versionMutex;
+
+/////////////////////////////////////////////////
+/// \brief Clear the results cached by findFile and the URI path index.
+/// g_findFileMutex must be locked by the caller.
+static void invalidateFindFileCache()
+{
+  g_findFileResults.clear();
+  g_uriPathIndex.clear();
+  ++g_findFileGeneration;
+}
+
 /////////////////////////////////////////////////
 // cppcheck-suppress passedByValue
 void setFindCallback(std::function<std::string(const std::string &)> _cb)
 {
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
   g_findFileCB = _cb;
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
-std::string findFile(const std::string &_filename, bool _searchLocalPath,
-                          bool _useCallback)
+void setFindFileCacheEnabled(const bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  g_findFileCacheEnabled = _enabled;
+  invalidateFindFileCache();
+}
+
+/////////////////////////////////////////////////
+bool findFileCacheEnabled()
+{
+  return g_findFileCacheEnabled;
+}
+
+/////////////////////////////////////////////////
+void setURIPathIndexEnabled(const bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  g_uriPathIndexEnabled = _enabled;
+  invalidateFindFileCache();
+}
+
+/////////////////////////////////////////////////
+bool uriPathIndexEnabled()
+{
+  return g_uriPathIndexEnabled;
+}
+
+/////////////////////////////////////////////////
+void clearFindFileCache()
+{
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  invalidateFindFileCache();
+}
+
+/////////////////////////////////////////////////
+FindFileStats findFileStats()
+{
+  FindFileStats stats;
+  stats.hits = g_findFileHits;
+  stats.negativeHits = g_findFileNegativeHits;
+  stats.misses = g_findFileMisses;
+  stats.indexSkips = g_uriPathIndexSkips;
+  return stats;
+}
+
+/////////////////////////////////////////////////
+void resetFindFileStats()
+{
+  g_findFileHits = 0;
+  g_findFileNegativeHits = 0;
+  g_findFileMisses = 0;
+  g_uriPathIndexSkips = 0;
+}
+
+/////////////////////////////////////////////////
+FindFileCacheScope::FindFileCacheScope()
+{
+  ++t_findFileCacheScopes;
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  ++g_findFileCacheScopes;
+}
+
+/////////////////////////////////////////////////
+FindFileCacheScope::~FindFileCacheScope()
+{
+  --t_findFileCacheScopes;
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  if (--g_findFileCacheScopes == 0 && !g_findFileCacheEnabled)
+    invalidateFindFileCache();
+}
+
+/////////////////////////////////////////////////
+bool findFileCacheScoped()
+{
+  return t_findFileCacheScopes > 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the names of the entries of a path added by addURIPath,
+/// listing them the first time the path is used.
+/// \param[in] _path The path.
+/// \return The names of the entries of the path.
+static std::shared_ptr<const std::unordered_set<std::string>> uriPathIndex(
+    const std::string &_path)
+{
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(g_findFileMutex);
+    auto iter = g_uriPathIndex.find(_path);
+    if (iter != g_uriPathIndex.end())
+      return iter->second;
+    generation = g_findFileGeneration;
+  }
+
+  auto entries = std::make_shared<std::unordered_set<std::string>>();
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(_path); dirIter != endIter;
+       ++dirIter)
+  {
+    entries->insert(sdf::filesystem::basename(*dirIter));
+  }
+
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  if (generation == g_findFileGeneration)
+    g_uriPathIndex.emplace(_path, entries);
+  return entries;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the absolute path of a file, without using the caches.
+/// \sa findFile
+static std::string findFileUncached(const std::string &_filename,
+                                    bool _searchLocalPath, bool _useCallback)
 {
   std::string path = _filename;
 
+  // Copy the registered paths and callback, so the lock is not held while
+  // searching the filesystem or running the callback.
+  URIPathMap uriPathMap;
+  std::function<std::string(const std::string &)> findFileCB;
+  {
+    std::lock_guard<std::mutex> lock(g_findFileMutex);
+    uriPathMap = g_uriPathMap;
+    if (_useCallback)
+      findFileCB = g_findFileCB;
+  }
+  const bool useIndex = g_uriPathIndexEnabled;
+
   // Check to see if _filename is URI. If so, resolve the URI path.
-  for (URIPathMap::iterator iter = g_uriPathMap.begin();
-       iter != g_uriPathMap.end(); ++iter)
+  for (URIPathMap::iterator iter = uriPathMap.begin();
+       iter != uriPathMap.end(); ++iter)
   {
     // Check to see if the URI in the global map is the first part of the
     // given filename
@@ -77,10 +257,33 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
         suffix.replace(index, iter->first.length(), "");
       }
 
+      // The first directory of the suffix, such as the model name of a
+      // model:// URI, which is looked up in the index of each path.
+      const size_t entryStart = suffix.find_first_not_of('/');
+      const size_t entryEnd = suffix.find('/', entryStart);
+      const std::string entry = entryStart == std::string::npos ?
+        std::string() : suffix.substr(entryStart, entryEnd - entryStart);
+
       // Check each path in the list.
       for (PathList::iterator pathIter = iter->second.begin();
            pathIter != iter->second.end(); ++pathIter)
       {
+        if (useIndex && !entry.empty())
+        {
+          auto pathIndex = uriPathIndex(*pathIter);
+          if (pathIndex->find(entry) == pathIndex->end())
+          {
+            ++g_uriPathIndexSkips;
+            continue;
+          }
+
+          // The index already shows that the entry exists.
+          if (suffix.find_first_not_of('/', entryEnd) == std::string::npos)
+          {
+            return sdf::filesystem::append(*pathIter, suffix);
+          }
+        }
+
         // Return the path string if the path + suffix exists.
         std::string pathSuffix = sdf::filesystem::append(*pathIter, suffix);
         if (sdf::filesystem::exists(pathSuffix))
@@ -160,7 +363,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   // flag has been set
   if (_useCallback)
   {
-    if (!g_findFileCB)
+    if (!findFileCB)
     {
       sdferr << "Tried to use callback in sdf::findFile(), but the callback "
         "is empty.  Did you call sdf::setFindCallback()?";
@@ -168,13 +371,53 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
     }
     else
     {
-      return g_findFileCB(_filename);
+      return findFileCB(_filename);
     }
   }
 
   return std::string();
 }
 
+/////////////////////////////////////////////////
+std::string findFile(const std::string &_filename, bool _searchLocalPath,
+                          bool _useCallback)
+{
+  const bool cacheEnabled = g_findFileCacheEnabled;
+  if (!cacheEnabled && !findFileCacheScoped())
+  {
+    return findFileUncached(_filename, _searchLocalPath, _useCallback);
+  }
+
+  const auto key = std::make_tuple(_filename, _searchLocalPath, _useCallback);
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(g_findFileMutex);
+    auto iter = g_findFileResults.find(key);
+    if (iter != g_findFileResults.end())
+    {
+      if (iter->second.empty())
+        ++g_findFileNegativeHits;
+      else
+        ++g_findFileHits;
+      return iter->second;
+    }
+    generation = g_findFileGeneration;
+  }
+
+  ++g_findFileMisses;
+  std::string path =
+    findFileUncached(_filename, _searchLocalPath, _useCallback);
+
+  // Don't store the result if the cache was cleared during the search,
+  // since it may be out of date. Files that are not found are only cached
+  // if the cache is enabled, so within a FindFileCacheScope the error is
+  // reported for each file that includes them.
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
+  if (generation == g_findFileGeneration && (cacheEnabled || !path.empty()))
+    g_findFileResults.emplace(key, path);
+  return path;
+}
+
 /////////////////////////////////////////////////
 void addURIPath(const std::string &_uri, const std::string &_path)
 {
@@ -182,6 +425,7 @@ void addURIPath(const std::string &_uri, const std::string &_path)
   std::vector<std::string> parts = sdf::split(_path, ":");
 
   // Add each part of the colon separated path to the global URI map.
+  std::lock_guard<std::mutex> lock(g_findFileMutex);
   for (std::vector<std::string>::iterator iter = parts.begin();
        iter != parts.end(); ++iter)
   {
@@ -191,6 +435,7 @@ void addURIPath(const std::string &_uri, const std::string &_path)
       g_uriPathMap[_uri].push_back(*iter);
     }
   }
+  invalidateFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -333,16 +578,21 @@ void SDF::PrintDoc()
 /////////////////////////////////////////////////
 void SDF::Write(const std::string &_filename)
 {
-  std::string string = this->Root()->ToString("");
-
-  std::ofstream out(_filename.c_str(), std::ios::out);
+  // Stream the elements to the file through a large buffer, instead of
+  // converting the whole document to a string first.
+  std::vector<char> buffer(1 << 16);
+  std::ofstream out;
+  out.rdbuf()->pubsetbuf(buffer.data(),
+                         static_cast<std::streamsize>(buffer.size()));
+  out.imbue(std::locale::classic());
+  out.open(_filename.c_str(), std::ios::out);
 
   if (!out)
   {
     sdferr << "Unable to open file[" << _filename << "] for writing\n";
     return;
   }
-  out << string;
+  this->Root()->PrintValues(out);
   out.close();
 }
 
@@ -350,6 +600,7 @@ void SDF::Write(const std::string &_filename)
 std::string SDF::ToString() const
 {
   std::ostringstream stream;
+  stream.imbue(std::locale::classic());
 
   stream << "<?xml version='1.0'?>\n";
   if (this->Root()->GetName() != "sdf")
@@ -357,7 +608,7 @@ std::string SDF::ToString() const
     stream << "<sdf version='" << SDF::Version() << "'>\n";
   }
 
-  stream << this->Root()->ToString("");
+  this->Root()->PrintValues(stream);
 
   if (this->Root()->GetName() != "sdf")
   {
@@ -426,12 +677,14 @@ const std::string &SDF::OriginalVersion() const
 /////////////////////////////////////////////////
 std::string SDF::Version()
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   return version;
 }
 
 /////////////////////////////////////////////////
 void SDF::Version(const std::string &_version)
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   version = _version;
 }
 
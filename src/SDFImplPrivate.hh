@@ -47,6 +47,33 @@ namespace sdf
     /// \brief Spec version that this was originally parsed from.
     public: std::string originalVersion;
   };
+
+  /// \brief While an object of this class exists, findFile on the current
+  /// thread caches the paths it finds, even if the cache is not enabled by
+  /// setFindFileCacheEnabled. The threads of a BatchLoader use it so that
+  /// each file included by several models is only searched for once. When
+  /// the last scope on any thread ends, the cache is cleared unless it is
+  /// enabled.
+  class FindFileCacheScope
+  {
+    /// \brief Constructor.
+    public: FindFileCacheScope();
+
+    /// \brief Destructor.
+    public: ~FindFileCacheScope();
+
+    /// \brief No copy constructor.
+    public: FindFileCacheScope(const FindFileCacheScope &) = delete;
+
+    /// \brief No assignment operator.
+    public: FindFileCacheScope &operator=(const FindFileCacheScope &) =
+                delete;
+  };
+
+  /// \brief Get whether a FindFileCacheScope exists on the current thread.
+  /// \return True if findFile on this thread caches the paths it finds
+  /// because of a FindFileCacheScope.
+  bool findFileCacheScoped();
   /// \}
 }
 }
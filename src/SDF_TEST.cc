@@ -710,6 +710,84 @@ TEST(SDF, WriteURIPath)
   ASSERT_EQ(std::remove(tempFile.c_str()), 0);
   ASSERT_EQ(rmdir(tempDir.c_str()), 0);
 }
+
+/////////////////////////////////////////////////
+TEST(SDF, FindFileCache)
+{
+  std::string tempDir;
+  ASSERT_TRUE(create_new_temp_dir(tempDir));
+  const std::string tempFile = tempDir + "/cached.sdf";
+
+  sdf::setFindFileCacheEnabled(true);
+  EXPECT_TRUE(sdf::findFileCacheEnabled());
+  sdf::addURIPath("cache://", tempDir);
+  sdf::resetFindFileStats();
+
+  // The file doesn't exist yet, and the failure is cached.
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), "");
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), "");
+  sdf::FindFileStats stats = sdf::findFileStats();
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(1u, stats.negativeHits);
+  EXPECT_EQ(0u, stats.hits);
+
+  // Creating the file isn't noticed until the cache is cleared.
+  sdf::SDF sdf;
+  sdf.Write(tempFile);
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), "");
+
+  sdf::clearFindFileCache();
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), tempFile);
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), tempFile);
+  stats = sdf::findFileStats();
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(1u, stats.hits);
+
+  // Adding a URI path clears the cache.
+  sdf::addURIPath("other_cache://", tempDir);
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), tempFile);
+  EXPECT_EQ(3u, sdf::findFileStats().misses);
+
+  sdf::setFindFileCacheEnabled(false);
+  EXPECT_FALSE(sdf::findFileCacheEnabled());
+
+  // Lookups are not counted while the cache is disabled.
+  sdf::resetFindFileStats();
+  EXPECT_EQ(sdf::findFile("cache://cached.sdf", false), tempFile);
+  stats = sdf::findFileStats();
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(0u, stats.hits);
+
+  ASSERT_EQ(std::remove(tempFile.c_str()), 0);
+  ASSERT_EQ(rmdir(tempDir.c_str()), 0);
+}
+
+/////////////////////////////////////////////////
+TEST(SDF, URIPathIndex)
+{
+  std::string tempDir;
+  ASSERT_TRUE(create_new_temp_dir(tempDir));
+  const std::string tempFile = tempDir + "/indexed.sdf";
+  sdf::SDF sdf;
+  sdf.Write(tempFile);
+
+  sdf::setURIPathIndexEnabled(true);
+  EXPECT_TRUE(sdf::uriPathIndexEnabled());
+  sdf::addURIPath("index://", tempDir);
+  sdf::resetFindFileStats();
+
+  EXPECT_EQ(sdf::findFile("index://indexed.sdf", false), tempFile);
+  EXPECT_EQ(0u, sdf::findFileStats().indexSkips);
+
+  EXPECT_EQ(sdf::findFile("index://missing/model.sdf", false), "");
+  EXPECT_EQ(1u, sdf::findFileStats().indexSkips);
+
+  sdf::setURIPathIndexEnabled(false);
+  EXPECT_FALSE(sdf::uriPathIndexEnabled());
+
+  ASSERT_EQ(std::remove(tempFile.c_str()), 0);
+  ASSERT_EQ(rmdir(tempDir.c_str()), 0);
+}
 #endif  // _WIN32
 
 /////////////////////////////////////////////////
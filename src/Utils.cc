@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include "Utils.hh"
 
@@ -32,6 +36,61 @@ bool isReservedName(const std::string &_name)
        _name.compare(size-2, 2, "__") == 0);
 }
 
+/////////////////////////////////////////////////
+/// \brief Pool of interned strings and the mutex that guards it.
+struct StringPool
+{
+  std::shared_mutex mutex;
+  std::unordered_set<std::string> strings;
+};
+
+/////////////////////////////////////////////////
+static StringPool &stringPool()
+{
+  // The pool is never destroyed, so interned strings stay valid for
+  // elements that are destroyed during static destruction.
+  static auto *pool = new StringPool;
+  return *pool;
+}
+
+/////////////////////////////////////////////////
+const std::string *internString(const std::string &_str)
+{
+  const std::string *interned = findInternedString(_str);
+  if (interned)
+  {
+    return interned;
+  }
+
+  StringPool &pool = stringPool();
+  std::unique_lock<std::shared_mutex> lock(pool.mutex);
+  return &(*pool.strings.insert(_str).first);
+}
+
+/////////////////////////////////////////////////
+const std::string *findInternedString(const std::string &_str)
+{
+  StringPool &pool = stringPool();
+  std::shared_lock<std::shared_mutex> lock(pool.mutex);
+  auto iter = pool.strings.find(_str);
+  return iter != pool.strings.end() ? &(*iter) : nullptr;
+}
+
+/////////////////////////////////////////////////
+const std::string *shareString(const std::string &_str,
+    std::shared_ptr<const std::string> &_owned)
+{
+  const std::string *interned = findInternedString(_str);
+  if (interned)
+  {
+    _owned.reset();
+    return interned;
+  }
+
+  _owned = std::make_shared<const std::string>(_str);
+  return _owned.get();
+}
+
 /////////////////////////////////////////////////
 bool loadName(sdf::ElementPtr _sdf, std::string &_name)
 {
@@ -74,5 +133,27 @@ bool loadPose(sdf::ElementPtr _sdf, ignition::math::Pose3d &_pose,
   // on the pose element value.
   return posePair.second;
 }
+
+/// \brief Lazy loading setting of the current thread.
+static thread_local bool g_lazyLoading = false;
+
+/////////////////////////////////////////////////
+bool lazyLoading()
+{
+  return g_lazyLoading;
+}
+
+/////////////////////////////////////////////////
+LazyLoadingScope::LazyLoadingScope(const bool _lazy)
+  : previous(g_lazyLoading)
+{
+  g_lazyLoading = _lazy;
+}
+
+/////////////////////////////////////////////////
+LazyLoadingScope::~LazyLoadingScope()
+{
+  g_lazyLoading = this->previous;
+}
 }
 }
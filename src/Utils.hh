@@ -18,7 +18,12 @@
 #define SDFORMAT_UTILS_HH
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include "sdf/Error.hh"
 #include "sdf/Element.hh"
@@ -37,6 +42,30 @@ namespace sdf
   /// \returns True if the name is a reserved name and thus invalid.
   bool isReservedName(const std::string &_name);
 
+  /// \brief Get the interned copy of a string. Interned strings live until
+  /// the process exits, so the returned pointer may be stored in place of
+  /// the string, and two interned strings are equal exactly when their
+  /// pointers are equal.
+  /// \param[in] _str String to intern.
+  /// \return Pointer to the interned string, never null.
+  const std::string *internString(const std::string &_str);
+
+  /// \brief Find the interned copy of a string without interning it.
+  /// \param[in] _str String to find.
+  /// \return Pointer to the interned string, or null if it is not interned.
+  const std::string *findInternedString(const std::string &_str);
+
+  /// \brief Get a string that can be stored by pointer. This is the
+  /// interned copy if there is one, which is the case for names that come
+  /// from the spec. Other strings, such as user element names, are copied
+  /// into _owned so that they are freed along with their owner instead of
+  /// growing the pool.
+  /// \param[in] _str String to share.
+  /// \param[out] _owned Owner of the copy, or null if _str is interned.
+  /// \return Pointer to the string, which stays valid while _owned does.
+  const std::string *shareString(const std::string &_str,
+      std::shared_ptr<const std::string> &_owned);
+
   /// \brief Read the "name" attribute from an element.
   /// \param[in] _sdf SDF element pointer which contains the name.
   /// \param[out] _name String to hold the name value.
@@ -55,6 +84,64 @@ namespace sdf
   bool loadPose(sdf::ElementPtr _sdf, ignition::math::Pose3d &_pose,
                 std::string &_frame);
 
+  /// \brief Parse a floating point value independently of the C locale.
+  /// Unlike std::stod, std::from_chars always uses '.' as the decimal
+  /// separator and does not allocate.
+  /// \param[in] _str String to parse. Leading whitespace, a leading '+' and
+  /// trailing characters are accepted, as they are by std::stod.
+  /// \param[in] _isHex True if the string starts with "0x".
+  /// \return The parsed value.
+  /// \throws std::invalid_argument if no value could be parsed.
+  /// \throws std::out_of_range if the value does not fit in T.
+  template<typename T>
+  T parseFloatingPoint(const std::string &_str, const bool _isHex = false)
+  {
+    const char *first = _str.c_str();
+    const char *last = first + _str.size();
+    while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+      ++first;
+    if (last - first > 1 && first[0] == '+' && first[1] != '-')
+      ++first;
+
+    std::chars_format format = std::chars_format::general;
+    if (_isHex && last - first > 2)
+    {
+      first += 2;
+      format = std::chars_format::hex;
+    }
+
+    T value{};
+    std::from_chars_result result =
+      std::from_chars(first, last, value, format);
+    if (result.ec == std::errc::invalid_argument)
+      throw std::invalid_argument(_str);
+    if (result.ec == std::errc::result_out_of_range)
+      throw std::out_of_range(_str);
+    return value;
+  }
+
+  /// \brief Get whether DOM objects loaded on the current thread defer the
+  /// loading of their contents until they are accessed.
+  /// \return True if lazy loading is enabled on the current thread.
+  /// \sa LazyLoadingScope
+  bool lazyLoading();
+
+  /// \brief Enables or disables lazy loading on the current thread while it
+  /// exists. Root::Load uses it to pass its setting down to the objects it
+  /// loads, without changing the Load functions of those objects.
+  class LazyLoadingScope
+  {
+    /// \brief Constructor.
+    /// \param[in] _lazy True to enable lazy loading.
+    public: explicit LazyLoadingScope(const bool _lazy);
+
+    /// \brief Destructor. Restores the previous setting.
+    public: ~LazyLoadingScope();
+
+    /// \brief The setting before this scope.
+    private: bool previous;
+  };
+
   /// \brief Load all objects of a specific sdf element type. No error
   /// is returned if an element is not present. This function assumes that
   /// an element has a "name" attribute that must be unique.
@@ -71,7 +158,7 @@ namespace sdf
   {
     Errors errors;
 
-    std::vector<std::string> names;
+    std::unordered_set<std::string> names;
 
     // Check that an element exists.
     if (_sdf->HasElement(_sdfName))
@@ -94,7 +181,7 @@ namespace sdf
           sdf::loadName(elem, name);
 
           // Check that the name does not exist.
-          if (std::find(names.begin(), names.end(), name) != names.end())
+          if (names.find(name) != names.end())
           {
             errors.push_back({ErrorCode::DUPLICATE_NAME,
                 _sdfName + " with name[" + name + "] already exists."});
@@ -103,7 +190,7 @@ namespace sdf
           {
             // Add the object to the result if no errors have been encountered.
             _objs.push_back(std::move(obj));
-            names.push_back(name);
+            names.insert(name);
           }
 
           // Add the load errors to the master error list.
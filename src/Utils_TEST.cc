@@ -122,3 +122,46 @@ TEST(DOMUtils, ReservedNames)
   EXPECT_TRUE(sdf::isReservedName("__world__"));
   EXPECT_TRUE(sdf::isReservedName("__anything__"));
 }
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, InternString)
+{
+  const std::string *link = sdf::internString("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ("link", *link);
+  EXPECT_EQ(link, sdf::internString(std::string("li") + "nk"));
+  EXPECT_NE(link, sdf::internString("model"));
+  EXPECT_EQ("", *sdf::internString(""));
+  EXPECT_EQ(link, sdf::findInternedString("link"));
+  EXPECT_EQ(nullptr, sdf::findInternedString("not_interned_name"));
+
+  // Interned names of elements and keys of params are shared.
+  sdf::ElementPtr elem1 = std::make_shared<sdf::Element>();
+  sdf::ElementPtr elem2 = std::make_shared<sdf::Element>();
+  elem1->SetName("link");
+  elem2->SetName(std::string("link"));
+  EXPECT_EQ(&elem1->GetName(), &elem2->GetName());
+
+  sdf::Param param1("link", "string", "", false);
+  sdf::Param param2(std::string("link"), "string", "", false);
+  EXPECT_EQ(&param1.GetKey(), &param2.GetKey());
+  EXPECT_EQ(&param1.GetTypeName(), &param2.GetTypeName());
+
+  // Other names and keys are owned by their element or param, and are
+  // shared only with clones.
+  elem1->SetName("user_element_name");
+  elem1->AddAttribute("user:attribute", "string", "", false);
+  EXPECT_EQ(nullptr, sdf::findInternedString("user_element_name"));
+  EXPECT_EQ(nullptr, sdf::findInternedString("user:attribute"));
+
+  sdf::ElementPtr clone = elem1->Clone();
+  EXPECT_EQ("user_element_name", clone->GetName());
+  EXPECT_EQ(&elem1->GetName(), &clone->GetName());
+  EXPECT_EQ(&elem1->GetAttribute("user:attribute")->GetKey(),
+            &clone->GetAttribute("user:attribute")->GetKey());
+
+  elem2->SetName("user_element_name");
+  EXPECT_NE(&elem1->GetName(), &elem2->GetName());
+  elem1.reset();
+  EXPECT_EQ("user_element_name", clone->GetName());
+}
@@ -91,8 +91,16 @@ class sdf::WorldPrivate
   /// \brief Frame Attached-To Graph constructed during Load.
   public: std::shared_ptr<sdf::FrameAttachedToGraph> frameAttachedToGraph;
 
+  /// \brief Errors found while building and validating the Frame
+  /// Attached-To Graph.
+  public: sdf::GraphErrors frameAttachedToGraphErrors;
+
   /// \brief Pose Relative-To Graph constructed during Load.
   public: std::shared_ptr<sdf::PoseRelativeToGraph> poseRelativeToGraph;
+
+  /// \brief Errors found while building and validating the Pose
+  /// Relative-To Graph.
+  public: sdf::GraphErrors poseRelativeToGraphErrors;
 };
 
 /////////////////////////////////////////////////
@@ -107,7 +115,9 @@ WorldPrivate::WorldPrivate(const WorldPrivate &_worldPrivate)
       name(_worldPrivate.name),
       physics(_worldPrivate.physics),
       sdf(_worldPrivate.sdf),
-      windLinearVelocity(_worldPrivate.windLinearVelocity)
+      windLinearVelocity(_worldPrivate.windLinearVelocity),
+      frameAttachedToGraphErrors(_worldPrivate.frameAttachedToGraphErrors),
+      poseRelativeToGraphErrors(_worldPrivate.poseRelativeToGraphErrors)
 {
   if (_worldPrivate.atmosphere)
   {
@@ -352,6 +362,8 @@ Errors World::Load(sdf::ElementPtr _sdf)
     validateFrameAttachedToGraph(*this->dataPtr->frameAttachedToGraph);
   errors.insert(errors.end(), validateFrameAttachedGraphErrors.begin(),
                               validateFrameAttachedGraphErrors.end());
+  this->dataPtr->frameAttachedToGraphErrors =
+      {frameAttachedToGraphErrors, validateFrameAttachedGraphErrors};
   for (auto &frame : this->dataPtr->frames)
   {
     frame.SetFrameAttachedToGraph(this->dataPtr->frameAttachedToGraph);
@@ -366,6 +378,14 @@ Errors World::Load(sdf::ElementPtr _sdf)
     validatePoseRelativeToGraph(*this->dataPtr->poseRelativeToGraph);
   errors.insert(errors.end(), validatePoseGraphErrors.begin(),
                               validatePoseGraphErrors.end());
+  this->dataPtr->poseRelativeToGraphErrors =
+      {poseRelativeToGraphErrors, validatePoseGraphErrors};
+  if (validatePoseGraphErrors.empty())
+  {
+    // Resolve every frame to the world frame once, so poses resolved later
+    // don't walk the graph.
+    cachePoseRelativeToRoot(*this->dataPtr->poseRelativeToGraph);
+  }
   for (auto &frame : this->dataPtr->frames)
   {
     frame.SetPoseRelativeToGraph(this->dataPtr->poseRelativeToGraph);
@@ -663,3 +683,101 @@ bool World::PhysicsNameExists(const std::string &_name) const
 
   return false;
 }
+
+/////////////////////////////////////////////////
+Errors World::ResolveAllPoses(WorldPoses &_poses,
+                              const std::string &_resolveTo) const
+{
+  Errors errors;
+
+  if (!this->dataPtr->poseRelativeToGraph)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "World has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+  const PoseRelativeToGraph &graph = *this->dataPtr->poseRelativeToGraph;
+
+  std::vector<ignition::math::Pose3d> framePoses;
+  errors = resolveAllPoses(framePoses, graph,
+      _resolveTo.empty() ? "world" : _resolveTo);
+  if (!errors.empty())
+    return errors;
+
+  auto framePose = [&](const std::string &_name)
+  {
+    auto it = graph.map.find(_name);
+    if (it == graph.map.end())
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+          "PoseRelativeToGraph unable to find unique frame with name [" +
+          _name + "] in graph."});
+      return ignition::math::Pose3d::Zero;
+    }
+    return framePoses[it->second];
+  };
+
+  WorldPoses poses;
+  poses.models.reserve(this->dataPtr->models.size());
+  poses.modelContents.resize(this->dataPtr->models.size());
+  for (std::size_t m = 0; m < this->dataPtr->models.size(); ++m)
+  {
+    const Model &model = this->dataPtr->models[m];
+    const ignition::math::Pose3d modelPose = framePose(model.Name());
+    poses.models.push_back(modelPose);
+
+    // Resolve the contents of the model in its own frame, then move them
+    // to the frame of the world that was asked for.
+    ModelPoses &contents = poses.modelContents[m];
+    Errors modelErrors = model.ResolveAllPoses(contents);
+    errors.insert(errors.end(), modelErrors.begin(), modelErrors.end());
+
+    auto transform = [&modelPose](std::vector<ignition::math::Pose3d> &_v)
+    {
+      for (auto &pose : _v)
+        pose = modelPose * pose;
+    };
+    transform(contents.links);
+    transform(contents.joints);
+    transform(contents.frames);
+    for (auto *perLink : {&contents.visuals, &contents.collisions,
+                          &contents.sensors, &contents.lights})
+    {
+      for (auto &v : *perLink)
+        transform(v);
+    }
+  }
+
+  poses.frames.reserve(this->dataPtr->frames.size());
+  for (auto const &frame : this->dataPtr->frames)
+    poses.frames.push_back(framePose(frame.Name()));
+
+  poses.lights.reserve(this->dataPtr->lights.size());
+  for (auto const &light : this->dataPtr->lights)
+  {
+    const std::string &relativeTo = light.PoseRelativeTo().empty() ?
+        graph.sourceName : light.PoseRelativeTo();
+    poses.lights.push_back(framePose(relativeTo) * light.RawPose());
+  }
+
+  if (errors.empty())
+    _poses = std::move(poses);
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+const GraphErrors *LoadedGraphErrors::FrameAttachedTo(const World *_world)
+{
+  if (!_world->dataPtr->frameAttachedToGraph)
+    return nullptr;
+  return &_world->dataPtr->frameAttachedToGraphErrors;
+}
+
+/////////////////////////////////////////////////
+const GraphErrors *LoadedGraphErrors::PoseRelativeTo(const World *_world)
+{
+  if (!_world->dataPtr->poseRelativeToGraph)
+    return nullptr;
+  return &_world->dataPtr->poseRelativeToGraphErrors;
+}
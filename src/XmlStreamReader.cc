@@ -0,0 +1,518 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "XmlStreamReader.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+/// \brief Get whether a character is white space, as TinyXML defines it.
+/// \param[in] _c The character.
+/// \return True if _c is white space.
+static bool isWhiteSpace(const char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r' ||
+         _c == '\v' || _c == '\f';
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a string starts with a prefix.
+/// \param[in] _p The string.
+/// \param[in] _prefix The prefix.
+/// \return True if _p starts with _prefix.
+static bool startsWith(const char *_p, const char *_prefix)
+{
+  return std::strncmp(_p, _prefix, std::strlen(_prefix)) == 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a string starts with a prefix, ignoring the case of
+/// ASCII letters.
+/// \param[in] _p The string.
+/// \param[in] _prefix The prefix, in lower case.
+/// \return True if _p starts with _prefix.
+static bool startsWithNoCase(const char *_p, const char *_prefix)
+{
+  for (; *_prefix; ++_p, ++_prefix)
+  {
+    const char c = (*_p >= 'A' && *_p <= 'Z') ? *_p - 'A' + 'a' : *_p;
+    if (c != *_prefix)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Skip white space.
+/// \param[in,out] _p Position in the document.
+/// \return False if _p is at a UTF-8 byte order mark, or one of the
+/// noncharacters TinyXML skips as white space in UTF-8 documents.
+static bool skipWhiteSpace(const char *&_p)
+{
+  while (isWhiteSpace(*_p))
+    ++_p;
+
+  const unsigned char *u = reinterpret_cast<const unsigned char *>(_p);
+  return !(u[0] == 0xEF &&
+      ((u[1] == 0xBB && u[2] == 0xBF) ||
+       (u[1] == 0xBF && (u[2] == 0xBE || u[2] == 0xBF))));
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a character can start a name.
+/// \param[in] _c The character.
+/// \return True if _c is an ASCII letter or an underscore.
+static bool isNameStart(const char _c)
+{
+  return (_c >= 'a' && _c <= 'z') || (_c >= 'A' && _c <= 'Z') || _c == '_';
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an element or attribute name.
+/// \param[in,out] _p Position of the name in the document.
+/// \param[out] _name The name.
+/// \return False if there is no name, or it is not ASCII.
+static bool readName(const char *&_p, std::string &_name)
+{
+  if (!isNameStart(*_p))
+    return false;
+
+  const char *start = _p;
+  while (isNameStart(*_p) || (*_p >= '0' && *_p <= '9') || *_p == '-' ||
+         *_p == '.' || *_p == ':')
+  {
+    ++_p;
+  }
+
+  // TinyXML takes every byte past ASCII to be a letter.
+  if (static_cast<unsigned char>(*_p) >= 0x7F)
+    return false;
+
+  _name.assign(start, _p);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an entity or character reference.
+/// \param[in,out] _p Position of the '&' in the document.
+/// \param[out] _out String to append the character to.
+/// \return False if the reference is malformed or is not ASCII.
+static bool readEntity(const char *&_p, std::string &_out)
+{
+  if (_p[1] == '#')
+  {
+    const bool hex = _p[2] == 'x';
+    const char *digits = _p + (hex ? 3 : 2);
+    const char *end = std::strchr(digits, ';');
+    if (!end || end == digits)
+      return false;
+
+    unsigned long code = 0;
+    for (const char *d = digits; d < end; ++d)
+    {
+      unsigned long digit;
+      if (*d >= '0' && *d <= '9')
+        digit = static_cast<unsigned long>(*d - '0');
+      else if (hex && *d >= 'a' && *d <= 'f')
+        digit = static_cast<unsigned long>(*d - 'a' + 10);
+      else if (hex && *d >= 'A' && *d <= 'F')
+        digit = static_cast<unsigned long>(*d - 'A' + 10);
+      else
+        return false;
+
+      code = code * (hex ? 16 : 10) + digit;
+      // The encoding of other characters depends on the document encoding.
+      if (code >= 0x80)
+        return false;
+    }
+
+    if (code == 0)
+      return false;
+
+    _out += static_cast<char>(code);
+    _p = end + 1;
+    return true;
+  }
+
+  static const struct
+  {
+    const char *name;
+    char value;
+  } entities[] =
+  {
+    {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '\"'},
+    {"&apos;", '\''}
+  };
+
+  for (const auto &entity : entities)
+  {
+    if (startsWith(_p, entity.name))
+    {
+      _out += entity.value;
+      _p += std::strlen(entity.name);
+      return true;
+    }
+  }
+
+  // TinyXML drops the '&' of an unknown entity.
+  ++_p;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a character of text or of an attribute value.
+/// \param[in,out] _p Position of the character in the document.
+/// \param[out] _out String to append the character to.
+/// \return False if the character is not supported.
+static bool readChar(const char *&_p, std::string &_out)
+{
+  if (*_p == '&')
+    return readEntity(_p, _out);
+
+  // TinyXML reads a UTF-8 sequence as a whole in UTF-8 documents, so make
+  // sure it does not swallow any markup.
+  const unsigned char lead = static_cast<unsigned char>(*_p);
+  size_t length = 1;
+  if (lead >= 0xC2 && lead <= 0xDF)
+    length = 2;
+  else if (lead >= 0xE0 && lead <= 0xEF)
+    length = 3;
+  else if (lead >= 0xF0 && lead <= 0xF4)
+    length = 4;
+
+  for (size_t i = 1; i < length; ++i)
+  {
+    const unsigned char c = static_cast<unsigned char>(_p[i]);
+    if (c < 0x80 || c > 0xBF)
+      return false;
+  }
+
+  _out.append(_p, length);
+  _p += length;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the text of an element up to the next markup, condensing
+/// white space.
+/// \param[in,out] _p Position of the text in the document.
+/// \param[out] _text The text.
+/// \return False if the text is not followed by markup, or has a character
+/// that is not supported.
+static bool readText(const char *&_p, std::string &_text)
+{
+  _text.clear();
+  bool whiteSpace = false;
+  while (*_p != '<')
+  {
+    if (*_p == '\0')
+      return false;
+
+    if (isWhiteSpace(*_p))
+    {
+      whiteSpace = true;
+      ++_p;
+      continue;
+    }
+
+    if (whiteSpace)
+    {
+      _text += ' ';
+      whiteSpace = false;
+    }
+
+    if (!readChar(_p, _text))
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a quoted attribute value.
+/// \param[in,out] _p Position of the opening quote in the document.
+/// \param[out] _value The value.
+/// \return False if the value is not quoted, not closed, or has a
+/// character that is not supported.
+static bool readQuoted(const char *&_p, std::string &_value)
+{
+  // TinyXML also reads unquoted values, which is left to it.
+  const char quote = *_p;
+  if (quote != '\"' && quote != '\'')
+    return false;
+
+  ++_p;
+  _value.clear();
+  while (*_p != quote)
+  {
+    if (*_p == '\0' || !readChar(_p, _value))
+      return false;
+  }
+  ++_p;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an attribute.
+/// \param[in,out] _p Position of the attribute in the document.
+/// \param[out] _name Name of the attribute.
+/// \param[out] _value Value of the attribute.
+/// \return False if the attribute is malformed or not supported.
+static bool readAttribute(const char *&_p, std::string &_name,
+                          std::string &_value)
+{
+  if (!readName(_p, _name) || !skipWhiteSpace(_p) || *_p != '=')
+    return false;
+  ++_p;
+  return skipWhiteSpace(_p) && readQuoted(_p, _value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the XML declaration.
+/// \param[in,out] _p Position of the declaration in the document.
+/// \param[out] _value The markup between the angle brackets.
+/// \return False if the declaration is malformed or not supported.
+static bool readDeclaration(const char *&_p, std::string &_value)
+{
+  const char *start = _p + 1;
+  std::string name;
+  std::string value;
+  _p += 5;
+  while (*_p != '>')
+  {
+    if (!skipWhiteSpace(_p))
+      return false;
+
+    if (*_p == '\0')
+      return false;
+
+    // TinyXML reads these as attributes, so their values may contain '>'.
+    if (startsWithNoCase(_p, "version") || startsWithNoCase(_p, "encoding") ||
+        startsWithNoCase(_p, "standalone"))
+    {
+      if (!readAttribute(_p, name, value))
+        return false;
+    }
+    else
+    {
+      while (*_p != '\0' && *_p != '>' && !isWhiteSpace(*_p))
+        ++_p;
+    }
+  }
+  _value.assign(start, _p);
+  ++_p;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a start tag, or an empty element.
+/// \param[in,out] _p Position of the '<' of the tag in the document.
+/// \param[out] _name Name of the element.
+/// \param[out] _attributes Attributes of the element.
+/// \param[out] _empty True if the element is empty.
+/// \return False if the tag is malformed or not supported.
+static bool readStartTag(const char *&_p, std::string &_name,
+                         XmlAttributes &_attributes, bool &_empty)
+{
+  ++_p;
+  if (!readName(_p, _name))
+    return false;
+
+  size_t count = 0;
+  while (true)
+  {
+    if (!skipWhiteSpace(_p))
+      return false;
+
+    if (*_p == '/')
+    {
+      _empty = true;
+      break;
+    }
+    else if (*_p == '>')
+    {
+      _empty = false;
+      break;
+    }
+
+    // Attribute strings are reused from tag to tag.
+    if (count == _attributes.size())
+      _attributes.emplace_back();
+    auto &attribute = _attributes[count];
+    if (!readAttribute(_p, attribute.first, attribute.second))
+      return false;
+
+    // TinyXML fails on repeated attributes.
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (_attributes[i].first == attribute.first)
+        return false;
+    }
+    ++count;
+  }
+  _attributes.resize(count);
+
+  if (_empty && *++_p != '>')
+    return false;
+  ++_p;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an end tag.
+/// \param[in,out] _p Position of the "</" of the tag in the document.
+/// \param[in] _name Name of the element the tag must end.
+/// \return False if the tag does not end the element, or is malformed.
+static bool readEndTag(const char *&_p, const std::string &_name)
+{
+  _p += 2;
+  if (std::strncmp(_p, _name.c_str(), _name.size()) != 0)
+    return false;
+  _p += _name.size();
+  if (!skipWhiteSpace(_p) || *_p != '>')
+    return false;
+  ++_p;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read markup that ends with a delimiter.
+/// \param[in,out] _p Position of the markup in the document.
+/// \param[in] _startLength Length of the start delimiter.
+/// \param[in] _end The end delimiter.
+/// \param[out] _value The markup between the delimiters.
+/// \return False if the end delimiter is missing.
+static bool readDelimited(const char *&_p, const size_t _startLength,
+                          const char *_end, std::string &_value)
+{
+  const char *start = _p + _startLength;
+  const char *end = std::strstr(start, _end);
+  if (!end)
+    return false;
+  _value.assign(start, end);
+  _p = end + std::strlen(_end);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool sdf::readXmlStream(const char *_data, XmlStreamHandler &_handler)
+{
+  if (!_data)
+    return false;
+
+  const char *p = _data;
+  if (startsWith(p, "\xEF\xBB\xBF"))
+    p += 3;
+
+  // Names of the open elements, for matching end tags.
+  std::vector<std::string> open;
+  size_t depth = 0;
+  bool rootRead = false;
+
+  std::string name;
+  std::string text;
+  XmlAttributes attributes;
+  while (true)
+  {
+    if (!skipWhiteSpace(p))
+      return false;
+
+    if (*p == '\0')
+      return depth == 0 && rootRead;
+
+    if (*p != '<')
+    {
+      // TinyXML ignores anything after the markup at the top level.
+      if (depth == 0)
+        return rootRead;
+
+      if (!readText(p, text))
+        return false;
+
+      // References can still leave a text of only white space, which
+      // TinyXML drops.
+      bool blank = true;
+      for (const char c : text)
+        blank = blank && isWhiteSpace(c);
+      if (!blank && !_handler.Text(text, false))
+        return false;
+    }
+    else if (p[1] == '/')
+    {
+      if (depth == 0 || !readEndTag(p, open[depth - 1]))
+        return false;
+      --depth;
+      if (!_handler.EndElement())
+        return false;
+    }
+    else if (startsWithNoCase(p, "<?xml"))
+    {
+      if (!readDeclaration(p, text) || !_handler.Unknown(text))
+        return false;
+    }
+    else if (startsWith(p, "<!--"))
+    {
+      if (!readDelimited(p, 4, "-->", text) || !_handler.Comment(text))
+        return false;
+    }
+    else if (startsWith(p, "<![CDATA["))
+    {
+      if (depth == 0 || !readDelimited(p, 9, "]]>", text) ||
+          !_handler.Text(text, true))
+      {
+        return false;
+      }
+    }
+    else if (isNameStart(p[1]))
+    {
+      bool empty = false;
+      if (!readStartTag(p, name, attributes, empty))
+        return false;
+
+      if (depth == 0)
+        rootRead = true;
+
+      if (!_handler.StartElement(name, attributes))
+        return false;
+
+      if (empty)
+      {
+        if (!_handler.EndElement())
+          return false;
+      }
+      else
+      {
+        if (open.size() == depth)
+          open.emplace_back();
+        open[depth++].swap(name);
+      }
+    }
+    else if (static_cast<unsigned char>(p[1]) >= 0x7F)
+    {
+      // TinyXML reads this as an element with a name that is not ASCII.
+      return false;
+    }
+    else
+    {
+      if (!readDelimited(p, 1, ">", text) || !_handler.Unknown(text))
+        return false;
+    }
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_XMLSTREAMREADER_HH
+#define SDFORMAT_XMLSTREAMREADER_HH
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Attributes of an XML element, as pairs of name and value in
+  /// document order.
+  using XmlAttributes = std::vector<std::pair<std::string, std::string>>;
+
+  /// \brief Receives the nodes of an XML document from readXmlStream, in
+  /// document order. Each function returns false to stop reading.
+  class XmlStreamHandler
+  {
+    /// \brief Destructor.
+    public: virtual ~XmlStreamHandler() = default;
+
+    /// \brief Called for the start tag of an element, or for an empty
+    /// element, which is followed by a call to EndElement.
+    /// \param[in] _name Name of the element.
+    /// \param[in] _attributes Attributes of the element.
+    /// \return False to stop reading.
+    public: virtual bool StartElement(const std::string &_name,
+                const XmlAttributes &_attributes) = 0;
+
+    /// \brief Called for the end tag of the last element started.
+    /// \return False to stop reading.
+    public: virtual bool EndElement() = 0;
+
+    /// \brief Called for the text and CDATA sections in an element.
+    /// \param[in] _text The text, with entities replaced and white space
+    /// condensed the way TinyXML does it, or the contents of the CDATA
+    /// section.
+    /// \param[in] _cdata True for a CDATA section.
+    /// \return False to stop reading.
+    public: virtual bool Text(const std::string &_text, const bool _cdata) = 0;
+
+    /// \brief Called for a comment.
+    /// \param[in] _value Contents of the comment.
+    /// \return False to stop reading.
+    public: virtual bool Comment(const std::string &_value) = 0;
+
+    /// \brief Called for the XML declaration, document type declarations,
+    /// and any other markup that TinyXML keeps as an unknown node.
+    /// \param[in] _value The markup between its angle brackets.
+    /// \return False to stop reading.
+    public: virtual bool Unknown(const std::string &_value) = 0;
+  };
+
+  /// \brief Read an XML document, and pass its nodes to a handler as they
+  /// are read, without building a node tree. The nodes are the ones
+  /// TiXmlDocument::Parse would build from the same data.
+  ///
+  /// Documents that TinyXML reads differently from a conforming parser,
+  /// such as those with unquoted attribute values or character references
+  /// outside of ASCII, are not supported, so that a caller can read them
+  /// with TinyXML instead.
+  /// \param[in] _data The document, as a null terminated string.
+  /// \param[in] _handler Handler of the nodes.
+  /// \return True if the whole document was read. False if it is not well
+  /// formed, is not supported, or the handler stopped reading.
+  bool readXmlStream(const char *_data, XmlStreamHandler &_handler);
+  }
+}
+#endif
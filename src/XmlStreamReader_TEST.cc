@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "XmlStreamReader.hh"
+
+/////////////////////////////////////////////////
+/// \brief Handler that records the nodes it receives as a string.
+class RecordingHandler : public sdf::XmlStreamHandler
+{
+  // Documentation inherited.
+  public: bool StartElement(const std::string &_name,
+              const sdf::XmlAttributes &_attributes) override
+  {
+    this->nodes += "<" + _name;
+    for (const auto &attribute : _attributes)
+      this->nodes += " " + attribute.first + "=[" + attribute.second + "]";
+    this->nodes += ">";
+    return ++this->count != this->stopAt;
+  }
+
+  // Documentation inherited.
+  public: bool EndElement() override
+  {
+    this->nodes += "</>";
+    return ++this->count != this->stopAt;
+  }
+
+  // Documentation inherited.
+  public: bool Text(const std::string &_text, const bool _cdata) override
+  {
+    this->nodes += (_cdata ? "C[" : "T[") + _text + "]";
+    return ++this->count != this->stopAt;
+  }
+
+  // Documentation inherited.
+  public: bool Comment(const std::string &_value) override
+  {
+    this->nodes += "#[" + _value + "]";
+    return ++this->count != this->stopAt;
+  }
+
+  // Documentation inherited.
+  public: bool Unknown(const std::string &_value) override
+  {
+    this->nodes += "?[" + _value + "]";
+    return ++this->count != this->stopAt;
+  }
+
+  /// \brief The nodes received.
+  public: std::string nodes;
+
+  /// \brief Number of nodes received.
+  public: int count = 0;
+
+  /// \brief Number of the node to stop reading at, or 0 to read them all.
+  public: int stopAt = 0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Read a document.
+/// \param[in] _data The document.
+/// \return The nodes read, or "error" if the document was not read.
+std::string read(const std::string &_data)
+{
+  RecordingHandler handler;
+  if (!sdf::readXmlStream(_data.c_str(), handler))
+    return "error";
+  return handler.nodes;
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Elements)
+{
+  EXPECT_EQ("<a></>", read("<a/>"));
+  EXPECT_EQ("<a></>", read("  <a></a >  "));
+  EXPECT_EQ("<a x=[1] y=[two]><b></><c z=[]></></>",
+      read("<a x='1' y = \"two\"><b/><c z=''></c></a>"));
+  EXPECT_EQ("<a_1 ns:x-y.z=[1]></>", read("<a_1 ns:x-y.z='1'/>"));
+  EXPECT_EQ("<a></>", read("\xEF\xBB\xBF<a/>"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Text)
+{
+  // White space is condensed, and text that is only white space is dropped.
+  EXPECT_EQ("<a>T[1 2 3]</>", read("<a>\n  1\t2   3 \n</a>"));
+  EXPECT_EQ("<a><b></>T[x]</>", read("<a> <b/> x </a>"));
+
+  // References.
+  EXPECT_EQ("<a x=[<&>]>T[\"' A B]</>",
+      read("<a x='&lt;&amp;&gt;'>&quot;&apos; &#65; &#x42;</a>"));
+
+  // Unknown entities lose their '&', like they do in TinyXML.
+  EXPECT_EQ("<a>T[bc;]</>", read("<a>b&c;</a>"));
+
+  // White space is kept in attributes and CDATA sections.
+  EXPECT_EQ("<a x=[ 1  2 ]>C[ <b> ]</>",
+      read("<a x=' 1  2 '><![CDATA[ <b> ]]></a>"));
+
+  // UTF-8 is copied as it is.
+  EXPECT_EQ("<a>T[\xC3\xA9]</>", read("<a>\xC3\xA9</a>"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, OtherNodes)
+{
+  EXPECT_EQ("?[?xml version='1.0'?]#[ c ]<a>?[!-x-]#[d]</>",
+      read("<?xml version='1.0'?>\n<!-- c --><a><!-x-><!--d--></a>"));
+
+  // TinyXML ignores anything after the markup at the top level.
+  EXPECT_EQ("<a></>", read("<a/> trailing"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Malformed)
+{
+  EXPECT_EQ("error", read(""));
+  EXPECT_EQ("error", read("text"));
+  EXPECT_EQ("error", read("<a>"));
+  EXPECT_EQ("error", read("<a></b>"));
+  EXPECT_EQ("error", read("<a></ab>"));
+  EXPECT_EQ("error", read("</a>"));
+  EXPECT_EQ("error", read("<a/ >"));
+  EXPECT_EQ("error", read("<a x='1' x='2'/>"));
+  EXPECT_EQ("error", read("<a x='1/>"));
+  EXPECT_EQ("error", read("<a>text"));
+  EXPECT_EQ("error", read("<a><!-- c </a>"));
+  EXPECT_EQ("error", read("<a>&#x4G;</a>"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Unsupported)
+{
+  // TinyXML reads these, but differently from a conforming parser, so they
+  // are left to it.
+  EXPECT_EQ("error", read("<a x=1/>"));
+  EXPECT_EQ("error", read("<a>&#233;</a>"));
+  EXPECT_EQ("error", read("<\xC3\xA9/>"));
+  EXPECT_EQ("error", read("<a>\xC3<b/></a>"));
+  EXPECT_EQ("error", read("<a> \xEF\xBB\xBFx</a>"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Stop)
+{
+  RecordingHandler handler;
+  handler.stopAt = 2;
+  EXPECT_FALSE(sdf::readXmlStream("<a><b/></a>", handler));
+  EXPECT_EQ("<a><b>", handler.nodes);
+}
+
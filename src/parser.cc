@@ -15,10 +15,23 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
 
 #include <ignition/math/SemanticVersion.hh>
 
@@ -38,7 +51,12 @@
 #include "sdf/parser_urdf.hh"
 #include "sdf/sdf_config.h"
 
+#include "BinaryCache.hh"
 #include "FrameSemantics.hh"
+#include "MappedFile.hh"
+#include "SDFImplPrivate.hh"
+#include "Utils.hh"
+#include "XmlStreamReader.hh"
 
 namespace sdf
 {
@@ -78,12 +96,98 @@ bool readStringInternal(
     const bool _convert,
     Errors &_errors);
 
+/// \brief Internal helper for readFileInternal, which reads an SDF file
+/// with the streaming parser when it is enabled.
+/// \param[in] _filename Path of the SDF file.
+/// \param[in] _sdf Pointer to an SDF object.
+/// \param[in] _convert Convert to the latest version if true.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if the file was read. False if the streaming parser is
+/// disabled, or the file must be read with TinyXML.
+/// \sa void setStreamingParser(const bool _streaming)
+static bool readFileStream(
+    const std::string &_filename,
+    SDFPtr _sdf,
+    const bool _convert,
+    Errors &_errors);
+
+/// \brief Internal helper for readFileStream and readStringInternal, which
+/// reads an SDF document with the streaming parser when it is enabled.
+/// \param[in] _data The document, as a null terminated string.
+/// \param[in] _sdf Pointer to an SDF object.
+/// \param[in] _source Path of the file the document is from, or
+/// "data-string".
+/// \param[in] _convert Convert to the latest version if true.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if the document was read. False if the streaming parser is
+/// disabled, or the document must be read with TinyXML.
+static bool readSdfStream(
+    const char *_data,
+    SDFPtr _sdf,
+    const std::string &_source,
+    const bool _convert,
+    Errors &_errors);
+
+//////////////////////////////////////////////////
+/// \brief Normalize the line breaks of a mapped file in place, like
+/// TiXmlDocument::LoadFile. Only the pages that have a carriage return are
+/// copied.
+/// \param[in,out] _file The mapped file.
+static void normalizeLineBreaks(MappedFile &_file)
+{
+  char *data = _file.Data();
+  const char *end = data + _file.Size();
+  char *write = static_cast<char *>(std::memchr(data, '\r', _file.Size()));
+  if (!write)
+    return;
+
+  const char *read = write;
+  while (read < end)
+  {
+    if (*read == '\r')
+    {
+      *write++ = '\n';
+      ++read;
+      if (read < end && *read == '\n')
+        ++read;
+    }
+    else
+    {
+      *write++ = *read++;
+    }
+  }
+  *write = '\0';
+}
+
+//////////////////////////////////////////////////
+/// \brief Load an XML file, with the same result as
+/// TiXmlDocument::LoadFile. The file is parsed from a private memory
+/// mapping instead of a copy on the heap, so large files are not held in
+/// memory twice while their node tree is built.
+/// \param[in] _filename Path of the file.
+/// \param[out] _doc Document to load the file into.
+/// \return True if the file was loaded and parsed.
+static bool loadXmlFile(const std::string &_filename, TiXmlDocument &_doc)
+{
+  MappedFile file(_filename);
+  if (!file.Valid())
+  {
+    // Let TinyXML report why the file can't be read.
+    return _doc.LoadFile(_filename);
+  }
+
+  normalizeLineBreaks(file);
+  _doc.SetValue(_filename);
+  _doc.Parse(file.Data());
+  return !_doc.Error();
+}
+
 //////////////////////////////////////////////////
 template <typename TPtr>
 static inline bool _initFile(const std::string &_filename, TPtr _sdf)
 {
   TiXmlDocument xmlDoc;
-  if (xmlDoc.LoadFile(_filename))
+  if (loadXmlFile(_filename, xmlDoc))
   {
     return initDoc(&xmlDoc, _sdf);
   }
@@ -96,36 +200,80 @@ static inline bool _initFile(const std::string &_filename, TPtr _sdf)
 }
 
 //////////////////////////////////////////////////
-bool init(SDFPtr _sdf)
+/// \brief Get the element description tree of an embedded spec file.
+///
+/// Parsing the embedded spec XML and building the description tree is
+/// expensive, so the result is built once and kept in a process-wide cache
+/// keyed by SDF::Version() and the spec filename. The returned element is
+/// shared between all callers and must not be modified; copy it instead.
+/// \param[in] _filename Name of the spec file, such as "root.sdf".
+/// \param[in] _quiet True to suppress the error printed when the spec file
+/// is not embedded.
+/// \return The cached description, or nullptr if the spec file is not
+/// embedded or could not be parsed.
+static ElementPtr cachedSpec(const std::string &_filename, const bool _quiet)
 {
-  std::string xmldata = SDF::EmbeddedSpec("root.sdf", false);
+  using SpecKey = std::pair<std::string, std::string>;
+  static std::mutex specMutex;
+  static std::map<SpecKey, ElementPtr> specCache;
+
+  const SpecKey key(SDF::Version(), _filename);
+  {
+    std::lock_guard<std::mutex> lock(specMutex);
+    auto iter = specCache.find(key);
+    if (iter != specCache.end())
+    {
+      return iter->second;
+    }
+  }
+
+  // The lock is not held while parsing, since spec files include other
+  // spec files and initXml calls back into this function for them.
+  const std::string &xmldata = SDF::EmbeddedSpec(_filename, _quiet);
+  if (xmldata.empty())
+  {
+    return nullptr;
+  }
+
   TiXmlDocument xmlDoc;
   xmlDoc.Parse(xmldata.c_str());
-  return initDoc(&xmlDoc, _sdf);
+  ElementPtr spec(new Element);
+  if (!initDoc(&xmlDoc, spec))
+  {
+    return nullptr;
+  }
+
+  // If another thread got here first, keep its copy.
+  std::lock_guard<std::mutex> lock(specMutex);
+  return specCache.emplace(key, spec).first->second;
 }
 
 //////////////////////////////////////////////////
-bool initFile(const std::string &_filename, SDFPtr _sdf)
+bool init(SDFPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
-  if (!xmldata.empty())
+  ElementPtr spec = cachedSpec("root.sdf", false);
+  if (!spec)
   {
-    TiXmlDocument xmlDoc;
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _sdf);
+    return false;
   }
-  return _initFile(sdf::findFile(_filename), _sdf);
+  _sdf->Root()->Copy(spec);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool initFile(const std::string &_filename, SDFPtr _sdf)
+{
+  return initFile(_filename, _sdf->Root());
 }
 
 //////////////////////////////////////////////////
 bool initFile(const std::string &_filename, ElementPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
-  if (!xmldata.empty())
+  ElementPtr spec = cachedSpec(_filename, true);
+  if (spec)
   {
-    TiXmlDocument xmlDoc;
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _sdf);
+    _sdf->Copy(spec);
+    return true;
   }
   return _initFile(sdf::findFile(_filename), _sdf);
 }
@@ -202,7 +350,10 @@ bool initXml(TiXmlElement *_xml, ElementPtr _sdf)
     sdferr << "Element is missing the name attribute\n";
     return false;
   }
-  _sdf->SetName(std::string(nameString));
+  // Names and attribute keys from the spec are interned, so that elements
+  // and params read from documents share them. Names that only appear in
+  // documents are owned by their elements instead.
+  _sdf->SetName(*internString(nameString));
 
   const char *requiredString = _xml->Attribute("required");
   if (!requiredString)
@@ -267,7 +418,8 @@ bool initXml(TiXmlElement *_xml, ElementPtr _sdf)
       description = descriptionChild->GetText();
     }
 
-    _sdf->AddAttribute(name, type, defaultValue, required, description);
+    _sdf->AddAttribute(*internString(name), type, defaultValue, required,
+        description);
   }
 
   // Read the element description
@@ -375,44 +527,38 @@ bool readFileWithoutConversion(
 }
 
 //////////////////////////////////////////////////
-bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
+/// \brief Internal helper for readFileInternal, which reads an SDF or URDF
+/// file that was found.
+/// \param[in] _filename Path of the file.
+/// \param[in] _sdf Pointer to an SDF object.
+/// \param[in] _convert Convert to the latest version if true.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if successful.
+static bool readFoundFile(const std::string &_filename, SDFPtr _sdf,
       const bool _convert, Errors &_errors)
 {
   TiXmlDocument xmlDoc;
-  std::string filename = sdf::findFile(_filename, true, true);
-
-  if (filename.empty())
-  {
-    sdferr << "Error finding file [" << _filename << "].\n";
-    return false;
-  }
-
-  if (filesystem::is_directory(filename))
-  {
-    filename = getModelFilePath(filename);
-  }
 
-  if (!filesystem::exists(filename))
+  if (readFileStream(_filename, _sdf, _convert, _errors))
   {
-    sdferr << "File [" << filename << "] doesn't exist.\n";
-    return false;
+    return true;
   }
 
-  if (!xmlDoc.LoadFile(filename))
+  if (!loadXmlFile(_filename, xmlDoc))
   {
-    sdferr << "Error parsing XML in file [" << filename << "]: "
+    sdferr << "Error parsing XML in file [" << _filename << "]: "
            << xmlDoc.ErrorDesc() << '\n';
     return false;
   }
 
-  if (readDoc(&xmlDoc, _sdf, filename, _convert, _errors))
+  if (readDoc(&xmlDoc, _sdf, _filename, _convert, _errors))
   {
     return true;
   }
-  else if (sdf::URDF2SDF::IsURDF(filename))
+  else if (sdf::URDF2SDF::IsURDF(_filename))
   {
     sdf::URDF2SDF u2g;
-    TiXmlDocument doc = u2g.InitModelFile(filename);
+    TiXmlDocument doc = u2g.InitModelFile(_filename);
     if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _errors))
     {
       sdfdbg << "parse from urdf file [" << _filename << "].\n";
@@ -428,6 +574,65 @@ bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
   return false;
 }
 
+/// \brief Number of <include> elements read on this thread, used to tell
+/// whether a document includes other files.
+static thread_local uint64_t t_includeCount = 0;
+
+//////////////////////////////////////////////////
+bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
+      const bool _convert, Errors &_errors)
+{
+  std::string filename = sdf::findFile(_filename, true, true);
+
+  if (filename.empty())
+  {
+    sdferr << "Error finding file [" << _filename << "].\n";
+    return false;
+  }
+
+  if (filesystem::is_directory(filename))
+  {
+    filename = getModelFilePath(filename);
+  }
+
+  if (!filesystem::exists(filename))
+  {
+    sdferr << "File [" << filename << "] doesn't exist.\n";
+    return false;
+  }
+
+  // Only whole documents are cached, so files read into an SDF object that
+  // already has elements are always parsed.
+  const bool useCache = _convert && binaryCache() && _sdf && _sdf->Root() &&
+    !_sdf->Root()->GetFirstElement();
+  const std::string cacheFilename =
+    BinaryCache::Filename(filename, binaryCacheDirectory());
+  if (useCache && BinaryCache::Read(cacheFilename, _sdf))
+  {
+    return true;
+  }
+
+  const size_t errorCount = _errors.size();
+  const uint64_t includeCount = t_includeCount;
+  if (!readFoundFile(filename, _sdf, _convert, _errors))
+  {
+    return false;
+  }
+
+  // Documents with errors are not cached, so the errors are reported each
+  // time they are read. Neither are documents with <include> elements,
+  // since a uri can resolve to another model, for example after
+  // sdf::addURIPath or a change of SDF_PATH, while none of the files that
+  // were read change.
+  if (useCache && _errors.size() == errorCount &&
+      t_includeCount == includeCount)
+  {
+    BinaryCache::Write(cacheFilename, *_sdf, filename);
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool readString(const std::string &_xmlString, SDFPtr _sdf)
 {
@@ -458,6 +663,12 @@ bool readStringWithoutConversion(
 bool readStringInternal(const std::string &_xmlString, SDFPtr _sdf,
     const bool _convert, Errors &_errors)
 {
+  if (readSdfStream(_xmlString.c_str(), _sdf, "data-string", _convert,
+                    _errors))
+  {
+    return true;
+  }
+
   TiXmlDocument xmlDoc;
   xmlDoc.Parse(_xmlString.c_str());
   if (xmlDoc.Error())
@@ -779,286 +990,738 @@ std::string getModelFilePath(const std::string &_modelDirPath)
   return sdf::filesystem::append(_modelDirPath, modelFileName);
 }
 
+/// \brief True if included files are read in parallel.
+static std::atomic<bool> g_parallelIncludes(false);
+
+/// \brief True on the threads that read included files in parallel, so the
+/// files they include are read on the same thread, and on threads that
+/// called setSerialIncludes(true).
+static thread_local bool t_readingIncludes = false;
+
 //////////////////////////////////////////////////
-bool readXml(TiXmlElement *_xml, ElementPtr _sdf, Errors &_errors)
+bool setSerialIncludes(const bool _serial)
 {
-  // Check if the element pointer is deprecated.
-  if (_sdf->GetRequired() == "-1")
-  {
-    _errors.push_back({ErrorCode::ELEMENT_DEPRECATED,
-        "SDF Element[" + _sdf->GetName() + "] is deprecated"});
-    return true;
-  }
-
-  if (!_xml)
-  {
-    if (_sdf->GetRequired() == "1" || _sdf->GetRequired() =="+")
-    {
-      _errors.push_back({ErrorCode::ELEMENT_MISSING,
-          "SDF Element<" + _sdf->GetName() + "> is missing"});
-      return false;
-    }
-    else
-    {
-      return true;
-    }
-  }
+  const bool previous = t_readingIncludes;
+  t_readingIncludes = _serial;
+  return previous;
+}
 
-  if (_xml->GetText() != nullptr && _sdf->GetValue())
-  {
-    if (!_sdf->GetValue()->SetFromString(_xml->GetText()))
-      return false;
-  }
+//////////////////////////////////////////////////
+void setParallelIncludes(const bool _parallel)
+{
+  g_parallelIncludes = _parallel;
+}
 
-  // check for nested sdf
-  std::string refSDFStr = _sdf->ReferenceSDF();
-  if (!refSDFStr.empty())
-  {
-    ElementPtr refSDF;
-    refSDF.reset(new Element);
-    std::string refFilename = refSDFStr + ".sdf";
-    initFile(refFilename, refSDF);
-    _sdf->RemoveFromParent();
-    _sdf->Copy(refSDF);
-  }
+//////////////////////////////////////////////////
+bool parallelIncludes()
+{
+  return g_parallelIncludes;
+}
 
-  TiXmlAttribute *attribute = _xml->FirstAttribute();
+/// \brief True if documents are read with the streaming parser.
+static std::atomic<bool> g_streamingParser(false);
 
-  unsigned int i = 0;
+//////////////////////////////////////////////////
+void setStreamingParser(const bool _streaming)
+{
+  g_streamingParser = _streaming;
+}
 
-  // Iterate over all the attributes defined in the give XML element
-  while (attribute)
-  {
-    // Avoid printing a warning message for missing attributes if a namespaced
-    // attribute is found
-    if (std::strchr(attribute->Name(), ':') != NULL)
-    {
-      _sdf->AddAttribute(attribute->Name(), "string", "", 1, "");
-      _sdf->GetAttribute(attribute->Name())->SetFromString(
-          attribute->ValueStr());
-      attribute = attribute->Next();
-      continue;
-    }
-    // Find the matching attribute in SDF
-    for (i = 0; i < _sdf->GetAttributeCount(); ++i)
-    {
-      ParamPtr p = _sdf->GetAttribute(i);
-      if (p->GetKey() == attribute->Name())
-      {
-        // Set the value of the SDF attribute
-        if (!p->SetFromString(attribute->ValueStr()))
-        {
-          _errors.push_back({ErrorCode::ATTRIBUTE_INVALID,
-              "Unable to read attribute[" + p->GetKey() + "]"});
-          return false;
-        }
-        break;
-      }
-    }
+//////////////////////////////////////////////////
+bool streamingParser()
+{
+  return g_streamingParser;
+}
 
-    if (i == _sdf->GetAttributeCount())
-    {
-      sdfwarn << "XML Attribute[" << attribute->Name()
-              << "] in element[" << _xml->Value()
-              << "] not defined in SDF, ignoring.\n";
-    }
+/// \brief True if SDF files are read from binary cache files.
+static std::atomic<bool> g_binaryCache(false);
 
-    attribute = attribute->Next();
-  }
+//////////////////////////////////////////////////
+void setBinaryCache(const bool _enabled)
+{
+  g_binaryCache = _enabled;
+}
 
-  // Check that all required attributes have been set
-  for (i = 0; i < _sdf->GetAttributeCount(); ++i)
-  {
-    ParamPtr p = _sdf->GetAttribute(i);
-    if (p->GetRequired() && !p->GetSet())
-    {
-      _errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
-          "Required attribute[" + p->GetKey() + "] in element[" + _xml->Value()
-          + "] is not specified in SDF."});
-      return false;
-    }
-  }
+//////////////////////////////////////////////////
+bool binaryCache()
+{
+  return g_binaryCache;
+}
 
-  if (_sdf->GetCopyChildren())
-  {
-    copyChildren(_sdf, _xml, false);
-  }
-  else
-  {
-    std::string filename;
+/// \brief Directory of the binary cache files, or empty to write each one
+/// next to its SDF file.
+static std::string g_binaryCacheDirectory;
 
-    // Iterate over all the child elements
-    TiXmlElement *elemXml = nullptr;
-    for (elemXml = _xml->FirstChildElement(); elemXml;
-         elemXml = elemXml->NextSiblingElement())
-    {
-      if (std::string("include") == elemXml->Value())
-      {
-        std::string modelPath;
+/// \brief Protects g_binaryCacheDirectory.
+static std::mutex g_binaryCacheDirectoryMutex;
 
-        if (elemXml->FirstChildElement("uri"))
-        {
-          std::string uri = elemXml->FirstChildElement("uri")->GetText();
-          modelPath = sdf::findFile(uri, true, true);
+//////////////////////////////////////////////////
+void setBinaryCacheDirectory(const std::string &_directory)
+{
+  std::lock_guard<std::mutex> lock(g_binaryCacheDirectoryMutex);
+  g_binaryCacheDirectory = _directory;
+}
 
-          // Test the model path
-          if (modelPath.empty())
-          {
-            _errors.push_back({ErrorCode::URI_LOOKUP,
-                "Unable to find uri[" + uri + "]"});
-
-            size_t modelFound = uri.find("model://");
-            if (modelFound != 0u)
-            {
-              _errors.push_back({ErrorCode::URI_INVALID,
-                  "Invalid uri[" + uri + "]. Should be model://" + uri});
-            }
-            continue;
-          }
-          else
-          {
-            if (!sdf::filesystem::is_directory(modelPath))
-            {
-              _errors.push_back({ErrorCode::DIRECTORY_NONEXISTANT,
-                  "Directory doesn't exist[" + modelPath + "]"});
-              continue;
-            }
-          }
-
-          // Get the config.xml filename
-          filename = getModelFilePath(modelPath);
-        }
-        else
-        {
-          _errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
-              "<include> element missing 'uri' attribute"});
-          continue;
-        }
+//////////////////////////////////////////////////
+std::string binaryCacheDirectory()
+{
+  std::lock_guard<std::mutex> lock(g_binaryCacheDirectoryMutex);
+  return g_binaryCacheDirectory;
+}
 
-        // NOTE: sdf::init is an expensive call. For performance reason,
-        // a new sdf pointer is created here by cloning a fresh sdf template
-        // pointer instead of calling init every iteration.
-        // SDFPtr includeSDF(new SDF);
-        // init(includeSDF);
-        static SDFPtr includeSDFTemplate;
-        if (!includeSDFTemplate)
-        {
-          includeSDFTemplate.reset(new SDF);
-          init(includeSDFTemplate);
-        }
-        SDFPtr includeSDF(new SDF);
-        includeSDF->Root(includeSDFTemplate->Root()->Clone());
+//////////////////////////////////////////////////
+bool writeBinaryCache(const std::string &_filename, const SDFPtr _sdf)
+{
+  return _sdf && BinaryCache::Write(_filename, *_sdf, _sdf->FilePath());
+}
 
-        if (!readFile(filename, includeSDF))
-        {
-          _errors.push_back({ErrorCode::FILE_READ,
-              "Unable to read file[" + filename + "]"});
-          return false;
-        }
+//////////////////////////////////////////////////
+bool readBinaryCache(const std::string &_filename, SDFPtr _sdf)
+{
+  return BinaryCache::Read(_filename, _sdf);
+}
 
-        if (elemXml->FirstChildElement("name"))
-        {
-          includeSDF->Root()->GetElement("model")->GetAttribute(
-              "name")->SetFromString(
-                elemXml->FirstChildElement("name")->GetText());
-        }
+//////////////////////////////////////////////////
+/// \brief Size and modification time of a file, used to tell whether it
+/// changed after it was cached.
+struct FileStamp
+{
+  /// \brief Modification time in nanoseconds, or -1 if the file does not
+  /// exist. Only whole seconds are available on Windows.
+  int64_t time = -1;
 
-        TiXmlElement *poseElemXml = elemXml->FirstChildElement("pose");
-        if (poseElemXml)
-        {
-          sdf::ElementPtr poseElem =
-              includeSDF->Root()->GetElement("model")->GetElement("pose");
+  /// \brief Size in bytes, or -1 if the file does not exist.
+  int64_t size = -1;
 
-          if (poseElemXml->GetText())
-          {
-            poseElem->GetValue()->SetFromString(poseElemXml->GetText());
-          }
-          else
-          {
-            poseElem->GetValue()->Reset();
-          }
+  /// \brief Equality operator.
+  /// \param[in] _other Stamp to compare with.
+  /// \return True if both stamps are the same.
+  bool operator==(const FileStamp &_other) const
+  {
+    return this->time == _other.time && this->size == _other.size;
+  }
+};
 
-          const char *relativeTo = poseElemXml->Attribute("relative_to");
-          if (relativeTo)
-          {
-            poseElem->GetAttribute("relative_to")->SetFromString(relativeTo);
-          }
-          else
-          {
-            poseElem->GetAttribute("relative_to")->Reset();
-          }
-        }
+//////////////////////////////////////////////////
+/// \brief Get the size and modification time of a file.
+/// \param[in] _path Path to the file.
+/// \return The stamp of the file.
+static FileStamp fileStamp(const std::string &_path)
+{
+  FileStamp stamp;
+#ifndef _WIN32
+  struct stat fileStat;
+  if (::stat(_path.c_str(), &fileStat) == 0)
+#else
+  struct _stat64 fileStat;
+  if (::_stat64(_path.c_str(), &fileStat) == 0)
+#endif
+  {
+    // An edit within the same second as the previous one must still change
+    // the stamp, so use the sub-second part of the time where available.
+    stamp.time = static_cast<int64_t>(fileStat.st_mtime) * 1000000000;
+#if defined(__APPLE__)
+    stamp.time += static_cast<int64_t>(fileStat.st_mtimespec.tv_nsec);
+#elif !defined(_WIN32)
+    stamp.time += static_cast<int64_t>(fileStat.st_mtim.tv_nsec);
+#endif
+    stamp.size = static_cast<int64_t>(fileStat.st_size);
+  }
+  return stamp;
+}
 
-        if (elemXml->FirstChildElement("static"))
-        {
-          includeSDF->Root()->GetElement("model")->GetElement(
-              "static")->GetValue()->SetFromString(
-                elemXml->FirstChildElement("static")->GetText());
-        }
+//////////////////////////////////////////////////
+/// \brief Copy the values and default values of the params of an element
+/// tree into a clone of it. Element::Clone makes the values of the original
+/// the default values of the clone, so this restores the defaults.
+/// \param[in] _from Element that was cloned.
+/// \param[in] _to Clone of _from.
+static void copyParams(const ElementPtr &_from, const ElementPtr &_to)
+{
+  for (unsigned int i = 0; i < _from->GetAttributeCount(); ++i)
+    *_to->GetAttribute(i) = *_from->GetAttribute(i);
 
-        for (TiXmlElement *childElemXml = elemXml->FirstChildElement();
-             childElemXml; childElemXml = childElemXml->NextSiblingElement())
-        {
-          if (std::string("plugin") == childElemXml->Value())
-          {
-            sdf::ElementPtr pluginElem;
-            pluginElem = includeSDF->Root()->GetElement(
-                "model")->AddElement("plugin");
-
-            if (!readXml(childElemXml, pluginElem, _errors))
-            {
-              _errors.push_back({ErrorCode::ELEMENT_INVALID,
-                                 "Error reading plugin element"});
-              return false;
-            }
-          }
-        }
+  if (_from->GetValue())
+    *_to->GetValue() = *_from->GetValue();
+
+  ElementPtr fromChild = _from->GetFirstElement();
+  ElementPtr toChild = _to->GetFirstElement();
+  while (fromChild && toChild)
+  {
+    copyParams(fromChild, toChild);
+    fromChild = fromChild->GetNextElement();
+    toChild = toChild->GetNextElement();
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief A parsed model and the stamps of the files it was read from.
+struct CachedModel
+{
+  /// \brief Stamp of the model.config file.
+  FileStamp configStamp;
+
+  /// \brief The model file read.
+  std::string filename;
+
+  /// \brief Stamp of the model file.
+  FileStamp fileStamp;
+
+  /// \brief The parsed model, which is never modified.
+  SDFPtr sdf;
+};
+
+/// \brief True if included models are cached.
+static std::atomic<bool> g_includeCache(false);
+
+/// \brief Mutex that protects g_includedModels.
+static std::mutex g_includedModelsMutex;
+
+/// \brief Cache of included models, keyed by SDF::Version() and the model
+/// directory.
+static std::map<std::pair<std::string, std::string>, CachedModel>
+    g_includedModels;
+
+//////////////////////////////////////////////////
+void setIncludeCache(const bool _enabled)
+{
+  g_includeCache = _enabled;
+  if (!_enabled)
+    clearIncludeCache();
+}
+
+//////////////////////////////////////////////////
+bool includeCache()
+{
+  return g_includeCache;
+}
+
+//////////////////////////////////////////////////
+void clearIncludeCache()
+{
+  std::lock_guard<std::mutex> lock(g_includedModelsMutex);
+  g_includedModels.clear();
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the model file in a model directory.
+///
+/// If the include cache is enabled, the parsed model is kept in
+/// g_includedModels and each include gets a copy of it. A cached model is
+/// read again if its model.config or model file changes size or
+/// modification time.
+/// \param[in] _modelPath Path to the model directory.
+/// \param[out] _filename The model file read.
+/// \return The parsed model, or nullptr if it could not be read.
+static SDFPtr readIncludedModel(const std::string &_modelPath,
+                                std::string &_filename)
+{
+  if (!g_includeCache)
+  {
+    // Get the config.xml filename
+    _filename = getModelFilePath(_modelPath);
+
+    SDFPtr includeSDF(new SDF);
+    init(includeSDF);
+    if (!readFile(_filename, includeSDF))
+      return nullptr;
+    return includeSDF;
+  }
+
+  const std::pair<std::string, std::string> key(SDF::Version(), _modelPath);
+  const FileStamp configStamp =
+    fileStamp(sdf::filesystem::append(_modelPath, "model.config"));
+
+  CachedModel cached;
+  {
+    std::lock_guard<std::mutex> lock(g_includedModelsMutex);
+    auto iter = g_includedModels.find(key);
+    if (iter != g_includedModels.end())
+      cached = iter->second;
+  }
+
+  if (!cached.sdf || !(cached.configStamp == configStamp) ||
+      !(cached.fileStamp == fileStamp(cached.filename)))
+  {
+    // Get the config.xml filename
+    cached.configStamp = configStamp;
+    cached.filename = getModelFilePath(_modelPath);
+    cached.fileStamp = fileStamp(cached.filename);
+
+    // The spec is cached by init, so this only copies the description.
+    cached.sdf.reset(new SDF);
+    init(cached.sdf);
+    if (!readFile(cached.filename, cached.sdf))
+    {
+      _filename = cached.filename;
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_includedModelsMutex);
+    g_includedModels[key] = cached;
+  }
+
+  // The cached model is never modified, since each include changes the name
+  // and pose of its own copy.
+  _filename = cached.filename;
+  ElementPtr root = cached.sdf->Root()->Clone();
+  copyParams(cached.sdf->Root(), root);
+  SDFPtr includeSDF(new SDF);
+  includeSDF->Root(root);
+  return includeSDF;
+}
+
+//////////////////////////////////////////////////
+/// \brief The model file of an <include> element, found and parsed.
+struct IncludedFile
+{
+  /// \brief Path found for the uri, or empty if it was not found.
+  std::string modelPath;
+
+  /// \brief True if modelPath is a directory.
+  bool isDirectory = false;
+
+  /// \brief Model file in the modelPath directory.
+  std::string filename;
+
+  /// \brief The parsed model file, or nullptr if it could not be read.
+  SDFPtr sdf;
+
+  /// \brief Exception thrown while reading the file on another thread, to
+  /// be rethrown on the thread that includes it.
+  std::exception_ptr exception;
+};
+
+//////////////////////////////////////////////////
+/// \brief Find and parse the model file of an <include> element.
+/// \param[in] _uri The uri of the <include> element.
+/// \param[out] _file The model file found, and its parsed SDF.
+static void readIncludedFile(const std::string &_uri, IncludedFile &_file)
+{
+  _file.modelPath = sdf::findFile(_uri, true, true);
+  if (_file.modelPath.empty())
+    return;
+
+  _file.isDirectory = sdf::filesystem::is_directory(_file.modelPath);
+  if (!_file.isDirectory)
+    return;
+
+  _file.sdf = readIncludedModel(_file.modelPath, _file.filename);
+}
+
+//////////////////////////////////////////////////
+/// \brief Find and parse the model files of the <include> children of an
+/// element on a pool of threads.
+/// \param[in] _xml Element whose <include> children are read.
+/// \param[out] _files The files read, keyed by their <include> element.
+static void readIncludedFiles(TiXmlElement *_xml,
+    std::unordered_map<const TiXmlElement *, IncludedFile> &_files)
+{
+  std::vector<std::pair<const TiXmlElement *, std::string>> includes;
+  for (TiXmlElement *elemXml = _xml->FirstChildElement("include"); elemXml;
+       elemXml = elemXml->NextSiblingElement("include"))
+  {
+    TiXmlElement *uriXml = elemXml->FirstChildElement("uri");
+    if (uriXml && uriXml->GetText())
+      includes.emplace_back(elemXml, uriXml->GetText());
+  }
+
+  if (includes.size() < 2)
+    return;
+
+  std::vector<IncludedFile> files(includes.size());
+  const bool findFileCacheScope = findFileCacheScoped();
+  std::atomic<size_t> next(0);
+  auto worker = [&]()
+  {
+    std::unique_ptr<FindFileCacheScope> scope;
+    if (findFileCacheScope)
+      scope.reset(new FindFileCacheScope);
+    t_readingIncludes = true;
+
+    for (size_t i = next++; i < includes.size(); i = next++)
+    {
+      try
+      {
+        readIncludedFile(includes[i].second, files[i]);
+      }
+      catch(...)
+      {
+        files[i].exception = std::current_exception();
+      }
+    }
+  };
+
+  const size_t threadCount = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), includes.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadCount; ++i)
+    threads.emplace_back(worker);
+  for (auto &thread : threads)
+    thread.join();
+
+  for (size_t i = 0; i < includes.size(); ++i)
+    _files.emplace(includes[i].first, std::move(files[i]));
+}
+
+//////////////////////////////////////////////////
+/// \brief Set an attribute of an element to a value read from XML.
+/// Namespaced attributes are added to the element, and other attributes
+/// that are not in its description are ignored with a warning.
+/// \param[in] _sdf The element.
+/// \param[in] _xmlName Name of the XML element, for the warning.
+/// \param[in] _name Name of the attribute.
+/// \param[in] _value Value of the attribute.
+/// \param[out] _errors Errors are appended to this variable.
+/// \return False if the value is not valid for the attribute.
+static bool readAttribute(ElementPtr _sdf, const std::string &_xmlName,
+    const char *_name, const std::string &_value, Errors &_errors)
+{
+  // Avoid printing a warning message for missing attributes if a namespaced
+  // attribute is found
+  if (std::strchr(_name, ':') != NULL)
+  {
+    _sdf->AddAttribute(_name, "string", "", 1, "");
+    _sdf->GetAttribute(_name)->SetFromString(_value);
+    return true;
+  }
+
+  // Find the matching attribute in SDF
+  for (unsigned int i = 0; i < _sdf->GetAttributeCount(); ++i)
+  {
+    ParamPtr p = _sdf->GetAttribute(i);
+    if (p->GetKey() == _name)
+    {
+      // Set the value of the SDF attribute
+      if (!p->SetFromString(_value))
+      {
+        _errors.push_back({ErrorCode::ATTRIBUTE_INVALID,
+            "Unable to read attribute[" + p->GetKey() + "]"});
+        return false;
+      }
+      return true;
+    }
+  }
+
+  sdfwarn << "XML Attribute[" << _name << "] in element[" << _xmlName
+          << "] not defined in SDF, ignoring.\n";
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the required attributes of an element are set.
+/// \param[in] _sdf The element.
+/// \param[in] _xmlName Name of the XML element, for the error.
+/// \param[out] _errors Errors are appended to this variable.
+/// \return False if a required attribute is not set.
+static bool checkRequiredAttributes(ElementPtr _sdf,
+    const std::string &_xmlName, Errors &_errors)
+{
+  for (unsigned int i = 0; i < _sdf->GetAttributeCount(); ++i)
+  {
+    ParamPtr p = _sdf->GetAttribute(i);
+    if (p->GetRequired() && !p->GetSet())
+    {
+      _errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
+          "Required attribute[" + p->GetKey() + "] in element[" + _xmlName
+          + "] is not specified in SDF."});
+      return false;
+    }
+  }
 
-        if (_sdf->GetName() == "model")
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the required child elements that are missing from an
+/// element with their default values.
+/// \param[in] _sdf The element.
+/// \param[out] _errors Errors are appended to this variable.
+/// \return False if a required element of a joint, other than a ball joint,
+/// is missing.
+static bool addRequiredElements(ElementPtr _sdf, Errors &_errors)
+{
+  for (unsigned int descCounter = 0;
+       descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+  {
+    ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+
+    if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
+    {
+      if (!_sdf->HasElement(elemDesc->GetName()))
+      {
+        if (_sdf->GetName() == "joint" &&
+            _sdf->Get<std::string>("type") != "ball")
         {
-          addNestedModel(_sdf, includeSDF->Root());
+          _errors.push_back({ErrorCode::ELEMENT_MISSING,
+              "XML Missing required element[" + elemDesc->GetName() +
+              "], child of element[" + _sdf->GetName() + "]"});
+          return false;
         }
         else
         {
-          includeSDF->Root()->GetFirstElement()->SetParent(_sdf);
-          _sdf->InsertElement(includeSDF->Root()->GetFirstElement());
-          // TODO: This was used to store the included filename so that when
-          // a world is saved, the included model's SDF is not stored in the
-          // world file. This highlights the need to make model inclusion
-          // a core feature of SDF, and not a hack that that parser handles
-          // includeSDF->Root()->GetFirstElement()->SetInclude(
-          // elemXml->Attribute("filename"));
+          // Add default element
+          _sdf->AddElement(elemDesc->GetName());
         }
+      }
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the model of an <include> element to an element.
+/// \param[in] _includeXml The <include> element.
+/// \param[in] _sdf Element that the model is added to.
+/// \param[in] _includedFiles Included files that were read ahead of time,
+/// keyed by their <include> element.
+/// \param[out] _errors Errors are appended to this variable.
+/// \return False if the included model could not be read, which is an error
+/// in _sdf. Other errors are appended to _errors, and the <include> element
+/// is skipped.
+static bool readInclude(TiXmlElement *_includeXml, ElementPtr _sdf,
+    std::unordered_map<const TiXmlElement *, IncludedFile> &_includedFiles,
+    Errors &_errors)
+{
+  ++t_includeCount;
+  std::string filename;
+  IncludedFile included;
+
+  if (_includeXml->FirstChildElement("uri"))
+  {
+    std::string uri = _includeXml->FirstChildElement("uri")->GetText();
+    auto includedIter = _includedFiles.find(_includeXml);
+    if (includedIter != _includedFiles.end())
+    {
+      included = std::move(includedIter->second);
+      if (included.exception)
+        std::rethrow_exception(included.exception);
+    }
+    else
+    {
+      readIncludedFile(uri, included);
+    }
+
+    // Test the model path
+    if (included.modelPath.empty())
+    {
+      _errors.push_back({ErrorCode::URI_LOOKUP,
+          "Unable to find uri[" + uri + "]"});
+
+      size_t modelFound = uri.find("model://");
+      if (modelFound != 0u)
+      {
+        _errors.push_back({ErrorCode::URI_INVALID,
+            "Invalid uri[" + uri + "]. Should be model://" + uri});
+      }
+      return true;
+    }
+    else
+    {
+      if (!included.isDirectory)
+      {
+        _errors.push_back({ErrorCode::DIRECTORY_NONEXISTANT,
+            "Directory doesn't exist[" + included.modelPath + "]"});
+        return true;
+      }
+    }
+
+    filename = included.filename;
+  }
+  else
+  {
+    _errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
+        "<include> element missing 'uri' attribute"});
+    return true;
+  }
+
+  SDFPtr includeSDF = included.sdf;
+  if (!includeSDF)
+  {
+    _errors.push_back({ErrorCode::FILE_READ,
+        "Unable to read file[" + filename + "]"});
+    return false;
+  }
+
+  if (_includeXml->FirstChildElement("name"))
+  {
+    includeSDF->Root()->GetElement("model")->GetAttribute(
+        "name")->SetFromString(
+          _includeXml->FirstChildElement("name")->GetText());
+  }
+
+  TiXmlElement *poseElemXml = _includeXml->FirstChildElement("pose");
+  if (poseElemXml)
+  {
+    sdf::ElementPtr poseElem =
+        includeSDF->Root()->GetElement("model")->GetElement("pose");
+
+    if (poseElemXml->GetText())
+    {
+      poseElem->GetValue()->SetFromString(poseElemXml->GetText());
+    }
+    else
+    {
+      poseElem->GetValue()->Reset();
+    }
+
+    const char *relativeTo = poseElemXml->Attribute("relative_to");
+    if (relativeTo)
+    {
+      poseElem->GetAttribute("relative_to")->SetFromString(relativeTo);
+    }
+    else
+    {
+      poseElem->GetAttribute("relative_to")->Reset();
+    }
+  }
+
+  if (_includeXml->FirstChildElement("static"))
+  {
+    includeSDF->Root()->GetElement("model")->GetElement(
+        "static")->GetValue()->SetFromString(
+          _includeXml->FirstChildElement("static")->GetText());
+  }
+
+  for (TiXmlElement *childElemXml = _includeXml->FirstChildElement();
+       childElemXml; childElemXml = childElemXml->NextSiblingElement())
+  {
+    if (std::string("plugin") == childElemXml->Value())
+    {
+      sdf::ElementPtr pluginElem;
+      pluginElem = includeSDF->Root()->GetElement(
+          "model")->AddElement("plugin");
+
+      if (!readXml(childElemXml, pluginElem, _errors))
+      {
+        _errors.push_back({ErrorCode::ELEMENT_INVALID,
+                           "Error reading plugin element"});
+        return false;
+      }
+    }
+  }
+
+  if (_sdf->GetName() == "model")
+  {
+    addNestedModel(_sdf, includeSDF->Root());
+  }
+  else
+  {
+    includeSDF->Root()->GetFirstElement()->SetParent(_sdf);
+    _sdf->InsertElement(includeSDF->Root()->GetFirstElement());
+    // TODO: This was used to store the included filename so that when
+    // a world is saved, the included model's SDF is not stored in the
+    // world file. This highlights the need to make model inclusion
+    // a core feature of SDF, and not a hack that that parser handles
+    // includeSDF->Root()->GetFirstElement()->SetInclude(
+    // _includeXml->Attribute("filename"));
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool readXml(TiXmlElement *_xml, ElementPtr _sdf, Errors &_errors)
+{
+  // Check if the element pointer is deprecated.
+  if (_sdf->GetRequired() == "-1")
+  {
+    _errors.push_back({ErrorCode::ELEMENT_DEPRECATED,
+        "SDF Element[" + _sdf->GetName() + "] is deprecated"});
+    return true;
+  }
+
+  if (!_xml)
+  {
+    if (_sdf->GetRequired() == "1" || _sdf->GetRequired() =="+")
+    {
+      _errors.push_back({ErrorCode::ELEMENT_MISSING,
+          "SDF Element<" + _sdf->GetName() + "> is missing"});
+      return false;
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  if (_xml->GetText() != nullptr && _sdf->GetValue())
+  {
+    if (!_sdf->GetValue()->SetFromString(_xml->GetText()))
+      return false;
+  }
+
+  // check for nested sdf
+  std::string refSDFStr = _sdf->ReferenceSDF();
+  if (!refSDFStr.empty())
+  {
+    ElementPtr refSDF;
+    refSDF.reset(new Element);
+    std::string refFilename = refSDFStr + ".sdf";
+    initFile(refFilename, refSDF);
+    _sdf->RemoveFromParent();
+    _sdf->Copy(refSDF);
+  }
+
+  // Iterate over all the attributes defined in the give XML element
+  for (TiXmlAttribute *attribute = _xml->FirstAttribute(); attribute;
+       attribute = attribute->Next())
+  {
+    if (!readAttribute(_sdf, _xml->ValueStr(), attribute->Name(),
+                       attribute->ValueStr(), _errors))
+    {
+      return false;
+    }
+  }
+
+  // Check that all required attributes have been set
+  if (!checkRequiredAttributes(_sdf, _xml->ValueStr(), _errors))
+    return false;
+
+  if (_sdf->GetCopyChildren())
+  {
+    copyChildren(_sdf, _xml, false);
+  }
+  else
+  {
+    // Read the included files ahead of time, so they are parsed in parallel.
+    // They are still added below in document order.
+    std::unordered_map<const TiXmlElement *, IncludedFile> includedFiles;
+    if (g_parallelIncludes && !t_readingIncludes)
+      readIncludedFiles(_xml, includedFiles);
 
+    // Iterate over all the child elements
+    TiXmlElement *elemXml = nullptr;
+    for (elemXml = _xml->FirstChildElement(); elemXml;
+         elemXml = elemXml->NextSiblingElement())
+    {
+      if (std::string("include") == elemXml->Value())
+      {
+        if (!readInclude(elemXml, _sdf, includedFiles, _errors))
+          return false;
         continue;
       }
 
       // Find the matching element in SDF
-      unsigned int descCounter = 0;
-      for (descCounter = 0;
-           descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+      ElementPtr elemDesc = _sdf->GetElementDescription(elemXml->Value());
+      if (elemDesc)
       {
-        ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
-        if (elemDesc->GetName() == elemXml->Value())
+        ElementPtr element = elemDesc->Clone();
+        element->SetParent(_sdf);
+        if (readXml(elemXml, element, _errors))
         {
-          ElementPtr element = elemDesc->Clone();
-          element->SetParent(_sdf);
-          if (readXml(elemXml, element, _errors))
-          {
-            _sdf->InsertElement(element);
-          }
-          else
-          {
-            _errors.push_back({ErrorCode::ELEMENT_INVALID,
-                std::string("Error reading element <") +
-                elemXml->Value() + ">"});
-            return false;
-          }
-          break;
+          _sdf->InsertElement(element);
+        }
+        else
+        {
+          _errors.push_back({ErrorCode::ELEMENT_INVALID,
+              std::string("Error reading element <") +
+              elemXml->Value() + ">"});
+          return false;
         }
       }
-
-      if (descCounter == _sdf->GetElementDescriptionCount())
+      else
       {
         sdfdbg << "XML Element[" << elemXml->Value()
                << "], child of element[" << _xml->Value()
@@ -1072,53 +1735,69 @@ bool readXml(TiXmlElement *_xml, ElementPtr _sdf, Errors &_errors)
     copyChildren(_sdf, _xml, true);
 
     // Check that all required elements have been set
-    for (unsigned int descCounter = 0;
-         descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
-    {
-      ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
-
-      if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
-      {
-        if (!_sdf->HasElement(elemDesc->GetName()))
-        {
-          if (_sdf->GetName() == "joint" &&
-              _sdf->Get<std::string>("type") != "ball")
-          {
-            _errors.push_back({ErrorCode::ELEMENT_MISSING,
-                "XML Missing required element[" + elemDesc->GetName() +
-                "], child of element[" + _sdf->GetName() + "]"});
-            return false;
-          }
-          else
-          {
-            // Add default element
-            _sdf->AddElement(elemDesc->GetName());
-          }
-        }
-      }
-    }
+    if (!addRequiredElements(_sdf, _errors))
+      return false;
   }
 
   return true;
 }
 
 /////////////////////////////////////////////////
-static void replace_all(std::string &_str,
-                        const std::string &_from,
-                        const std::string &_to)
+/// \brief Rename the references to links and joints of a nested model in
+/// an element tree.
+/// \param[in] _elem Root of the element tree.
+/// \param[in] _replace New names of the links and joints, keyed by their
+/// old names.
+static void renameFrameReferences(const ElementPtr &_elem,
+    const std::map<std::string, std::string> &_replace)
 {
-  if (_from.empty())
+  auto rename = [&_replace](const ParamPtr &_param)
   {
-    return;
+    if (!_param)
+      return;
+    auto iter = _replace.find(_param->GetAsString());
+    if (iter != _replace.end())
+      _param->SetFromString(iter->second);
+  };
+
+  // Attributes of <pose>, <frame>, <xyz> and the IMU orientation reference
+  // frame elements that name a frame.
+  for (const char *key :
+      {"relative_to", "attached_to", "expressed_in", "parent_frame"})
+  {
+    if (_elem->HasAttribute(key))
+      rename(_elem->GetAttribute(key));
+  }
+
+  // Elements whose value names a link or joint, with the name of their
+  // parent element.
+  static const std::pair<const char *, const char *> kNameValues[] =
+  {
+    {"joint", "parent"},
+    {"joint", "child"},
+    {"joint", "gearbox_reference_body"},
+    {"gripper", "gripper_link"},
+    {"gripper", "palm_link"},
+  };
+  ElementPtr parent = _elem->GetParent();
+  if (parent)
+  {
+    const std::string &name = _elem->GetName();
+    const std::string &parentName = parent->GetName();
+    for (auto const &nameValue : kNameValues)
+    {
+      if (parentName == nameValue.first && name == nameValue.second)
+      {
+        rename(_elem->GetValue());
+        break;
+      }
+    }
   }
-  size_t start_pos = 0;
-  while ((start_pos = _str.find(_from, start_pos)) != std::string::npos)
+
+  for (ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
   {
-    _str.replace(start_pos, _from.length(), _to);
-    // We need to advance our starting position beyond what we
-    // just replaced to deal with the case where the '_to' string
-    // happens to contain a piece of '_from'.
-    start_pos += _to.length();
+    renameFrameReferences(child, _replace);
   }
 }
 
@@ -1179,6 +1858,360 @@ void copyChildren(ElementPtr _sdf, TiXmlElement *_xml, const bool _onlyUnknown)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Builds an SDF element tree from the nodes of an XML document as
+/// readXmlStream reads them, with the same result as readXml.
+///
+/// Most elements are read as their nodes arrive, so the document is never
+/// held as a whole. The subtrees that readXml needs to see at once, which
+/// are <include> elements, elements that are deprecated, copy their
+/// children or have a referenced description, and elements that are not in
+/// the description of their parent, are kept as TinyXML trees until they
+/// end, and then read by the same code as readXml.
+///
+/// Reading stops at the first error, so that the caller can read the
+/// document with TinyXML instead and report its errors the usual way.
+class ElementStreamBuilder : public XmlStreamHandler
+{
+  /// \brief Constructor.
+  /// \param[in] _root Root element to read the document into.
+  /// \param[in] _convert True to stop at documents that are not at the
+  /// current version, since they must be converted.
+  /// \param[out] _errors Errors that do not stop reading are appended to
+  /// this variable.
+  public: ElementStreamBuilder(ElementPtr _root, const bool _convert,
+              Errors &_errors)
+    : root(_root), convert(_convert), errors(_errors)
+  {
+  }
+
+  /// \brief Get whether the root element was read.
+  /// \return True if the root element ended.
+  public: bool Done() const
+  {
+    return this->done;
+  }
+
+  /// \brief Get the version of the document.
+  /// \return The version attribute of the root element.
+  public: const std::string &Version() const
+  {
+    return this->version;
+  }
+
+  // Documentation inherited.
+  public: bool StartElement(const std::string &_name,
+              const XmlAttributes &_attributes) override
+  {
+    if (this->kept)
+    {
+      TiXmlElement *xml = newXmlElement(_name, _attributes);
+      this->keptNode->LinkEndChild(xml);
+      this->keptNode = xml;
+      return true;
+    }
+
+    if (this->frames.empty())
+    {
+      if (this->done || _name != this->root->GetName())
+        return false;
+
+      auto versionIter = std::find_if(_attributes.begin(), _attributes.end(),
+          [](const std::pair<std::string, std::string> &_attribute)
+          {
+            return _attribute.first == "version";
+          });
+      if (versionIter == _attributes.end() ||
+          (this->convert && versionIter->second != SDF::Version()))
+      {
+        return false;
+      }
+
+      this->version = versionIter->second;
+      if (this->root->OriginalVersion().empty())
+        this->root->SetOriginalVersion(this->version);
+      return this->StartSdfElement(this->root, _name, _attributes);
+    }
+
+    Frame &parent = this->frames.back();
+    parent.firstChild = false;
+
+    ElementPtr elemDesc;
+    if (_name != "include")
+    {
+      elemDesc = parent.element->GetElementDescription(_name);
+      if (!elemDesc)
+      {
+        sdfdbg << "XML Element[" << _name
+               << "], child of element[" << parent.element->GetName()
+               << "], not defined in SDF. Copying[" << _name << "] "
+               << "as children of [" << parent.element->GetName() << "].\n";
+      }
+      else if (elemDesc->GetRequired() != "-1" &&
+               !elemDesc->GetCopyChildren() && elemDesc->ReferenceSDF().empty())
+      {
+        ElementPtr element = elemDesc->Clone();
+        element->SetParent(parent.element);
+        return this->StartSdfElement(element, _name, _attributes);
+      }
+    }
+
+    this->kept.reset(newXmlElement(_name, _attributes));
+    this->keptNode = this->kept.get();
+    this->keptDesc = elemDesc;
+    return true;
+  }
+
+  // Documentation inherited.
+  public: bool EndElement() override
+  {
+    if (this->kept)
+    {
+      if (this->keptNode != this->kept.get())
+      {
+        this->keptNode = this->keptNode->Parent();
+        return true;
+      }
+      return this->EndKept();
+    }
+
+    Frame frame = std::move(this->frames.back());
+    this->frames.pop_back();
+
+    if (frame.unknown)
+      copyChildren(frame.element, frame.unknown.get(), true);
+
+    if (!addRequiredElements(frame.element, this->errors))
+      return false;
+
+    if (this->frames.empty())
+      this->done = true;
+    else
+      this->frames.back().element->InsertElement(frame.element);
+    return true;
+  }
+
+  // Documentation inherited.
+  public: bool Text(const std::string &_text, const bool _cdata) override
+  {
+    if (this->kept)
+    {
+      TiXmlText *text = new TiXmlText(_text.c_str());
+      text->SetCDATA(_cdata);
+      this->keptNode->LinkEndChild(text);
+      return true;
+    }
+
+    // Like TiXmlElement::GetText, only text that is the first child node of
+    // an element is its value.
+    Frame &frame = this->frames.back();
+    if (!frame.firstChild)
+      return true;
+    frame.firstChild = false;
+
+    ParamPtr value = frame.element->GetValue();
+    return !value || value->SetFromString(_text);
+  }
+
+  // Documentation inherited.
+  public: bool Comment(const std::string &_value) override
+  {
+    if (this->kept)
+      this->keptNode->LinkEndChild(new TiXmlComment(_value.c_str()));
+    else if (!this->frames.empty())
+      this->frames.back().firstChild = false;
+    return true;
+  }
+
+  // Documentation inherited.
+  public: bool Unknown(const std::string &_value) override
+  {
+    if (this->kept)
+    {
+      TiXmlUnknown *unknown = new TiXmlUnknown;
+      unknown->SetValue(_value.c_str());
+      this->keptNode->LinkEndChild(unknown);
+    }
+    else if (!this->frames.empty())
+    {
+      this->frames.back().firstChild = false;
+    }
+    return true;
+  }
+
+  /// \brief Create an XML element.
+  /// \param[in] _name Name of the element.
+  /// \param[in] _attributes Attributes of the element.
+  /// \return The new element.
+  private: static TiXmlElement *newXmlElement(const std::string &_name,
+               const XmlAttributes &_attributes)
+  {
+    TiXmlElement *xml = new TiXmlElement(_name.c_str());
+    for (const auto &attribute : _attributes)
+      xml->SetAttribute(attribute.first.c_str(), attribute.second.c_str());
+    return xml;
+  }
+
+  /// \brief Start reading an element, like readXml does before it reads
+  /// the children of the element.
+  /// \param[in] _element The element.
+  /// \param[in] _name Name of the XML element.
+  /// \param[in] _attributes Attributes of the XML element.
+  /// \return False if an attribute is not valid or is missing.
+  private: bool StartSdfElement(ElementPtr _element, const std::string &_name,
+               const XmlAttributes &_attributes)
+  {
+    for (const auto &attribute : _attributes)
+    {
+      if (!readAttribute(_element, _name, attribute.first.c_str(),
+                         attribute.second, this->errors))
+      {
+        return false;
+      }
+    }
+
+    if (!checkRequiredAttributes(_element, _name, this->errors))
+      return false;
+
+    this->frames.emplace_back();
+    this->frames.back().element = _element;
+    return true;
+  }
+
+  /// \brief Read a kept subtree once it ends, like readXml reads it.
+  /// \return False if the subtree could not be read.
+  private: bool EndKept()
+  {
+    std::unique_ptr<TiXmlElement> xml = std::move(this->kept);
+    this->keptNode = nullptr;
+    Frame &parent = this->frames.back();
+
+    if (std::string("include") == xml->Value())
+    {
+      std::unordered_map<const TiXmlElement *, IncludedFile> includedFiles;
+      return readInclude(xml.get(), parent.element, includedFiles,
+                         this->errors);
+    }
+
+    if (!this->keptDesc)
+    {
+      // Elements that are not in the description are copied after the
+      // other children, like readXml does.
+      if (!parent.unknown)
+      {
+        parent.unknown.reset(
+            new TiXmlElement(parent.element->GetName().c_str()));
+      }
+      parent.unknown->LinkEndChild(xml.release());
+      return true;
+    }
+
+    ElementPtr element = this->keptDesc->Clone();
+    element->SetParent(parent.element);
+    if (!readXml(xml.get(), element, this->errors))
+      return false;
+    parent.element->InsertElement(element);
+    return true;
+  }
+
+  /// \brief An element that is being read.
+  private: struct Frame
+  {
+    /// \brief The element.
+    ElementPtr element;
+
+    /// \brief True until the first child node of the XML element is read.
+    bool firstChild = true;
+
+    /// \brief Children of the XML element that are not in the description
+    /// of the element, or nullptr if there are none.
+    std::unique_ptr<TiXmlElement> unknown;
+  };
+
+  /// \brief Root element.
+  private: ElementPtr root;
+
+  /// \brief True to stop at documents that are not at the current version.
+  private: bool convert;
+
+  /// \brief Errors that do not stop reading.
+  private: Errors &errors;
+
+  /// \brief Version of the document.
+  private: std::string version;
+
+  /// \brief True once the root element ended.
+  private: bool done = false;
+
+  /// \brief The elements being read, from the root down.
+  private: std::vector<Frame> frames;
+
+  /// \brief Subtree that is kept until it ends, or nullptr.
+  private: std::unique_ptr<TiXmlElement> kept;
+
+  /// \brief Element of the kept subtree that nodes are added to.
+  private: TiXmlNode *keptNode = nullptr;
+
+  /// \brief Description of the root of the kept subtree, or nullptr for an
+  /// <include> element or an element that is not in the description.
+  private: ElementPtr keptDesc;
+};
+
+//////////////////////////////////////////////////
+static bool readFileStream(const std::string &_filename, SDFPtr _sdf,
+    const bool _convert, Errors &_errors)
+{
+  if (!g_streamingParser)
+    return false;
+
+  MappedFile file(_filename);
+  if (!file.Valid())
+    return false;
+
+  normalizeLineBreaks(file);
+  return readSdfStream(file.Data(), _sdf, _filename, _convert, _errors);
+}
+
+//////////////////////////////////////////////////
+static bool readSdfStream(const char *_data, SDFPtr _sdf,
+    const std::string &_source, const bool _convert, Errors &_errors)
+{
+  // The document is read into a copy of the root, which is dropped if it
+  // must be read with TinyXML after all. Roots that were already read are
+  // left to readDoc, which adds to them.
+  if (!g_streamingParser || nullptr == _sdf || nullptr == _sdf->Root() ||
+      _sdf->Root()->GetFirstElement())
+  {
+    return false;
+  }
+
+  // The path is set before the tree is built, since each element copies
+  // it from its parent when it is added.
+  ElementPtr root = _sdf->Root()->Clone();
+  if (_source != "data-string")
+  {
+    root->SetFilePath(_source);
+  }
+
+  Errors errors;
+  ElementStreamBuilder builder(root, _convert, errors);
+  if (!readXmlStream(_data, builder) || !builder.Done())
+    return false;
+
+  _sdf->Root(root);
+  if (_source != "data-string")
+  {
+    _sdf->SetFilePath(_source);
+  }
+
+  if (_sdf->OriginalVersion().empty())
+  {
+    _sdf->SetOriginalVersion(builder.Version());
+  }
+  _errors.insert(_errors.end(), errors.begin(), errors.end());
+  return true;
+}
+
 /////////////////////////////////////////////////
 void addNestedModel(ElementPtr _sdf, ElementPtr _includeSDF)
 {
@@ -1197,6 +2230,7 @@ void addNestedModel(ElementPtr _sdf, ElementPtr _includeSDF)
       std::string elemName = elem->Get<std::string>("name");
       std::string newName =  modelName + "::" + elemName;
       replace[elemName] = newName;
+      elem->GetAttribute("name")->Set(newName);
       if (elem->HasElementDescription("pose"))
       {
         ignition::math::Pose3d offsetPose =
@@ -1215,6 +2249,7 @@ void addNestedModel(ElementPtr _sdf, ElementPtr _includeSDF)
       std::string elemName = elem->Get<std::string>("name");
       std::string newName =  modelName + "::" + elemName;
       replace[elemName] = newName;
+      elem->GetAttribute("name")->Set(newName);
       //   rotate the joint axis because they are model-global
       if (elem->HasElement("axis"))
       {
@@ -1227,20 +2262,9 @@ void addNestedModel(ElementPtr _sdf, ElementPtr _includeSDF)
     elem = elem->GetNextElement();
   }
 
-  std::string str = _includeSDF->ToString("");
-  for (std::map<std::string, std::string>::iterator iter = replace.begin();
-       iter != replace.end(); ++iter)
-  {
-    replace_all(str, std::string("\"") + iter->first + "\"",
-                std::string("\"") + iter->second + "\"");
-    replace_all(str, std::string("'") + iter->first + "'",
-                std::string("'") + iter->second + "'");
-    replace_all(str, std::string(">") + iter->first + "<",
-                std::string(">") + iter->second + "<");
-  }
-
-  _includeSDF->ClearElements();
-  readString(str, _includeSDF);
+  // Rename the references to the links and joints in place, instead of
+  // replacing their names in the text of the model and parsing it again.
+  renameFrameReferences(modelPtr, replace);
 
   elem = _includeSDF->GetElement("model")->GetFirstElement();
   ElementPtr nextElem;
@@ -1569,80 +2593,87 @@ bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem)
 }
 
 //////////////////////////////////////////////////
-bool checkFrameAttachedToGraph(const sdf::Root *_root)
+/// \brief Print the errors found while building and validating a graph.
+/// \param[in] _errors The errors.
+/// \param[in] _validateName Name of the function that validated the graph.
+/// \return True if there are no errors.
+static bool printGraphErrors(const sdf::GraphErrors &_errors,
+                             const std::string &_validateName)
 {
-  bool result = true;
-
-  auto checkModelFrameAttachedToGraph = [](
-      const sdf::Model *_model) -> bool
+  for (auto &error : _errors.build)
   {
-    bool modelResult = true;
-    sdf::FrameAttachedToGraph graph;
-    auto errors = sdf::buildFrameAttachedToGraph(graph, _model);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      modelResult = false;
-    }
-    errors = sdf::validateFrameAttachedToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validateFrameAttachedToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
-  auto checkWorldFrameAttachedToGraph = [](
-      const sdf::World *_world) -> bool
+    std::cerr << "Error: " << error.Message() << std::endl;
+  }
+  for (auto &error : _errors.validate)
   {
-    bool worldResult = true;
-    sdf::FrameAttachedToGraph graph;
-    auto errors = sdf::buildFrameAttachedToGraph(graph, _world);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      worldResult = false;
-    }
-    errors = sdf::validateFrameAttachedToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validateFrameAttachedToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      worldResult = false;
-    }
-    return worldResult;
-  };
+    std::cerr << "Error in " << _validateName << ": "
+              << error.Message()
+              << std::endl;
+  }
+  return _errors.build.empty() && _errors.validate.empty();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the FrameAttachedToGraph of a model or world. The errors
+/// found by Load are used if it built the graph, otherwise the graph is
+/// built and validated here.
+/// \param[in] _scope The model or world.
+/// \return True if the graph is valid.
+template <typename ScopeType>
+static bool checkScopeFrameAttachedToGraph(const ScopeType *_scope)
+{
+  const sdf::GraphErrors *loadedErrors =
+      sdf::LoadedGraphErrors::FrameAttachedTo(_scope);
+  if (loadedErrors)
+    return printGraphErrors(*loadedErrors, "validateFrameAttachedToGraph");
+
+  sdf::FrameAttachedToGraph graph;
+  sdf::GraphErrors errors;
+  errors.build = sdf::buildFrameAttachedToGraph(graph, _scope);
+  errors.validate = sdf::validateFrameAttachedToGraph(graph);
+  return printGraphErrors(errors, "validateFrameAttachedToGraph");
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the PoseRelativeToGraph of a model or world. The errors
+/// found by Load are used if it built the graph, otherwise the graph is
+/// built and validated here.
+/// \param[in] _scope The model or world.
+/// \return True if the graph is valid.
+template <typename ScopeType>
+static bool checkScopePoseRelativeToGraph(const ScopeType *_scope)
+{
+  const sdf::GraphErrors *loadedErrors =
+      sdf::LoadedGraphErrors::PoseRelativeTo(_scope);
+  if (loadedErrors)
+    return printGraphErrors(*loadedErrors, "validatePoseRelativeToGraph");
+
+  sdf::PoseRelativeToGraph graph;
+  sdf::GraphErrors errors;
+  errors.build = sdf::buildPoseRelativeToGraph(graph, _scope);
+  errors.validate = sdf::validatePoseRelativeToGraph(graph);
+  return printGraphErrors(errors, "validatePoseRelativeToGraph");
+}
+
+//////////////////////////////////////////////////
+bool checkFrameAttachedToGraph(const sdf::Root *_root)
+{
+  bool result = true;
 
   for (uint64_t m = 0; m < _root->ModelCount(); ++m)
   {
     auto model = _root->ModelByIndex(m);
-    result = checkModelFrameAttachedToGraph(model) && result;
+    result = checkScopeFrameAttachedToGraph(model) && result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
   {
     auto world = _root->WorldByIndex(w);
-    result = checkWorldFrameAttachedToGraph(world) && result;
+    result = checkScopeFrameAttachedToGraph(world) && result;
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelFrameAttachedToGraph(model) && result;
+      result = checkScopeFrameAttachedToGraph(model) && result;
     }
   }
 
@@ -1654,76 +2685,20 @@ bool checkPoseRelativeToGraph(const sdf::Root *_root)
 {
   bool result = true;
 
-  auto checkModelPoseRelativeToGraph = [](
-      const sdf::Model *_model) -> bool
-  {
-    bool modelResult = true;
-    sdf::PoseRelativeToGraph graph;
-    auto errors = sdf::buildPoseRelativeToGraph(graph, _model);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      modelResult = false;
-    }
-    errors = sdf::validatePoseRelativeToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validatePoseRelativeToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
-  auto checkWorldPoseRelativeToGraph = [](
-      const sdf::World *_world) -> bool
-  {
-    bool worldResult = true;
-    sdf::PoseRelativeToGraph graph;
-    auto errors = sdf::buildPoseRelativeToGraph(graph, _world);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error: " << error.Message() << std::endl;
-      }
-      worldResult = false;
-    }
-    errors = sdf::validatePoseRelativeToGraph(graph);
-    if (!errors.empty())
-    {
-      for (auto &error : errors)
-      {
-        std::cerr << "Error in validatePoseRelativeToGraph: "
-                  << error.Message()
-                  << std::endl;
-      }
-      worldResult = false;
-    }
-    return worldResult;
-  };
-
   for (uint64_t m = 0; m < _root->ModelCount(); ++m)
   {
     auto model = _root->ModelByIndex(m);
-    result = checkModelPoseRelativeToGraph(model) && result;
+    result = checkScopePoseRelativeToGraph(model) && result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
   {
     auto world = _root->WorldByIndex(w);
-    result = checkWorldPoseRelativeToGraph(world) && result;
+    result = checkScopePoseRelativeToGraph(world) && result;
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelPoseRelativeToGraph(model) && result;
+      result = checkScopePoseRelativeToGraph(model) && result;
     }
   }
 
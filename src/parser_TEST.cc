@@ -16,8 +16,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
 #include "sdf/parser.hh"
 #include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/Root.hh"
 #include "test_config.h"
 
 /////////////////////////////////////////////////
@@ -109,6 +114,58 @@ TEST(Parser, readFileConversions)
   }
 }
 
+/////////////////////////////////////////////////
+/// Files are read with their line breaks normalized, whether they use
+/// "\r\n" or "\r".
+TEST(Parser, readFileCarriageReturns)
+{
+  const std::string path =
+    std::string(PROJECT_BINARY_DIR) + "/parser_carriage_returns.sdf";
+  {
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    file << "<?xml version='1.0'?>\r\n"
+         << "<sdf version='1.7'>\r\n"
+         << "  <model name='crlf'>\r"
+         << "    <link name='link'/>\r\n"
+         << "  </model>\r\n"
+         << "</sdf>\r\n";
+  }
+
+  sdf::SDFPtr sdf = InitSDF();
+  EXPECT_TRUE(sdf::readFile(path, sdf));
+  sdf::ElementPtr model = sdf->Root()->GetElement("model");
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ("crlf", model->Get<std::string>("name"));
+  EXPECT_EQ(std::string::npos, sdf->ToString().find('\r'));
+
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(Parser, initCachedSpec)
+{
+  sdf::SDFPtr sdf1 = InitSDF();
+  sdf::SDFPtr sdf2 = InitSDF();
+  ASSERT_NE(nullptr, sdf1->Root());
+  ASSERT_NE(nullptr, sdf2->Root());
+  EXPECT_NE(sdf1->Root(), sdf2->Root());
+  EXPECT_EQ("sdf", sdf1->Root()->GetName());
+  EXPECT_EQ("1.7", sdf1->Root()->Get<std::string>("version"));
+
+  // Modifying one copy of the spec must not affect later copies.
+  sdf1->Root()->GetAttribute("version")->SetFromString("1.0");
+  sdf1->Root()->AddElement("model");
+  EXPECT_EQ("1.7", sdf2->Root()->Get<std::string>("version"));
+  EXPECT_FALSE(sdf2->Root()->HasElement("model"));
+  EXPECT_EQ("1.7", InitSDF()->Root()->Get<std::string>("version"));
+
+  // The spec is cached per version.
+  sdf::SDF::Version("1.6");
+  EXPECT_EQ("1.6", InitSDF()->Root()->Get<std::string>("version"));
+  sdf::SDF::Version(SDF_VERSION);
+  EXPECT_EQ("1.7", InitSDF()->Root()->Get<std::string>("version"));
+}
+
 /////////////////////////////////////////////////
 TEST(Parser, NameUniqueness)
 {
@@ -238,6 +295,35 @@ TEST(Parser, NameUniqueness)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Parser, CheckGraphsAfterLoad)
+{
+  const std::string validFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "world_frame_relative_to.sdf");
+  sdf::Root validRoot;
+  EXPECT_TRUE(validRoot.Load(validFile).empty());
+  EXPECT_TRUE(sdf::checkFrameAttachedToGraph(&validRoot));
+  EXPECT_TRUE(sdf::checkPoseRelativeToGraph(&validRoot));
+
+  // The graph errors found by Load are reported by the checks.
+  const std::string invalidFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_invalid_frame_relative_to.sdf");
+  sdf::Root invalidRoot;
+  EXPECT_FALSE(invalidRoot.Load(invalidFile).empty());
+  EXPECT_FALSE(sdf::checkPoseRelativeToGraph(&invalidRoot));
+
+  // Static models have no attached-to graph from Load, so the check builds
+  // it.
+  const std::string staticFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "empty.sdf");
+  sdf::Root staticRoot;
+  EXPECT_TRUE(staticRoot.Load(staticFile).empty());
+  EXPECT_TRUE(sdf::checkFrameAttachedToGraph(&staticRoot));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
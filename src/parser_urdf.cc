@@ -19,6 +19,7 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -35,6 +36,8 @@
 #include "sdf/parser_urdf.hh"
 #include "sdf/sdf.hh"
 
+#include "Utils.hh"
+
 using namespace sdf;
 
 namespace sdf {
@@ -56,6 +59,10 @@ bool g_initialRobotPoseValid = false;
 std::set<std::string> g_fixedJointsTransformedInRevoluteJoints;
 std::set<std::string> g_fixedJointsTransformedInFixedJoints;
 
+/// \brief Serializes URDF conversions, since they keep their state in the
+/// globals above.
+static std::mutex g_conversionMutex;
+
 
 /// \brief parser xml string into urdf::Vector3
 /// \param[in] _key XML key where vector3 value might be
@@ -204,6 +211,13 @@ void ReduceSDFExtensionFrameReplace(SDFExtensionPtr _ge,
 /// get value from <key value="..."/> pair and return it as string
 std::string GetKeyValueAsString(TiXmlElement* _elem);
 
+/// \brief get value from <key value="..."/> pair and parse it as a double,
+/// always with '.' as the decimal separator
+/// \param[in] _elem pointer to xml element
+/// \return the value
+/// \throws std::invalid_argument if the value is not a number
+double GetKeyValueAsDouble(TiXmlElement *_elem);
+
 /// \brief append key value pair to the end of the xml element
 /// \param[in] _elem pointer to xml element
 /// \param[in] _key string containing key to add to xml element
@@ -274,7 +288,7 @@ urdf::Vector3 ParseVector3(const std::string &_str, double _scale)
     {
       try
       {
-        vals.push_back(_scale * std::stod(pieces[i]));
+        vals.push_back(_scale * sdf::parseFloatingPoint<double>(pieces[i]));
       }
       catch(std::invalid_argument &)
       {
@@ -1069,9 +1083,9 @@ std::string lowerStr(const std::string &_str)
 ////////////////////////////////////////////////////////////////////////////////
 URDF2SDF::URDF2SDF()
 {
-  // default options
-  g_enforceLimits = true;
-  g_reduceFixedJoints = true;
+  // The default options are set in InitModelString, while holding
+  // g_conversionMutex, so that constructing a converter does not race with
+  // a conversion running on another thread.
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1170,6 +1184,12 @@ std::string GetKeyValueAsString(TiXmlElement* _elem)
   return valueStr;
 }
 
+/////////////////////////////////////////////////
+double GetKeyValueAsDouble(TiXmlElement *_elem)
+{
+  return sdf::parseFloatingPoint<double>(GetKeyValueAsString(_elem));
+}
+
 /////////////////////////////////////////////////
 void ParseRobotOrigin(TiXmlDocument &_urdfXml)
 {
@@ -1345,27 +1365,27 @@ void URDF2SDF::ParseSDFExtension(TiXmlDocument &_urdfXml)
       else if (childElem->ValueStr() == "dampingFactor")
       {
         sdf->isDampingFactor = true;
-        sdf->dampingFactor = std::stod(GetKeyValueAsString(childElem));
+        sdf->dampingFactor = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "maxVel")
       {
         sdf->isMaxVel = true;
-        sdf->maxVel = std::stod(GetKeyValueAsString(childElem));
+        sdf->maxVel = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "minDepth")
       {
         sdf->isMinDepth = true;
-        sdf->minDepth = std::stod(GetKeyValueAsString(childElem));
+        sdf->minDepth = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "mu1")
       {
         sdf->isMu1 = true;
-        sdf->mu1 = std::stod(GetKeyValueAsString(childElem));
+        sdf->mu1 = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "mu2")
       {
         sdf->isMu2 = true;
-        sdf->mu2 = std::stod(GetKeyValueAsString(childElem));
+        sdf->mu2 = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "fdir1")
       {
@@ -1374,12 +1394,12 @@ void URDF2SDF::ParseSDFExtension(TiXmlDocument &_urdfXml)
       else if (childElem->ValueStr() == "kp")
       {
         sdf->isKp = true;
-        sdf->kp = std::stod(GetKeyValueAsString(childElem));
+        sdf->kp = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "kd")
       {
         sdf->isKd = true;
-        sdf->kd = std::stod(GetKeyValueAsString(childElem));
+        sdf->kd = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "selfCollide")
       {
@@ -1405,32 +1425,32 @@ void URDF2SDF::ParseSDFExtension(TiXmlDocument &_urdfXml)
       else if (childElem->ValueStr() == "laserRetro")
       {
         sdf->isLaserRetro = true;
-        sdf->laserRetro = std::stod(GetKeyValueAsString(childElem));
+        sdf->laserRetro = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "springReference")
       {
         sdf->isSpringReference = true;
-        sdf->springReference = std::stod(GetKeyValueAsString(childElem));
+        sdf->springReference = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "springStiffness")
       {
         sdf->isSpringStiffness = true;
-        sdf->springStiffness = std::stod(GetKeyValueAsString(childElem));
+        sdf->springStiffness = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "stopCfm")
       {
         sdf->isStopCfm = true;
-        sdf->stopCfm = std::stod(GetKeyValueAsString(childElem));
+        sdf->stopCfm = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "stopErp")
       {
         sdf->isStopErp = true;
-        sdf->stopErp = std::stod(GetKeyValueAsString(childElem));
+        sdf->stopErp = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "fudgeFactor")
       {
         sdf->isFudgeFactor = true;
-        sdf->fudgeFactor = std::stod(GetKeyValueAsString(childElem));
+        sdf->fudgeFactor = GetKeyValueAsDouble(childElem);
       }
       else if (childElem->ValueStr() == "provideFeedback")
       {
@@ -3155,7 +3175,11 @@ void CreateVisual(TiXmlElement *_elem, urdf::LinkConstSharedPtr _link,
 TiXmlDocument URDF2SDF::InitModelString(const std::string &_urdfStr,
                                         bool _enforceLimits)
 {
+  std::lock_guard<std::mutex> lock(g_conversionMutex);
+
+  // default options
   g_enforceLimits = _enforceLimits;
+  g_reduceFixedJoints = true;
 
   // Create a RobotModel from string
   urdf::ModelInterfaceSharedPtr robotModel = urdf::parseURDF(_urdfStr);
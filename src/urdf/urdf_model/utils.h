@@ -37,6 +37,9 @@
 #ifndef URDF_INTERFACE_UTILS_H
 #define URDF_INTERFACE_UTILS_H
 
+#include <locale>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -62,6 +65,39 @@ void split_string(std::vector<std::string> &result,
   }
 }
 
+// Locale independent replacement for std::stod and std::stof. These parse
+// with the current C locale, so "1.5" is read as 1 when the decimal point
+// is a comma, while URDF values always use a point. Like std::stod, leading
+// whitespace and trailing characters are ignored, and std::invalid_argument
+// is thrown if no number can be parsed.
+template<typename T>
+inline
+T strToFloatingPoint(const std::string &input)
+{
+  std::istringstream stream(input);
+  stream.imbue(std::locale::classic());
+  T value;
+  stream >> value;
+  if (stream.fail())
+  {
+    throw std::invalid_argument("Unable to parse [" + input +
+                                "] as a floating point number");
+  }
+  return value;
+}
+
+inline
+double strToDouble(const std::string &input)
+{
+  return strToFloatingPoint<double>(input);
+}
+
+inline
+float strToFloat(const std::string &input)
+{
+  return strToFloatingPoint<float>(input);
+}
+
 }
 
 #endif
@@ -111,7 +111,7 @@ bool parseCamera(Camera &camera, TiXmlElement* config)
     {
       try
       {
-        camera.hfov = std::stod(hfov_char);
+        camera.hfov = urdf::strToDouble(hfov_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -132,7 +132,7 @@ bool parseCamera(Camera &camera, TiXmlElement* config)
     {
       try
       {
-        camera.near = std::stod(near_char);
+        camera.near = urdf::strToDouble(near_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -153,7 +153,7 @@ bool parseCamera(Camera &camera, TiXmlElement* config)
     {
       try
       {
-        camera.far = std::stod(far_char);
+        camera.far = urdf::strToDouble(far_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -207,7 +207,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.horizontal_resolution = std::stod(resolution_char);
+        ray.horizontal_resolution = urdf::strToDouble(resolution_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -224,7 +224,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.horizontal_min_angle = std::stod(min_angle_char);
+        ray.horizontal_min_angle = urdf::strToDouble(min_angle_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -241,7 +241,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.horizontal_max_angle = std::stod(max_angle_char);
+        ray.horizontal_max_angle = urdf::strToDouble(max_angle_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -279,7 +279,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.vertical_resolution = std::stod(resolution_char);
+        ray.vertical_resolution = urdf::strToDouble(resolution_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -296,7 +296,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.vertical_min_angle = std::stod(min_angle_char);
+        ray.vertical_min_angle = urdf::strToDouble(min_angle_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -313,7 +313,7 @@ bool parseRay(Ray &ray, TiXmlElement* config)
     {
       try
       {
-        ray.vertical_max_angle = std::stod(max_angle_char);
+        ray.vertical_max_angle = urdf::strToDouble(max_angle_char);
       }
       catch (std::invalid_argument &e)
       {
@@ -0,0 +1,428 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+const auto g_testPath = sdf::filesystem::append(PROJECT_SOURCE_PATH, "test");
+const auto g_outputPath = sdf::filesystem::append(PROJECT_BINARY_DIR, "test",
+    "integration");
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  if (_input == "cached_model")
+    return sdf::filesystem::append(g_outputPath, "cached_model");
+  return sdf::filesystem::append(g_testPath, "integration", "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _contents Contents of the file.
+void writeFile(const std::string &_path, const std::string &_contents)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  file << _contents;
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect two params to be the same.
+/// \param[in] _expected The expected param.
+/// \param[in] _actual The param to check.
+void expectSameParam(const sdf::Param &_expected, const sdf::Param &_actual)
+{
+  EXPECT_EQ(_expected.GetKey(), _actual.GetKey());
+  EXPECT_EQ(_expected.GetTypeName(), _actual.GetTypeName());
+  EXPECT_EQ(_expected.GetRequired(), _actual.GetRequired());
+  EXPECT_EQ(_expected.GetSet(), _actual.GetSet());
+  EXPECT_EQ(_expected.GetDescription(), _actual.GetDescription());
+  EXPECT_EQ(_expected.GetAsString(), _actual.GetAsString());
+  EXPECT_EQ(_expected.GetDefaultAsString(), _actual.GetDefaultAsString());
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect two elements and their children to be the same, including
+/// the parts that are not printed by Element::ToString.
+/// \param[in] _expected The expected element.
+/// \param[in] _actual The element to check.
+void expectSameElement(const sdf::ElementPtr &_expected,
+                       const sdf::ElementPtr &_actual)
+{
+  ASSERT_NE(nullptr, _actual);
+  EXPECT_EQ(_expected->GetName(), _actual->GetName());
+  EXPECT_EQ(_expected->GetRequired(), _actual->GetRequired());
+  EXPECT_EQ(_expected->GetDescription(), _actual->GetDescription());
+  EXPECT_EQ(_expected->GetCopyChildren(), _actual->GetCopyChildren());
+  EXPECT_EQ(_expected->ReferenceSDF(), _actual->ReferenceSDF());
+  EXPECT_EQ(_expected->GetInclude(), _actual->GetInclude());
+  EXPECT_EQ(_expected->FilePath(), _actual->FilePath());
+  EXPECT_EQ(_expected->OriginalVersion(), _actual->OriginalVersion());
+
+  ASSERT_EQ(_expected->GetAttributeCount(), _actual->GetAttributeCount());
+  for (unsigned int i = 0; i < _expected->GetAttributeCount(); ++i)
+    expectSameParam(*_expected->GetAttribute(i), *_actual->GetAttribute(i));
+
+  ASSERT_EQ(nullptr == _expected->GetValue(), nullptr == _actual->GetValue());
+  if (_expected->GetValue())
+    expectSameParam(*_expected->GetValue(), *_actual->GetValue());
+
+  // Element descriptions are shared with the spec, so they are the same
+  // objects.
+  ASSERT_EQ(_expected->GetElementDescriptionCount(),
+            _actual->GetElementDescriptionCount());
+  for (unsigned int i = 0; i < _expected->GetElementDescriptionCount(); ++i)
+  {
+    EXPECT_EQ(_expected->GetElementDescription(i),
+              _actual->GetElementDescription(i));
+  }
+
+  sdf::ElementPtr expectedChild = _expected->GetFirstElement();
+  sdf::ElementPtr actualChild = _actual->GetFirstElement();
+  for (; expectedChild; expectedChild = expectedChild->GetNextElement(),
+       actualChild = actualChild->GetNextElement())
+  {
+    expectSameElement(expectedChild, actualChild);
+    EXPECT_EQ(_actual, actualChild->GetParent());
+  }
+  EXPECT_EQ(nullptr, actualChild);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the SDF files in a directory and its subdirectories.
+/// \param[in] _dir Directory to search.
+/// \param[out] _files The paths of the files found.
+void findSdfFiles(const std::string &_dir, std::vector<std::string> &_files)
+{
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(_dir); dirIter != endIter; ++dirIter)
+  {
+    const std::string path = *dirIter;
+    if (sdf::filesystem::is_directory(path))
+    {
+      findSdfFiles(path, _files);
+    }
+    else if (path.size() > 4 && path.compare(path.size() - 4, 4, ".sdf") == 0)
+    {
+      _files.push_back(path);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Every test file that can be read is loaded from a binary cache file
+/// with the same elements, params and descriptions.
+TEST(BinaryCache, SameAsXml)
+{
+  sdf::setFindCallback(findFileCb);
+
+  std::vector<std::string> files;
+  findSdfFiles(sdf::filesystem::append(g_testPath, "integration"), files);
+  findSdfFiles(sdf::filesystem::append(g_testPath, "sdf"), files);
+  ASSERT_LT(10u, files.size());
+
+  const std::string cachePath =
+    sdf::filesystem::append(g_outputPath, "binary_cache.sdfcache");
+
+  for (const std::string &file : files)
+  {
+    sdf::SDFPtr parsed(new sdf::SDF());
+    sdf::init(parsed);
+    sdf::Errors errors;
+    if (!sdf::readFile(file, parsed, errors))
+      continue;
+
+    ASSERT_TRUE(sdf::writeBinaryCache(cachePath, parsed)) << file;
+
+    sdf::SDFPtr cached(new sdf::SDF());
+    sdf::init(cached);
+    ASSERT_TRUE(sdf::readBinaryCache(cachePath, cached)) << file;
+
+    SCOPED_TRACE(file);
+    EXPECT_EQ(parsed->FilePath(), cached->FilePath());
+    EXPECT_EQ(parsed->OriginalVersion(), cached->OriginalVersion());
+    EXPECT_EQ(parsed->Root()->ToString(""), cached->Root()->ToString(""));
+    expectSameElement(parsed->Root(), cached->Root());
+  }
+
+  std::remove(cachePath.c_str());
+}
+
+/////////////////////////////////////////////////
+/// readFile writes a cache file next to the file it reads, and reads it
+/// instead of the file until the file changes.
+TEST(BinaryCache, Sidecar)
+{
+  const std::string worldFile =
+    sdf::filesystem::append(g_outputPath, "binary_cache_world.sdf");
+  const std::string cacheFile = worldFile + ".sdfcache";
+  writeFile(worldFile, "<sdf version='" SDF_VERSION "'>"
+      "<world name='default'>"
+      "<model name='parent'><link name='link'/>"
+      "<model name='nested'><link name='link'/></model></model>"
+      "<plugin name='plugin' filename='libplugin.so'><gain>2</gain></plugin>"
+      "</world></sdf>");
+  std::remove(cacheFile.c_str());
+
+  sdf::setBinaryCache(true);
+
+  // The first read writes the cache file.
+  sdf::SDFPtr parsed(new sdf::SDF());
+  sdf::init(parsed);
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::readFile(worldFile, parsed, errors));
+  EXPECT_TRUE(errors.empty());
+  EXPECT_TRUE(sdf::filesystem::exists(cacheFile));
+
+  // The second read gives the same document.
+  sdf::SDFPtr cached(new sdf::SDF());
+  sdf::init(cached);
+  ASSERT_TRUE(sdf::readFile(worldFile, cached, errors));
+  EXPECT_TRUE(errors.empty());
+  expectSameElement(parsed->Root(), cached->Root());
+  EXPECT_NE(nullptr, cached->Root()->GetElement("world")->GetElement("model"));
+
+  // A change to the file makes the cache out of date, until the file is
+  // read again.
+  sdf::SDFPtr valid(new sdf::SDF());
+  sdf::init(valid);
+  EXPECT_TRUE(sdf::readBinaryCache(cacheFile, valid));
+
+  {
+    std::ofstream file(worldFile, std::ios::out | std::ios::app);
+    file << "\n";
+  }
+
+  sdf::SDFPtr outOfDate(new sdf::SDF());
+  sdf::init(outOfDate);
+  EXPECT_FALSE(sdf::readBinaryCache(cacheFile, outOfDate));
+  EXPECT_EQ(nullptr, outOfDate->Root()->GetFirstElement());
+
+  sdf::SDFPtr reread(new sdf::SDF());
+  sdf::init(reread);
+  EXPECT_TRUE(sdf::readFile(worldFile, reread, errors));
+  expectSameElement(parsed->Root(), reread->Root());
+  EXPECT_TRUE(sdf::readBinaryCache(cacheFile, valid));
+
+  sdf::setBinaryCache(false);
+  std::remove(cacheFile.c_str());
+  std::remove(worldFile.c_str());
+}
+
+/////////////////////////////////////////////////
+/// Files with <include> elements are not cached, since the uri of an
+/// include can resolve to another model without any file changing. The
+/// model file read for the include is cached, along with its model.config.
+TEST(BinaryCache, Includes)
+{
+  sdf::setFindCallback(findFileCb);
+
+  const std::string modelDir =
+    sdf::filesystem::append(g_outputPath, "cached_model");
+  sdf::filesystem::create_directory(modelDir);
+  const std::string modelConfig =
+    sdf::filesystem::append(modelDir, "model.config");
+  const std::string modelFile = sdf::filesystem::append(modelDir, "model.sdf");
+  const std::string modelCacheFile = modelFile + ".sdfcache";
+  writeFile(modelConfig, "<?xml version='1.0'?><model><name>cached_model"
+      "</name><sdf version='" SDF_VERSION "'>model.sdf</sdf></model>");
+  writeFile(modelFile, "<sdf version='" SDF_VERSION "'>"
+      "<model name='cached_model'><link name='link'/></model></sdf>");
+  std::remove(modelCacheFile.c_str());
+
+  const std::string worldFile =
+    sdf::filesystem::append(g_outputPath, "binary_cache_include.sdf");
+  const std::string cacheFile = worldFile + ".sdfcache";
+  writeFile(worldFile, "<sdf version='" SDF_VERSION "'>"
+      "<world name='default'>"
+      "<include><uri>cached_model</uri><pose>1 2 3 0 0 0</pose></include>"
+      "</world></sdf>");
+  std::remove(cacheFile.c_str());
+
+  sdf::setBinaryCache(true);
+
+  sdf::SDFPtr parsed(new sdf::SDF());
+  sdf::init(parsed);
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::readFile(worldFile, parsed, errors));
+  EXPECT_TRUE(errors.empty());
+  EXPECT_FALSE(sdf::filesystem::exists(cacheFile));
+  EXPECT_TRUE(sdf::filesystem::exists(modelCacheFile));
+
+  // A change to the model file or its model.config makes the cache of the
+  // model file out of date.
+  for (const std::string &changed : {modelFile, modelConfig})
+  {
+    sdf::SDFPtr valid(new sdf::SDF());
+    sdf::init(valid);
+    EXPECT_TRUE(sdf::readBinaryCache(modelCacheFile, valid)) << changed;
+
+    {
+      std::ofstream file(changed, std::ios::out | std::ios::app);
+      file << "\n";
+    }
+
+    sdf::SDFPtr outOfDate(new sdf::SDF());
+    sdf::init(outOfDate);
+    EXPECT_FALSE(sdf::readBinaryCache(modelCacheFile, outOfDate)) << changed;
+
+    sdf::SDFPtr reread(new sdf::SDF());
+    sdf::init(reread);
+    EXPECT_TRUE(sdf::readFile(worldFile, reread, errors)) << changed;
+    expectSameElement(parsed->Root(), reread->Root());
+    EXPECT_FALSE(sdf::filesystem::exists(cacheFile));
+  }
+
+  sdf::setBinaryCache(false);
+  std::remove(modelCacheFile.c_str());
+  std::remove(worldFile.c_str());
+  std::remove(modelFile.c_str());
+  std::remove(modelConfig.c_str());
+}
+
+/////////////////////////////////////////////////
+/// Cache files are written in the directory set by setBinaryCacheDirectory
+/// instead of next to the files read.
+TEST(BinaryCache, CacheDirectory)
+{
+  const std::string cacheDir =
+    sdf::filesystem::append(g_outputPath, "binary_cache_dir");
+  sdf::filesystem::create_directory(cacheDir);
+
+  // Two files with the same name in different directories.
+  const std::vector<std::string> worldNames = {"binary_cache_a",
+                                               "binary_cache_b"};
+  std::vector<std::string> worldFiles;
+  for (const std::string &dir : worldNames)
+  {
+    const std::string worldDir = sdf::filesystem::append(g_outputPath, dir);
+    sdf::filesystem::create_directory(worldDir);
+    worldFiles.push_back(sdf::filesystem::append(worldDir, "world.sdf"));
+    writeFile(worldFiles.back(), "<sdf version='" SDF_VERSION "'>"
+        "<world name='" + dir + "'/></sdf>");
+  }
+
+  EXPECT_EQ("", sdf::binaryCacheDirectory());
+  sdf::setBinaryCache(true);
+  sdf::setBinaryCacheDirectory(cacheDir);
+  EXPECT_EQ(cacheDir, sdf::binaryCacheDirectory());
+
+  // Each file is read twice, and the second read is from its own cache
+  // file.
+  for (int i = 0; i < 2; ++i)
+  {
+    for (size_t w = 0; w < worldFiles.size(); ++w)
+    {
+      sdf::SDFPtr sdfParsed(new sdf::SDF());
+      sdf::init(sdfParsed);
+      sdf::Errors errors;
+      ASSERT_TRUE(sdf::readFile(worldFiles[w], sdfParsed, errors));
+      EXPECT_TRUE(errors.empty());
+      EXPECT_EQ(worldNames[w], sdfParsed->Root()->GetElement("world")
+          ->Get<std::string>("name"));
+      EXPECT_FALSE(sdf::filesystem::exists(worldFiles[w] + ".sdfcache"));
+    }
+  }
+
+  std::vector<std::string> cacheFiles;
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(cacheDir); dirIter != endIter;
+       ++dirIter)
+  {
+    cacheFiles.push_back(*dirIter);
+  }
+  EXPECT_EQ(2u, cacheFiles.size());
+
+  sdf::setBinaryCacheDirectory("");
+  sdf::setBinaryCache(false);
+  for (const std::string &file : cacheFiles)
+    std::remove(file.c_str());
+  for (const std::string &file : worldFiles)
+    std::remove(file.c_str());
+}
+
+/////////////////////////////////////////////////
+/// Files with errors are not cached, and cache files that are not valid
+/// are not read.
+TEST(BinaryCache, NotCached)
+{
+  const std::string worldFile =
+    sdf::filesystem::append(g_outputPath, "binary_cache_error.sdf");
+  const std::string cacheFile = worldFile + ".sdfcache";
+  writeFile(worldFile, "<sdf version='" SDF_VERSION "'>"
+      "<model><link name='link'/></model>"
+      "</sdf>");
+  std::remove(cacheFile.c_str());
+
+  sdf::setBinaryCache(true);
+  sdf::SDFPtr parsed(new sdf::SDF());
+  sdf::init(parsed);
+  sdf::Errors errors;
+  sdf::readFile(worldFile, parsed, errors);
+  EXPECT_FALSE(errors.empty());
+  EXPECT_FALSE(sdf::filesystem::exists(cacheFile));
+  sdf::setBinaryCache(false);
+
+  // Missing file.
+  sdf::SDFPtr cached(new sdf::SDF());
+  sdf::init(cached);
+  EXPECT_FALSE(sdf::readBinaryCache(cacheFile, cached));
+
+  // Truncated and corrupt files.
+  writeFile(worldFile, "<sdf version='" SDF_VERSION "'>"
+      "<model name='m'><link name='link'/></model></sdf>");
+  parsed = sdf::readFile(worldFile);
+  ASSERT_NE(nullptr, parsed);
+  ASSERT_TRUE(sdf::writeBinaryCache(cacheFile, parsed));
+  std::string contents;
+  {
+    std::ifstream file(cacheFile, std::ios::in | std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+  }
+  ASSERT_TRUE(sdf::readBinaryCache(cacheFile, cached));
+
+  for (size_t size : {contents.size() / 2, contents.size() - 1})
+  {
+    writeFile(cacheFile, contents.substr(0, size));
+    sdf::SDFPtr truncated(new sdf::SDF());
+    sdf::init(truncated);
+    EXPECT_FALSE(sdf::readBinaryCache(cacheFile, truncated)) << size;
+    EXPECT_EQ(nullptr, truncated->Root()->GetFirstElement());
+  }
+
+  writeFile(cacheFile, "not a cache file");
+  sdf::SDFPtr corrupt(new sdf::SDF());
+  sdf::init(corrupt);
+  EXPECT_FALSE(sdf::readBinaryCache(cacheFile, corrupt));
+
+  // Documents are only read into SDF objects without elements.
+  writeFile(cacheFile, contents);
+  EXPECT_FALSE(sdf::readBinaryCache(cacheFile, cached));
+
+  std::remove(cacheFile.c_str());
+  std::remove(worldFile.c_str());
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+const auto g_testPath = sdf::filesystem::append(PROJECT_SOURCE_PATH, "test");
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(g_testPath, "integration", "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// Parse a file with a fresh Root.
+/// \param[in] _file File to parse.
+/// \param[out] _result The parsed file, printed as a string.
+/// \return True if there were no errors.
+bool loadFile(const std::string &_file, std::string &_result)
+{
+  sdf::Root root;
+  sdf::Errors errors = root.Load(_file);
+  if (!errors.empty() || !root.Element())
+    return false;
+
+  _result = root.Element()->ToString("");
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// Independent files parsed on several threads at once should give the same
+/// result as parsing them on one thread. Run this with a ThreadSanitizer
+/// build (CMAKE_BUILD_TYPE=ThreadSanitizer) to check for data races.
+TEST(ConcurrentParsing, RootLoad)
+{
+  sdf::setFindCallback(findFileCb);
+
+  // SDF files of the current and older versions, and a file with includes
+  // found through the callback.
+  const std::vector<std::string> files =
+  {
+    sdf::filesystem::append(g_testPath, "sdf", "double_pendulum.sdf"),
+    sdf::filesystem::append(g_testPath, "sdf", "includes.sdf"),
+    sdf::filesystem::append(g_testPath, "sdf", "joint_complete.sdf"),
+    sdf::filesystem::append(g_testPath, "sdf", "model_link_relative_to.sdf"),
+  };
+
+  std::vector<std::string> expected(files.size());
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    ASSERT_TRUE(loadFile(files[i], expected[i])) << files[i];
+  }
+
+  const int threadCount = 8;
+  const int iterations = 10;
+  std::atomic<int> failures(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([t, &files, &expected, &failures]()
+    {
+      for (int i = 0; i < iterations; ++i)
+      {
+        // Start each thread on a different file.
+        const size_t index = (t + i) % files.size();
+        std::string result;
+        if (!loadFile(files[index], result) || result != expected[index])
+          ++failures;
+      }
+    });
+  }
+
+  // Register paths and read the version while the files are parsed.
+  threads.emplace_back([&failures]()
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      sdf::addURIPath("concurrent://", g_testPath);
+      if (sdf::findFile("concurrent://sdf/empty.sdf").empty() ||
+          sdf::SDF::Version() != SDF_VERSION)
+      {
+        ++failures;
+      }
+    }
+  });
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0, failures);
+}
+
+/////////////////////////////////////////////////
+/// SDF and URDF files read on several threads at once.
+TEST(ConcurrentParsing, ReadFile)
+{
+  const std::vector<std::string> files =
+  {
+    sdf::filesystem::append(g_testPath, "sdf", "model_link_relative_to.sdf"),
+    sdf::filesystem::append(g_testPath, "integration",
+                            "fixed_joint_reduction.urdf"),
+  };
+
+  const int threadCount = 8;
+  std::atomic<int> failures(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([t, &files, &failures]()
+    {
+      for (int i = 0; i < 20; ++i)
+      {
+        sdf::SDFPtr sdfParsed(new sdf::SDF());
+        sdf::init(sdfParsed);
+        if (!sdf::readFile(files[(t + i) % files.size()], sdfParsed) ||
+            !sdfParsed->Root()->HasElement("model"))
+        {
+          ++failures;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0, failures);
+}
@@ -16,7 +16,9 @@
 */
 
 #include <array>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -394,3 +396,76 @@ TEST(ConverterIntegration, Pose_16_to_17)
   EXPECT_NE(nullptr, jointLinkPoseElem->Attribute("relative_to"));
   EXPECT_STREQ("parent", jointLinkPoseElem->Attribute("relative_to"));
 }
+
+/////////////////////////////////////////////////
+/// \brief Find the SDF files in a directory and its subdirectories.
+/// \param[in] _dir Directory to search.
+/// \param[out] _files The paths of the files found.
+void findSdfFiles(const std::string &_dir, std::vector<std::string> &_files)
+{
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(_dir); dirIter != endIter; ++dirIter)
+  {
+    const std::string path = *dirIter;
+    if (sdf::filesystem::is_directory(path))
+    {
+      findSdfFiles(path, _files);
+    }
+    else if (path.size() > 4 && path.compare(path.size() - 4, 4, ".sdf") == 0)
+    {
+      _files.push_back(path);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Converting an old document straight to the latest version, which fuses
+/// the rules of successive versions, gives the same result as converting
+/// it one version at a time.
+TEST(ConverterIntegration, FusedConversionMatchesSteps)
+{
+  const std::vector<std::string> versions =
+    {"1.2", "1.3", "1.4", "1.5", "1.6", "1.7"};
+
+  std::vector<std::string> files;
+  findSdfFiles(sdf::filesystem::append(PROJECT_SOURCE_PATH, "test",
+      "integration"), files);
+  findSdfFiles(sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf"),
+      files);
+
+  int converted = 0;
+  for (const std::string &file : files)
+  {
+    TiXmlDocument fusedDoc;
+    if (!fusedDoc.LoadFile(file))
+      continue;
+    TiXmlElement *sdfElem = fusedDoc.FirstChildElement("sdf");
+    if (!sdfElem || !sdfElem->Attribute("version"))
+      continue;
+    const std::string version = sdfElem->Attribute("version");
+    if (version >= SDF_VERSION)
+      continue;
+
+    TiXmlDocument steppedDoc;
+    ASSERT_TRUE(steppedDoc.LoadFile(file)) << file;
+
+    EXPECT_TRUE(sdf::Converter::Convert(&fusedDoc, SDF_VERSION, true))
+      << file;
+    for (const std::string &stepVersion : versions)
+    {
+      if (stepVersion > version && stepVersion <= SDF_VERSION)
+      {
+        EXPECT_TRUE(sdf::Converter::Convert(&steppedDoc, stepVersion, true))
+          << file;
+      }
+    }
+
+    std::ostringstream fused;
+    fused << fusedDoc;
+    std::ostringstream stepped;
+    stepped << steppedDoc;
+    EXPECT_EQ(stepped.str(), fused.str()) << file;
+    ++converted;
+  }
+  EXPECT_LT(10, converted);
+}
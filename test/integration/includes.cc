@@ -15,6 +15,7 @@
  *
  */
 
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <gtest/gtest.h>
@@ -274,3 +275,216 @@ TEST(IncludesTest, Includes_15_convert)
   EXPECT_EQ("1.6", modelElem->OriginalVersion());
   EXPECT_EQ("1.6", linkElem->OriginalVersion());
 }
+
+//////////////////////////////////////////////////
+TEST(IncludesTest, ParallelIncludes)
+{
+  sdf::setFindCallback(findFileCb);
+
+  const std::string worldString =
+    "<sdf version='" SDF_VERSION "'>"
+    "  <world name='default'>"
+    "    <include><uri>test_model</uri><name>m1</name></include>"
+    "    <include><uri>box</uri><name>m2</name></include>"
+    "    <include><uri>missing_model</uri></include>"
+    "    <include><uri>test_light</uri></include>"
+    "    <include><uri>test_model</uri><name>m3</name>"
+    "      <pose>1 2 3 0 0 0</pose></include>"
+    "    <include><uri>test_actor</uri></include>"
+    "  </world>"
+    "</sdf>";
+
+  EXPECT_FALSE(sdf::parallelIncludes());
+  sdf::Root serialRoot;
+  sdf::Errors serialErrors = serialRoot.LoadSdfString(worldString);
+  ASSERT_NE(nullptr, serialRoot.Element());
+
+  sdf::setParallelIncludes(true);
+  EXPECT_TRUE(sdf::parallelIncludes());
+  sdf::Root parallelRoot;
+  sdf::Errors parallelErrors = parallelRoot.LoadSdfString(worldString);
+  sdf::setParallelIncludes(false);
+  ASSERT_NE(nullptr, parallelRoot.Element());
+
+  // The missing model is reported, and the others are included in the same
+  // order as when the files are read one at a time.
+  ASSERT_EQ(serialErrors.size(), parallelErrors.size());
+  ASSERT_FALSE(parallelErrors.empty());
+  EXPECT_EQ(sdf::ErrorCode::DIRECTORY_NONEXISTANT, parallelErrors[0].Code());
+  EXPECT_EQ(serialRoot.Element()->ToString(""),
+            parallelRoot.Element()->ToString(""));
+
+  const sdf::World *world = parallelRoot.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(3u, world->ModelCount());
+  EXPECT_EQ("m1", world->ModelByIndex(0)->Name());
+  EXPECT_EQ("m2", world->ModelByIndex(1)->Name());
+  EXPECT_EQ("m3", world->ModelByIndex(2)->Name());
+  EXPECT_EQ(1u, world->LightCount());
+  EXPECT_EQ(1u, world->ActorCount());
+}
+
+//////////////////////////////////////////////////
+/// A model included several times is parsed once, and each include changes
+/// only its own copy.
+TEST(IncludesTest, RepeatedIncludes)
+{
+  sdf::setFindCallback(findFileCb);
+
+  const std::string worldString =
+    "<sdf version='" SDF_VERSION "'>"
+    "  <world name='default'>"
+    "    <include><uri>box</uri><name>a</name>"
+    "      <pose>1 0 0 0 0 0</pose></include>"
+    "    <include><uri>box</uri><name>b</name></include>"
+    "    <include><uri>box</uri><name>c</name><pose></pose></include>"
+    "    <include><uri>box</uri><name>d</name><static>true</static></include>"
+    "  </world>"
+    "</sdf>";
+
+  // Read the world without the include cache, then twice with it, once to
+  // fill the cache and once from it.
+  for (int i = 0; i < 3; ++i)
+  {
+    sdf::setIncludeCache(i > 0);
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(worldString);
+    EXPECT_TRUE(errors.empty());
+
+    const sdf::World *world = root.WorldByIndex(0);
+    ASSERT_NE(nullptr, world);
+    ASSERT_EQ(4u, world->ModelCount());
+    EXPECT_EQ("a", world->ModelByIndex(0)->Name());
+    EXPECT_EQ("b", world->ModelByIndex(1)->Name());
+    EXPECT_EQ("c", world->ModelByIndex(2)->Name());
+    EXPECT_EQ("d", world->ModelByIndex(3)->Name());
+
+    EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0),
+              world->ModelByIndex(0)->RawPose());
+    EXPECT_EQ(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0),
+              world->ModelByIndex(1)->RawPose());
+    // An empty <pose> resets the pose to the default value of the spec.
+    EXPECT_EQ(ignition::math::Pose3d::Zero,
+              world->ModelByIndex(2)->RawPose());
+
+    EXPECT_FALSE(world->ModelByIndex(0)->Static());
+    EXPECT_TRUE(world->ModelByIndex(3)->Static());
+  }
+  sdf::setIncludeCache(false);
+}
+
+//////////////////////////////////////////////////
+/// A cached model is read again when its file changes, or when the cache
+/// is cleared.
+TEST(IncludesTest, RepeatedIncludesFileChanged)
+{
+  sdf::setIncludeCache(true);
+  EXPECT_TRUE(sdf::includeCache());
+
+  const std::string modelDir = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "integration", "include_cache_model");
+  sdf::filesystem::create_directory(modelDir);
+  {
+    std::ofstream config(sdf::filesystem::append(modelDir, "model.config"));
+    config << "<?xml version='1.0'?><model><name>m</name>"
+           << "<sdf version='" SDF_VERSION "'>model.sdf</sdf></model>";
+  }
+
+  auto writeModel = [&modelDir](const std::string &_linkName)
+  {
+    std::ofstream model(sdf::filesystem::append(modelDir, "model.sdf"));
+    model << "<sdf version='" SDF_VERSION "'><model name='m'>"
+          << "<link name='" << _linkName << "'/></model></sdf>";
+  };
+
+  const std::string worldString =
+    "<sdf version='" SDF_VERSION "'><world name='default'>"
+    "<include><uri>" + modelDir + "</uri></include>"
+    "</world></sdf>";
+
+  writeModel("link");
+  sdf::Root root;
+  EXPECT_TRUE(root.LoadSdfString(worldString).empty());
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  ASSERT_EQ(1u, root.WorldByIndex(0)->ModelCount());
+  EXPECT_TRUE(root.WorldByIndex(0)->ModelByIndex(0)->LinkNameExists("link"));
+
+  // The new file has a different size, so it is read again even if its
+  // modification time is in the same second.
+  writeModel("changed_link");
+  sdf::Root changedRoot;
+  EXPECT_TRUE(changedRoot.LoadSdfString(worldString).empty());
+  ASSERT_NE(nullptr, changedRoot.WorldByIndex(0));
+  ASSERT_EQ(1u, changedRoot.WorldByIndex(0)->ModelCount());
+  EXPECT_TRUE(changedRoot.WorldByIndex(0)->ModelByIndex(0)->LinkNameExists(
+      "changed_link"));
+
+  // A file of the same size written within the resolution of the file
+  // system clock may keep its stamp, so it is only read again once the
+  // cache is cleared.
+  writeModel("renamed_link");
+  sdf::clearIncludeCache();
+  sdf::Root renamedRoot;
+  EXPECT_TRUE(renamedRoot.LoadSdfString(worldString).empty());
+  ASSERT_NE(nullptr, renamedRoot.WorldByIndex(0));
+  ASSERT_EQ(1u, renamedRoot.WorldByIndex(0)->ModelCount());
+  EXPECT_TRUE(renamedRoot.WorldByIndex(0)->ModelByIndex(0)->LinkNameExists(
+      "renamed_link"));
+
+  sdf::setIncludeCache(false);
+  EXPECT_FALSE(sdf::includeCache());
+}
+
+//////////////////////////////////////////////////
+/// The links and joints of a model included in a model are prefixed with
+/// the name of the included model, and so are the references to them.
+TEST(IncludesTest, NestedModelNames)
+{
+  sdf::setFindCallback(findFileCb);
+
+  const std::string modelString =
+    "<sdf version='" SDF_VERSION "'>"
+    "  <model name='outer'>"
+    "    <include><uri>joint_model</uri><name>inner</name></include>"
+    "  </model>"
+    "</sdf>";
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  ASSERT_TRUE(sdf::readString(modelString, sdfParsed));
+
+  sdf::ElementPtr modelElem = sdfParsed->Root()->GetElement("model");
+  ASSERT_NE(nullptr, modelElem);
+  EXPECT_EQ("outer", modelElem->Get<std::string>("name"));
+
+  sdf::ElementPtr baseElem = modelElem->GetElement("link");
+  ASSERT_NE(nullptr, baseElem);
+  EXPECT_EQ("inner::base", baseElem->Get<std::string>("name"));
+
+  // Names of other elements are not renamed, even if they match a link.
+  EXPECT_EQ("base", baseElem->GetElement("visual")->Get<std::string>("name"));
+
+  sdf::ElementPtr armElem = baseElem->GetNextElement("link");
+  ASSERT_NE(nullptr, armElem);
+  EXPECT_EQ("inner::arm", armElem->Get<std::string>("name"));
+  EXPECT_EQ("inner::joint",
+      armElem->GetElement("pose")->Get<std::string>("relative_to"));
+
+  sdf::ElementPtr jointElem = modelElem->GetElement("joint");
+  ASSERT_NE(nullptr, jointElem);
+  EXPECT_EQ("inner::joint", jointElem->Get<std::string>("name"));
+  EXPECT_EQ("inner::base", jointElem->Get<std::string>("parent"));
+  EXPECT_EQ("inner::arm", jointElem->Get<std::string>("child"));
+  EXPECT_EQ("inner::base", jointElem->GetElement("axis")->GetElement("xyz")
+      ->Get<std::string>("expressed_in"));
+
+  sdf::ElementPtr frameElem = modelElem->GetElement("frame");
+  ASSERT_NE(nullptr, frameElem);
+  EXPECT_EQ("inner::arm", frameElem->Get<std::string>("attached_to"));
+
+  sdf::ElementPtr gripperElem = modelElem->GetElement("gripper");
+  ASSERT_NE(nullptr, gripperElem);
+  EXPECT_EQ("gripper", gripperElem->Get<std::string>("name"));
+  EXPECT_EQ("inner::arm", gripperElem->Get<std::string>("gripper_link"));
+  EXPECT_EQ("inner::base", gripperElem->Get<std::string>("palm_link"));
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(LazyLoading, Default)
+{
+  sdf::Root root;
+  EXPECT_FALSE(root.LazyLoading());
+  root.SetLazyLoading(true);
+  EXPECT_TRUE(root.LazyLoading());
+  EXPECT_TRUE(root.ValidateAll().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LazyLoading, SameContents)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "sensors.sdf");
+
+  sdf::Root eagerRoot;
+  EXPECT_TRUE(eagerRoot.Load(testFile).empty());
+
+  sdf::Root lazyRoot;
+  lazyRoot.SetLazyLoading(true);
+  EXPECT_TRUE(lazyRoot.Load(testFile).empty());
+
+  const sdf::Link *eagerLink = eagerRoot.ModelByIndex(0)->LinkByIndex(0);
+  const sdf::Link *lazyLink = lazyRoot.ModelByIndex(0)->LinkByIndex(0);
+  ASSERT_NE(nullptr, eagerLink);
+  ASSERT_NE(nullptr, lazyLink);
+  EXPECT_EQ(eagerLink->Name(), lazyLink->Name());
+  EXPECT_EQ(eagerLink->RawPose(), lazyLink->RawPose());
+
+  ASSERT_EQ(eagerLink->SensorCount(), lazyLink->SensorCount());
+  for (uint64_t s = 0; s < eagerLink->SensorCount(); ++s)
+  {
+    const sdf::Sensor *eagerSensor = eagerLink->SensorByIndex(s);
+    const sdf::Sensor *lazySensor = lazyLink->SensorByIndex(s);
+    ASSERT_NE(nullptr, lazySensor);
+    EXPECT_EQ(eagerSensor->Name(), lazySensor->Name());
+    EXPECT_EQ(eagerSensor->Type(), lazySensor->Type());
+    EXPECT_EQ(eagerSensor->RawPose(), lazySensor->RawPose());
+  }
+
+  // The sensors loaded on access get the pose graph of the model.
+  const sdf::Sensor *sensor = lazyLink->SensorByName("camera_sensor");
+  ASSERT_NE(nullptr, sensor);
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(sensor->SemanticPose().Resolve(pose, "__model__").empty());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 6, 0, 0, 0), pose);
+
+  EXPECT_TRUE(lazyRoot.ValidateAll().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LazyLoading, DeferredErrors)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "inertial_invalid.sdf");
+
+  sdf::Root eagerRoot;
+  sdf::Errors errors = eagerRoot.Load(testFile);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::LINK_INERTIA_INVALID, errors[0].Code());
+  EXPECT_TRUE(eagerRoot.ValidateAll().empty());
+
+  // The inertial is not loaded by Load, so its error is only found by
+  // ValidateAll.
+  sdf::Root lazyRoot;
+  lazyRoot.SetLazyLoading(true);
+  EXPECT_TRUE(lazyRoot.Load(testFile).empty());
+  ASSERT_EQ(1u, lazyRoot.ModelCount());
+  EXPECT_EQ(1u, lazyRoot.ModelByIndex(0)->LinkCount());
+
+  errors = lazyRoot.ValidateAll();
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::LINK_INERTIA_INVALID, errors[0].Code());
+
+  // The errors are kept, so a second call returns them again.
+  EXPECT_EQ(1u, lazyRoot.ValidateAll().size());
+}
+
+/////////////////////////////////////////////////
+TEST(LazyLoading, CopyLink)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "sensors.sdf");
+
+  sdf::Root root;
+  root.SetLazyLoading(true);
+  EXPECT_TRUE(root.Load(testFile).empty());
+
+  const sdf::Link *link = root.ModelByIndex(0)->LinkByIndex(0);
+  ASSERT_NE(nullptr, link);
+
+  // Copying a link loads its contents first.
+  sdf::Link copy(*link);
+  EXPECT_EQ(link->SensorCount(), copy.SensorCount());
+  EXPECT_LT(0u, copy.SensorCount());
+
+  sdf::Model modelCopy(*root.ModelByIndex(0));
+  EXPECT_EQ(link->SensorCount(), modelCopy.LinkByIndex(0)->SensorCount());
+}
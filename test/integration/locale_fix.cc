@@ -15,6 +15,9 @@
  *
  */
 
+#include <cctype>
+#include <clocale>
+#include <cstdio>
 #include <iostream>
 #include <string>
 
@@ -32,30 +35,49 @@ const std::string SDF_TEST_FILE =
 // Windows supports the setlocale call but we can not extract the
 // available locales using the Linux call
 #ifndef _MSC_VER
-TEST(CheckFixForLocal, MakeTestToFail)
+/////////////////////////////////////////////////
+/// \brief Get a locale whose decimal separator is a comma.
+/// \return Name of the locale, or an empty string if none is available.
+std::string commaDecimalLocale()
 {
   // Check if any of the latin locales is avilable
   FILE *fp = popen("locale -a | grep '^es\\|^pt_\\|^it_' | head -n 1", "r");
-
   if (!fp)
   {
-    FAIL() << "locale -a call failed";
-    return;
+    ADD_FAILURE() << "locale -a call failed";
+    return "";
   }
 
   char buffer[1024];
   char *line = fgets(buffer, sizeof(buffer), fp);
   pclose(fp);
+  if (!line)
+    return "";
+
+  std::string locale = line;
+  while (!locale.empty() &&
+         std::isspace(static_cast<unsigned char>(locale.back())))
+  {
+    locale.pop_back();
+  }
+  return locale;
+}
+
+/////////////////////////////////////////////////
+TEST(CheckFixForLocal, MakeTestToFail)
+{
+  const std::string latinLocale = commaDecimalLocale();
 
   // Do not run test if not available
-  if (!line)
+  if (latinLocale.empty())
   {
     std::cout << "No latin locale available. Skip test" << std::endl;
     SUCCEED();
     return;
   }
 
-  setlocale(LC_NUMERIC, line);
+  setlocale(LC_NUMERIC, latinLocale.c_str());
+  const std::string locale = setlocale(LC_NUMERIC, nullptr);
 
   // fix to allow make test without make install
   sdf::SDFPtr p(new sdf::SDF());
@@ -80,5 +102,76 @@ TEST(CheckFixForLocal, MakeTestToFail)
   double tmp = 0.0;
   ASSERT_TRUE(param.Get<double>(tmp));
   ASSERT_DOUBLE_EQ(1.5, tmp);
+
+  // Parsing must not have changed the locale chosen by the application
+  EXPECT_EQ(locale, setlocale(LC_NUMERIC, nullptr));
+  setlocale(LC_NUMERIC, "C");
+}
+
+/////////////////////////////////////////////////
+/// The values of <gazebo> extensions of a URDF file are not affected by
+/// the locale either.
+TEST(CheckFixForLocal, URDF)
+{
+  const std::string latinLocale = commaDecimalLocale();
+  if (latinLocale.empty())
+  {
+    std::cout << "No latin locale available. Skip test" << std::endl;
+    SUCCEED();
+    return;
+  }
+
+  const std::string urdf = R"(<?xml version="1.0" ?>
+<robot name="numeric">
+  <link name="link">
+    <inertial>
+      <mass value="1.5"/>
+      <inertia ixx="0.25" ixy="0" ixz="0" iyy="0.25" iyz="0" izz="0.25"/>
+    </inertial>
+    <collision>
+      <origin xyz="0.25 0 0.5" rpy="0 0 0.5"/>
+      <geometry>
+        <box size="0.5 0.5 0.5"/>
+      </geometry>
+    </collision>
+  </link>
+  <gazebo reference="link">
+    <mu1>0.5</mu1>
+    <kp>1.5e6</kp>
+    <kd>2.25</kd>
+    <maxVel>0.75</maxVel>
+  </gazebo>
+</robot>)";
+
+  setlocale(LC_NUMERIC, latinLocale.c_str());
+  sdf::SDFPtr p(new sdf::SDF());
+  sdf::init(p);
+  const bool result = sdf::readString(urdf, p);
+  setlocale(LC_NUMERIC, "C");
+  ASSERT_TRUE(result);
+
+  sdf::ElementPtr link = p->Root()->GetElement("model")->GetElement("link");
+  sdf::ElementPtr inertial = link->GetElement("inertial");
+  EXPECT_DOUBLE_EQ(1.5, inertial->Get<double>("mass"));
+  sdf::ElementPtr inertia = inertial->GetElement("inertia");
+  EXPECT_DOUBLE_EQ(0.25, inertia->Get<double>("ixx"));
+  EXPECT_DOUBLE_EQ(0.25, inertia->Get<double>("iyy"));
+  EXPECT_DOUBLE_EQ(0.25, inertia->Get<double>("izz"));
+
+  sdf::ElementPtr collision = link->GetElement("collision");
+  EXPECT_EQ(ignition::math::Pose3d(0.25, 0, 0.5, 0, 0, 0.5),
+            collision->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_EQ(ignition::math::Vector3d(0.5, 0.5, 0.5),
+            collision->GetElement("geometry")->GetElement("box")
+            ->Get<ignition::math::Vector3d>("size"));
+
+  sdf::ElementPtr surface = collision->GetElement("surface");
+  EXPECT_DOUBLE_EQ(0.5, surface->GetElement("friction")->GetElement("ode")
+      ->Get<double>("mu"));
+  sdf::ElementPtr contactOde =
+    surface->GetElement("contact")->GetElement("ode");
+  EXPECT_DOUBLE_EQ(1.5e6, contactOde->Get<double>("kp"));
+  EXPECT_DOUBLE_EQ(2.25, contactOde->Get<double>("kd"));
+  EXPECT_DOUBLE_EQ(0.75, contactOde->Get<double>("max_vel"));
 }
 #endif
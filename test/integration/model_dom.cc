@@ -19,13 +19,17 @@
 #include <gtest/gtest.h>
 
 #include <ignition/math/Pose3.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Element.hh"
 #include "sdf/Error.hh"
 #include "sdf/Filesystem.hh"
+#include "sdf/Frame.hh"
+#include "sdf/Joint.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
 #include "sdf/Root.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 #include "test_config.h"
 
@@ -217,3 +221,174 @@ TEST(DOMRoot, LoadCanonicalLink)
   EXPECT_EQ(nullptr, model->JointByIndex(0));
 }
 
+
+/////////////////////////////////////////////////
+TEST(DOMModel, ResolveAllPoses)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::Model *model = root.ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+
+  // The bulk poses match the poses resolved one at a time.
+  for (const std::string resolveTo : {"", "__model__", "C", "F3"})
+  {
+    const std::string semanticResolveTo =
+      resolveTo.empty() ? "__model__" : resolveTo;
+    sdf::ModelPoses poses;
+    EXPECT_TRUE(model->ResolveAllPoses(poses, resolveTo).empty());
+
+    ignition::math::Pose3d pose;
+    ASSERT_EQ(model->LinkCount(), poses.links.size());
+    ASSERT_EQ(model->LinkCount(), poses.visuals.size());
+    ASSERT_EQ(model->LinkCount(), poses.collisions.size());
+    for (uint64_t l = 0; l < model->LinkCount(); ++l)
+    {
+      const sdf::Link *link = model->LinkByIndex(l);
+      EXPECT_TRUE(
+          link->SemanticPose().Resolve(pose, semanticResolveTo).empty());
+      EXPECT_EQ(pose, poses.links[l]);
+
+      ASSERT_EQ(link->VisualCount(), poses.visuals[l].size());
+      for (uint64_t v = 0; v < link->VisualCount(); ++v)
+      {
+        EXPECT_TRUE(link->VisualByIndex(v)->SemanticPose().Resolve(
+              pose, semanticResolveTo).empty());
+        EXPECT_EQ(pose, poses.visuals[l][v]);
+      }
+
+      ASSERT_EQ(link->CollisionCount(), poses.collisions[l].size());
+      for (uint64_t c = 0; c < link->CollisionCount(); ++c)
+      {
+        EXPECT_TRUE(link->CollisionByIndex(c)->SemanticPose().Resolve(
+              pose, semanticResolveTo).empty());
+        EXPECT_EQ(pose, poses.collisions[l][c]);
+      }
+    }
+
+    ASSERT_EQ(model->JointCount(), poses.joints.size());
+    for (uint64_t j = 0; j < model->JointCount(); ++j)
+    {
+      EXPECT_TRUE(model->JointByIndex(j)->SemanticPose().Resolve(
+            pose, semanticResolveTo).empty());
+      EXPECT_EQ(pose, poses.joints[j]);
+    }
+
+    ASSERT_EQ(model->FrameCount(), poses.frames.size());
+    for (uint64_t f = 0; f < model->FrameCount(); ++f)
+    {
+      EXPECT_TRUE(model->FrameByIndex(f)->SemanticPose().Resolve(
+            pose, semanticResolveTo).empty());
+      EXPECT_EQ(pose, poses.frames[f]);
+    }
+  }
+
+  // An unknown frame is an error, and the poses are not changed.
+  sdf::ModelPoses poses;
+  poses.links.resize(1);
+  sdf::Errors errors = model->ResolveAllPoses(poses, "invalid");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  EXPECT_EQ(1u, poses.links.size());
+
+  // A model that was not loaded has no graph.
+  sdf::Model emptyModel;
+  errors = emptyModel.ResolveAllPoses(poses);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors[0].Code());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMModel, UpdatePoses)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  ASSERT_NE(nullptr, root.ModelByIndex(0));
+  sdf::Model model = *root.ModelByIndex(0);
+
+  using Pose = ignition::math::Pose3d;
+  const sdf::Frame *f1 = model.FrameByName("F1");
+  const sdf::Frame *f3 = model.FrameByName("F3");
+  const sdf::Frame *f4 = model.FrameByName("F4");
+  const sdf::Joint *joint = model.JointByName("J");
+  ASSERT_NE(nullptr, f1);
+  ASSERT_NE(nullptr, f3);
+  ASSERT_NE(nullptr, f4);
+  ASSERT_NE(nullptr, joint);
+
+  // Changing the raw pose of F3 moves F4, which is relative to it.
+  const Pose newPose(0, 1, 0, 0, 0, 0);
+  EXPECT_TRUE(model.UpdateRawPose("F3", newPose).empty());
+  EXPECT_EQ(newPose, f3->RawPose());
+  Pose pose;
+  EXPECT_TRUE(f3->SemanticPose().Resolve(pose, "J").empty());
+  EXPECT_EQ(newPose, pose);
+  Pose f3Pose;
+  EXPECT_TRUE(f3->SemanticPose().Resolve(f3Pose).empty());
+  EXPECT_TRUE(f4->SemanticPose().Resolve(pose).empty());
+  EXPECT_EQ(f3Pose * f4->RawPose(), pose);
+
+  // Pose F3 relative to P, and the joint relative to its child link.
+  EXPECT_TRUE(model.UpdatePoseRelativeTo("F3", "P").empty());
+  EXPECT_EQ("P", f3->PoseRelativeTo());
+  EXPECT_TRUE(f3->SemanticPose().Resolve(pose, "P").empty());
+  EXPECT_EQ(newPose, pose);
+  EXPECT_TRUE(model.UpdatePoseRelativeTo("J", "").empty());
+  EXPECT_TRUE(joint->SemanticPose().Resolve(pose, "C").empty());
+  EXPECT_EQ(joint->RawPose(), pose);
+
+  // Without a relative-to frame, F1 is posed relative to the frame it is
+  // attached to.
+  EXPECT_TRUE(model.UpdatePoseRelativeTo("F1", "").empty());
+  EXPECT_TRUE(model.UpdateFrameAttachedTo("F1", "C").empty());
+  EXPECT_EQ("C", f1->AttachedTo());
+  std::string body;
+  EXPECT_TRUE(f1->ResolveAttachedToBody(body).empty());
+  EXPECT_EQ("C", body);
+  EXPECT_TRUE(f1->SemanticPose().Resolve(pose, "C").empty());
+  EXPECT_EQ(f1->RawPose(), pose);
+
+  // The updated cached poses match the poses resolved one at a time.
+  sdf::ModelPoses poses;
+  EXPECT_TRUE(model.ResolveAllPoses(poses).empty());
+  ASSERT_EQ(model.FrameCount(), poses.frames.size());
+  for (uint64_t f = 0; f < model.FrameCount(); ++f)
+  {
+    EXPECT_TRUE(model.FrameByIndex(f)->SemanticPose().Resolve(pose).empty());
+    EXPECT_EQ(pose, poses.frames[f]);
+  }
+
+  // Errors leave the model unchanged. Attaching F3 to F4 without a
+  // relative-to frame would pose them relative to each other.
+  sdf::Errors errors = model.UpdateRawPose("invalid", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  errors = model.UpdatePoseRelativeTo("F3", "F4");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  EXPECT_EQ("P", f3->PoseRelativeTo());
+  errors = model.UpdateFrameAttachedTo("P", "C");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_INVALID, errors[0].Code());
+  EXPECT_TRUE(model.UpdatePoseRelativeTo("F3", "").empty());
+  errors = model.UpdateFrameAttachedTo("F3", "F4");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  EXPECT_EQ("", f3->AttachedTo());
+  EXPECT_TRUE(f3->ResolveAttachedToBody(body).empty());
+  EXPECT_EQ("P", body);
+
+  // A model that was not loaded has no graph.
+  sdf::Model emptyModel;
+  errors = emptyModel.UpdateRawPose("F3", newPose);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::ELEMENT_INVALID, errors[0].Code());
+}
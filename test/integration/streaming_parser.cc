@@ -0,0 +1,232 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+const auto g_testPath = sdf::filesystem::append(PROJECT_SOURCE_PATH, "test");
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(g_testPath, "integration", "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// \brief The result of reading a document.
+struct ReadResult
+{
+  /// \brief Return value of the read function.
+  bool result = false;
+
+  /// \brief The parsed elements.
+  std::string elements;
+
+  /// \brief Version of the document.
+  std::string originalVersion;
+
+  /// \brief File path of each element, in depth first order.
+  std::vector<std::string> filePaths;
+
+  /// \brief Messages of the errors.
+  std::vector<std::string> errors;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the file path of an element and its descendants.
+/// \param[in] _elem The element.
+/// \param[out] _paths The paths, in depth first order.
+void collectFilePaths(const sdf::ElementPtr &_elem,
+                      std::vector<std::string> &_paths)
+{
+  _paths.push_back(_elem->FilePath());
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collectFilePaths(child, _paths);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a file or string, with the streaming parser enabled or not.
+/// \param[in] _input Path of the file, or the document.
+/// \param[in] _isFile True if _input is the path of a file.
+/// \param[in] _streaming True to enable the streaming parser.
+/// \return The result of reading the document.
+ReadResult readDocument(const std::string &_input, const bool _isFile,
+                        const bool _streaming)
+{
+  sdf::setStreamingParser(_streaming);
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  sdf::Errors errors;
+
+  ReadResult document;
+  document.result = _isFile ? sdf::readFile(_input, sdf, errors) :
+    sdf::readString(_input, sdf, errors);
+  document.elements = sdf->Root()->ToString("");
+  document.originalVersion = sdf->OriginalVersion();
+  collectFilePaths(sdf->Root(), document.filePaths);
+  for (const auto &error : errors)
+    document.errors.push_back(error.Message());
+
+  sdf::setStreamingParser(false);
+  return document;
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect a document to be read the same with and without the
+/// streaming parser.
+/// \param[in] _input Path of the file, or the document.
+/// \param[in] _isFile True if _input is the path of a file.
+void expectSameRead(const std::string &_input, const bool _isFile)
+{
+  const ReadResult tinyxml = readDocument(_input, _isFile, false);
+  const ReadResult streaming = readDocument(_input, _isFile, true);
+  EXPECT_EQ(tinyxml.result, streaming.result) << _input;
+  EXPECT_EQ(tinyxml.elements, streaming.elements) << _input;
+  EXPECT_EQ(tinyxml.originalVersion, streaming.originalVersion) << _input;
+  EXPECT_EQ(tinyxml.filePaths, streaming.filePaths) << _input;
+  EXPECT_EQ(tinyxml.errors, streaming.errors) << _input;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the SDF files in a directory and its subdirectories.
+/// \param[in] _dir Directory to search.
+/// \param[out] _files The paths of the files found.
+void findSdfFiles(const std::string &_dir, std::vector<std::string> &_files)
+{
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(_dir); dirIter != endIter; ++dirIter)
+  {
+    const std::string path = *dirIter;
+    if (sdf::filesystem::is_directory(path))
+    {
+      findSdfFiles(path, _files);
+    }
+    else if (path.size() > 4 && path.compare(path.size() - 4, 4, ".sdf") == 0)
+    {
+      _files.push_back(path);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Every test file is read the same by the streaming parser, whether it
+/// reads the file itself or leaves it to TinyXML.
+TEST(StreamingParser, SameAsTinyXml)
+{
+  sdf::setFindCallback(findFileCb);
+
+  std::vector<std::string> files;
+  findSdfFiles(sdf::filesystem::append(g_testPath, "integration"), files);
+  findSdfFiles(sdf::filesystem::append(g_testPath, "sdf"), files);
+  ASSERT_LT(10u, files.size());
+
+  for (const std::string &file : files)
+    expectSameRead(file, true);
+}
+
+/////////////////////////////////////////////////
+/// The parts of a document that the streaming parser reads with the code
+/// of the TinyXML path give the same elements.
+TEST(StreamingParser, KeptElements)
+{
+  sdf::setFindCallback(findFileCb);
+
+  const std::string sdf = R"(<?xml version="1.0" ?>
+<!-- A world with one of everything. -->
+<sdf version=")" SDF_VERSION R"(">
+  <world name="default" xmlns:custom="http://example.com">
+    <custom:tag custom:attr="1">value</custom:tag>
+    <gravity><!-- no value -->1 2 3</gravity>
+    <wind><linear_velocity>
+      4   5 &#54;
+    </linear_velocity></wind>
+    <include>
+      <uri>test_model</uri>
+      <name>included</name>
+      <pose>1 0 0 0 0 0</pose>
+      <plugin name="include_plugin" filename="libplugin.so">
+        <param>1</param>
+      </plugin>
+    </include>
+    <model name="nested_parent">
+      <link name="link"/>
+      <model name="nested">
+        <link name="nested_link"/>
+      </model>
+    </model>
+    <plugin name="world_plugin" filename="libworld.so">
+      <![CDATA[ raw <data> ]]>
+      <nested attr="a"><deeper>text</deeper></nested>
+    </plugin>
+    <unknown_first attr="1"><child>x</child></unknown_first>
+    <physics type="ode"/>
+  </world>
+</sdf>)";
+
+  expectSameRead(sdf, false);
+
+  const ReadResult streaming = readDocument(sdf, false, true);
+  EXPECT_TRUE(streaming.result);
+  EXPECT_NE(std::string::npos, streaming.elements.find("included"));
+}
+
+/////////////////////////////////////////////////
+/// Documents that the streaming parser leaves to TinyXML are still read.
+TEST(StreamingParser, Fallback)
+{
+  // Converted from an older version.
+  expectSameRead(R"(<sdf version="1.6">
+      <model name="old"><link name="link"/></model></sdf>)", false);
+
+  // Errors in the SDF.
+  expectSameRead(R"(<sdf version=")" SDF_VERSION R"(">
+      <model><link name="link"/></model></sdf>)", false);
+  expectSameRead(R"(<sdf version=")" SDF_VERSION R"(">
+      <model name="m"><pose>1 2 three</pose></model></sdf>)", false);
+
+  // Errors in the XML.
+  expectSameRead(R"(<sdf version=")" SDF_VERSION R"(">
+      <model name="m"></sdf>)", false);
+
+  // Not SDF.
+  expectSameRead("<robot name='r'><link name='l'/></robot>", false);
+}
+
+/////////////////////////////////////////////////
+/// Elements read by the streaming parser have the path of their file, so
+/// relative URIs of meshes and animations can be resolved.
+TEST(StreamingParser, FilePath)
+{
+  const std::string file = sdf::filesystem::append(
+      g_testPath, "sdf", "model_frame_relative_to_joint.sdf");
+
+  const ReadResult streaming = readDocument(file, true, true);
+  ASSERT_TRUE(streaming.result);
+  ASSERT_LT(1u, streaming.filePaths.size());
+  for (const std::string &path : streaming.filePaths)
+    EXPECT_EQ(file, path);
+}
@@ -220,3 +220,63 @@ TEST(DOMWorld, LoadModelFrameSameName)
       SemanticPose().Resolve(pose, "ground").empty());
   EXPECT_EQ(Pose(0, -2, 3, 0, 0, 0), pose);
 }
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, ResolveAllPoses)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "world_frame_relative_to.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  for (const std::string resolveTo : {"", "world", "F1", "M2"})
+  {
+    const std::string semanticResolveTo =
+      resolveTo.empty() ? "world" : resolveTo;
+    sdf::WorldPoses poses;
+    EXPECT_TRUE(world->ResolveAllPoses(poses, resolveTo).empty());
+
+    ignition::math::Pose3d pose;
+    ASSERT_EQ(world->ModelCount(), poses.models.size());
+    ASSERT_EQ(world->ModelCount(), poses.modelContents.size());
+    for (uint64_t m = 0; m < world->ModelCount(); ++m)
+    {
+      const sdf::Model *model = world->ModelByIndex(m);
+      EXPECT_TRUE(
+          model->SemanticPose().Resolve(pose, semanticResolveTo).empty());
+      EXPECT_EQ(pose, poses.models[m]);
+
+      // The contents of the model are moved to the same frame.
+      sdf::ModelPoses modelPoses;
+      EXPECT_TRUE(model->ResolveAllPoses(modelPoses).empty());
+      ASSERT_EQ(modelPoses.links.size(), poses.modelContents[m].links.size());
+      for (std::size_t l = 0; l < modelPoses.links.size(); ++l)
+      {
+        EXPECT_EQ(poses.models[m] * modelPoses.links[l],
+                  poses.modelContents[m].links[l]);
+      }
+    }
+
+    ASSERT_EQ(world->FrameCount(), poses.frames.size());
+    for (uint64_t f = 0; f < world->FrameCount(); ++f)
+    {
+      EXPECT_TRUE(world->FrameByIndex(f)->SemanticPose().Resolve(
+            pose, semanticResolveTo).empty());
+      EXPECT_EQ(pose, poses.frames[f]);
+    }
+  }
+
+  // The pose of M3 is relative to M2.
+  sdf::WorldPoses poses;
+  EXPECT_TRUE(world->ResolveAllPoses(poses).empty());
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 9, 0, 0, 0),
+            poses.models[2]);
+
+  sdf::Errors errors = world->ResolveAllPoses(poses, "invalid");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+}
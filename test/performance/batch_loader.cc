@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "integration",
+                                 "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// Files loaded per second by a BatchLoader with different thread counts.
+TEST(BatchLoader, FilesPerSecond)
+{
+  using Clock = std::chrono::steady_clock;
+  sdf::setFindCallback(findFileCb);
+
+  const std::string testDir =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf");
+  const std::vector<std::string> models =
+  {
+    sdf::filesystem::append(testDir, "double_pendulum.sdf"),
+    sdf::filesystem::append(testDir, "includes.sdf"),
+    sdf::filesystem::append(testDir, "joint_complete.sdf"),
+    sdf::filesystem::append(testDir, "model_link_relative_to.sdf"),
+  };
+  std::vector<std::string> files;
+  for (int i = 0; i < 50; ++i)
+    files.insert(files.end(), models.begin(), models.end());
+
+  const unsigned int hardwareThreads =
+    std::max(std::thread::hardware_concurrency(), 1u);
+  for (unsigned int threads = 1; threads <= hardwareThreads; threads *= 2)
+  {
+    sdf::BatchLoader loader;
+    loader.SetThreadCount(threads);
+
+    auto start = Clock::now();
+    std::vector<sdf::Errors> errors = loader.Load(files);
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    ASSERT_EQ(files.size(), errors.size());
+    for (const auto &fileErrors : errors)
+      EXPECT_TRUE(fileErrors.empty());
+
+    std::cout << threads << " threads: " << files.size() / elapsed.count()
+              << " files per second\n";
+  }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with many models to a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _modelCount Number of models.
+void writeWorld(const std::string &_path, const int _modelCount)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  file << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+       << "<world name='default'>\n";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    file << "  <model name='model_" << m << "'>\n"
+         << "    <pose>" << m << " 0 0.5 0 0 0</pose>\n"
+         << "    <link name='link'>\n"
+         << "      <inertial><mass>1.5</mass></inertial>\n"
+         << "      <collision name='collision'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></collision>\n"
+         << "      <visual name='visual'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></visual>\n"
+         << "    </link>\n";
+    if (m % 10 == 0)
+    {
+      file << "    <plugin name='plugin' filename='libplugin.so'>"
+           << "<gain>" << m << "</gain></plugin>\n";
+    }
+    file << "  </model>\n";
+  }
+  file << "</world>\n</sdf>\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the size of a file.
+/// \param[in] _path Path of the file.
+/// \return Size of the file in MB.
+double fileSizeMb(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::in | std::ios::binary | std::ios::ate);
+  return static_cast<double>(file.tellg()) / 1.0e6;
+}
+
+/////////////////////////////////////////////////
+/// Load time of readFile from the XML file and from its binary cache file.
+TEST(BinaryCache, LoadTime)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string path = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "performance", "binary_cache_world.sdf");
+  const std::string cachePath = path + ".sdfcache";
+
+  for (int modelCount : {1000, 10000, 50000})
+  {
+    writeWorld(path, modelCount);
+    std::remove(cachePath.c_str());
+
+    // The first read with the cache enabled parses the XML and writes the
+    // cache file, and the second one reads the cache file.
+    for (bool cache : {false, true, true})
+    {
+      sdf::setBinaryCache(cache);
+
+      sdf::SDFPtr sdfParsed(new sdf::SDF());
+      sdf::init(sdfParsed);
+      auto start = Clock::now();
+      EXPECT_TRUE(sdf::readFile(path, sdfParsed));
+      const std::chrono::duration<double, std::milli> elapsed =
+        Clock::now() - start;
+
+      std::cout << modelCount << " models, "
+                << (cache ? "cache enabled" : "cache disabled") << ": "
+                << elapsed.count() << " ms" << std::endl;
+    }
+
+    std::cout << "XML file " << fileSizeMb(path) << " MB, cache file "
+              << fileSizeMb(cachePath) << " MB" << std::endl;
+  }
+
+  sdf::setBinaryCache(false);
+  std::remove(path.c_str());
+  std::remove(cachePath.c_str());
+}
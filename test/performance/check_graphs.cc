@@ -0,0 +1,89 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Get a world with many models, each a chain of links with joints
+/// and frames.
+/// \param[in] _modelCount Number of models.
+/// \param[in] _linkCount Number of links of each model.
+/// \return The world.
+std::string worldString(const int _modelCount, const int _linkCount)
+{
+  std::ostringstream stream;
+  stream << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+         << "<world name='default'>\n";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    stream << "  <model name='model_" << m << "'>\n"
+           << "    <pose>" << m << " 0 0 0 0 0</pose>\n";
+    for (int l = 0; l < _linkCount; ++l)
+    {
+      const std::string name = "link_" + std::to_string(l);
+      stream << "    <link name='" << name << "'>"
+             << "<pose>0 0 " << l << " 0 0 0</pose></link>\n"
+             << "    <frame name='" << name << "_frame' attached_to='"
+             << name << "'/>\n";
+      if (l > 0)
+      {
+        stream << "    <joint name='joint_" << l << "' type='revolute'>"
+               << "<parent>link_" << l - 1 << "</parent>"
+               << "<child>" << name << "</child>"
+               << "<axis><xyz>0 0 1</xyz></axis></joint>\n";
+      }
+    }
+    stream << "  </model>\n";
+  }
+  stream << "</world>\n</sdf>\n";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Time of the graph checks run by `ign sdf --check` after Root::Load. They
+/// reuse the graphs built by Load, so they should take a small fraction of
+/// the load time, most of which is spent building the same graphs.
+TEST(CheckGraphs, Time)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int modelCount : {100, 1000})
+  {
+    sdf::Root root;
+    auto start = Clock::now();
+    EXPECT_TRUE(root.LoadSdfString(worldString(modelCount, 20)).empty());
+    const std::chrono::duration<double, std::milli> loadTime =
+      Clock::now() - start;
+
+    start = Clock::now();
+    EXPECT_TRUE(sdf::checkFrameAttachedToGraph(&root));
+    EXPECT_TRUE(sdf::checkPoseRelativeToGraph(&root));
+    const std::chrono::duration<double, std::milli> checkTime =
+      Clock::now() - start;
+
+    std::cout << modelCount << " models: load " << loadTime.count()
+              << " ms, graph checks " << checkTime.count() << " ms"
+              << std::endl;
+  }
+}
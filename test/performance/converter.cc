@@ -0,0 +1,108 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+#include "sdf/Converter.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// Get an SDF 1.4 world.
+/// \param[in] _modelCount Number of models in the world.
+/// \return The world as an SDF string.
+std::string legacyWorld(const int _modelCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.4'><world name='default'>"
+         << "<physics type='ode'><gravity>0 0 -9.8</gravity></physics>";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'>"
+           << "<link name='link'><sensor name='imu' type='imu'><imu><noise>"
+           << "<type>gaussian</type><rate><mean>0</mean></rate></noise>"
+           << "</imu></sensor></link>"
+           << "<joint name='joint' type='revolute'><parent>world</parent>"
+           << "<child>link</child><axis><xyz>0 0 1</xyz>"
+           << "<use_parent_model_frame>true</use_parent_model_frame>"
+           << "</axis></joint></model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Number of SDF 1.4 documents converted to the latest version per second.
+TEST(Converter, LegacyFilesPerSecond)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string xmlString = legacyWorld(5);
+  const int count = 2000;
+
+  auto start = Clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    TiXmlDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    ASSERT_TRUE(sdf::Converter::Convert(&xmlDoc, SDF_VERSION, true));
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  std::cout << "Converted " << count << " documents from 1.4 to "
+            << SDF_VERSION << " in " << elapsed.count() * 1000 << " ms, "
+            << count / elapsed.count() << " files/s\n";
+}
+
+/////////////////////////////////////////////////
+/// Time to convert a large SDF 1.4 world to the latest version one version
+/// at a time, and in one call that fuses the rules of all the versions.
+TEST(Converter, PerHopVersusFused)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string xmlString = legacyWorld(5000);
+  const std::vector<std::string> versions = {"1.5", "1.6", "1.7"};
+
+  TiXmlDocument perHopDoc;
+  perHopDoc.Parse(xmlString.c_str());
+  auto start = Clock::now();
+  for (const std::string &version : versions)
+  {
+    if (version <= SDF_VERSION)
+      ASSERT_TRUE(sdf::Converter::Convert(&perHopDoc, version, true));
+  }
+  const std::chrono::duration<double, std::milli> perHop =
+    Clock::now() - start;
+
+  TiXmlDocument fusedDoc;
+  fusedDoc.Parse(xmlString.c_str());
+  start = Clock::now();
+  ASSERT_TRUE(sdf::Converter::Convert(&fusedDoc, SDF_VERSION, true));
+  const std::chrono::duration<double, std::milli> fused =
+    Clock::now() - start;
+
+  std::cout << "Per-hop conversion: " << perHop.count() << " ms\n"
+            << "Fused conversion: " << fused.count() << " ms\n";
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+using Clock = std::chrono::steady_clock;
+
+/////////////////////////////////////////////////
+/// \brief Create an element with the given number of <model> children,
+/// interleaved with the same number of <frame> children.
+/// \param[in] _count Number of <model> children.
+/// \return The parent element.
+sdf::ElementPtr elementWithChildren(std::size_t _count)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("world");
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    for (const std::string name : {"model", "frame"})
+    {
+      sdf::ElementPtr child = std::make_shared<sdf::Element>();
+      child->SetName(name);
+      child->SetParent(parent);
+      parent->InsertElement(child);
+    }
+  }
+  return parent;
+}
+
+/////////////////////////////////////////////////
+TEST(ElementIteration, GetNextElementScaling)
+{
+  double nsPerStepSmall = 0;
+  for (std::size_t count = 10; count <= 100000; count *= 10)
+  {
+    sdf::ElementPtr parent = elementWithChildren(count);
+
+    std::size_t found = 0;
+    auto start = Clock::now();
+    for (sdf::ElementPtr elem = parent->GetFirstElement(); elem;
+         elem = elem->GetNextElement("model"))
+    {
+      ++found;
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+      Clock::now() - start;
+    EXPECT_EQ(count, found);
+
+    const double nsPerStep = elapsed.count() / count;
+    std::cout << count << " siblings: " << nsPerStep << " ns per step\n";
+
+    if (count == 1000)
+    {
+      nsPerStepSmall = nsPerStep;
+    }
+    else if (count == 100000)
+    {
+      // Iteration should be linear in the number of siblings, so the cost
+      // of each step should not grow with the number of siblings. The bound
+      // is loose to allow for cache effects and timer noise.
+      EXPECT_LT(nsPerStep, nsPerStepSmall * 20);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ElementIteration, WorldLoadScaling)
+{
+  for (int count = 10; count <= 10000; count *= 10)
+  {
+    std::ostringstream stream;
+    stream << "<sdf version='1.7'><world name='default'>";
+    for (int i = 0; i < count; ++i)
+    {
+      stream << "<model name='model" << i << "'>"
+             << "<link name='link'/>"
+             << "</model>";
+    }
+    stream << "</world></sdf>";
+
+    sdf::Root root;
+    auto start = Clock::now();
+    sdf::Errors errors = root.LoadSdfString(stream.str());
+    const std::chrono::duration<double, std::micro> elapsed =
+      Clock::now() - start;
+    EXPECT_TRUE(errors.empty());
+    ASSERT_NE(nullptr, root.WorldByIndex(0));
+    EXPECT_EQ(static_cast<uint64_t>(count),
+              root.WorldByIndex(0)->ModelCount());
+
+    std::cout << count << " models: " << elapsed.count() / count
+              << " us per model\n";
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Number of lookups to time for each element size.
+static const int kLookups = 100000;
+
+/////////////////////////////////////////////////
+TEST(ElementLookup, ChildLookupVsChildCount)
+{
+  double nsPerLookupSmall = 0;
+  for (std::size_t count = 4; count <= 4096; count *= 4)
+  {
+    sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      sdf::ElementPtr child = std::make_shared<sdf::Element>();
+      child->SetName("child" + std::to_string(i));
+      child->SetParent(parent);
+      parent->InsertElement(child);
+    }
+
+    // Look up the last child, which is the worst case for a linear search.
+    const std::string name = "child" + std::to_string(count - 1);
+    int found = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < kLookups; ++i)
+    {
+      found += parent->HasElement(name) ? 1 : 0;
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+      Clock::now() - start;
+    EXPECT_EQ(kLookups, found);
+
+    const double nsPerLookup = elapsed.count() / kLookups;
+    std::cout << count << " children: " << nsPerLookup << " ns per lookup\n";
+
+    if (count == 16)
+    {
+      nsPerLookupSmall = nsPerLookup;
+    }
+    else if (count == 4096)
+    {
+      // The bound is loose to allow for cache effects and timer noise.
+      EXPECT_LT(nsPerLookup, nsPerLookupSmall * 10);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ElementLookup, AttributeLookupVsAttributeCount)
+{
+  for (std::size_t count = 4; count <= 256; count *= 4)
+  {
+    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      elem->AddAttribute("attr" + std::to_string(i), "string", "", false);
+    }
+
+    const std::string key = "attr" + std::to_string(count - 1);
+    int found = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < kLookups; ++i)
+    {
+      found += elem->HasAttribute(key) ? 1 : 0;
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+      Clock::now() - start;
+    EXPECT_EQ(kLookups, found);
+
+    std::cout << count << " attributes: " << elapsed.count() / kLookups
+              << " ns per lookup\n";
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/// \brief Number of bytes currently allocated through operator new.
+static std::atomic<std::ptrdiff_t> g_liveBytes{0};
+
+/// \brief Size of the header used to remember the size of each allocation,
+/// kept large enough to preserve the alignment of the returned pointer.
+static constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  void *ptr = std::malloc(_size + kHeaderSize);
+  if (!ptr)
+    throw std::bad_alloc();
+  *static_cast<std::size_t *>(ptr) = _size;
+  g_liveBytes += static_cast<std::ptrdiff_t>(_size);
+  return static_cast<char *>(ptr) + kHeaderSize;
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return operator new(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  if (!_ptr)
+    return;
+  void *base = static_cast<char *>(_ptr) - kHeaderSize;
+  g_liveBytes -= static_cast<std::ptrdiff_t>(*static_cast<std::size_t *>(base));
+  std::free(base);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  operator delete(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  operator delete(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  operator delete(_ptr);
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a world with the given number of models, each with a link
+/// that has a visual, a collision, an inertial and a sensor.
+/// \param[in] _count Number of models in the world.
+/// \return SDF string of the world.
+std::string worldWithModels(int _count)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.7'><world name='default'>";
+  for (int i = 0; i < _count; ++i)
+  {
+    stream
+      << "<model name='model" << i << "'>"
+      << "  <pose>" << i << " 0 0 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <inertial><mass>1</mass></inertial>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "    <visual name='visual'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </visual>"
+      << "    <sensor name='imu' type='imu'/>"
+      << "  </link>"
+      << "</model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+TEST(ElementMemory, BytesPerModel)
+{
+  const int count = 200;
+  const std::string worldString = worldWithModels(count);
+
+  // Load once so that the spec cache is populated before measuring.
+  {
+    sdf::SDFPtr warmup(new sdf::SDF());
+    ASSERT_TRUE(sdf::init(warmup));
+    ASSERT_TRUE(sdf::readString(worldWithModels(1), warmup));
+  }
+
+  const std::ptrdiff_t before = g_liveBytes;
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  ASSERT_TRUE(sdf::readString(worldString, sdfParsed));
+  const std::ptrdiff_t after = g_liveBytes;
+
+  sdf::ElementPtr world = sdfParsed->Root()->GetElement("world");
+  ASSERT_NE(nullptr, world);
+  ASSERT_TRUE(world->HasElement("model"));
+
+  const std::ptrdiff_t bytesPerModel = (after - before) / count;
+  std::cout << "Bytes per loaded model: " << bytesPerModel << "\n";
+  EXPECT_GT(bytesPerModel, 0);
+}
+
+/////////////////////////////////////////////////
+/// Element names and attribute keys from the spec are interned, so each
+/// clone of an element only costs its own instance data.
+TEST(ElementMemory, BytesPerClonedElement)
+{
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  sdf::ElementPtr link = sdfParsed->Root()->GetElement("model")
+    ->GetElement("link");
+  ASSERT_NE(nullptr, link);
+
+  const int count = 1000;
+  std::vector<sdf::ElementPtr> clones;
+  clones.reserve(count);
+
+  const std::ptrdiff_t before = g_liveBytes;
+  for (int i = 0; i < count; ++i)
+  {
+    clones.push_back(link->Clone());
+  }
+  const std::ptrdiff_t after = g_liveBytes;
+
+  const std::ptrdiff_t bytesPerClone = (after - before) / count;
+  std::cout << "Bytes per cloned <link>: " << bytesPerClone << "\n";
+  EXPECT_GT(bytesPerClone, 0);
+}
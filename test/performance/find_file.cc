@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// Time to find model files spread over several model paths, with and
+/// without the findFile cache and the URI path index.
+TEST(FindFile, ModelPathLookups)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string root = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "performance", "find_file_models");
+  sdf::filesystem::create_directory(root);
+
+  // Each model is in the last path, so every other path is searched first.
+  const int pathCount = 10;
+  const int modelCount = 300;
+  std::vector<std::string> models;
+  for (int p = 0; p < pathCount; ++p)
+  {
+    const std::string path =
+      sdf::filesystem::append(root, "path_" + std::to_string(p));
+    sdf::filesystem::create_directory(path);
+    sdf::addURIPath("find_file_model://", path);
+  }
+  const std::string lastPath = sdf::filesystem::append(root,
+      "path_" + std::to_string(pathCount - 1));
+  for (int m = 0; m < modelCount; ++m)
+  {
+    const std::string name = "model_" + std::to_string(m);
+    const std::string dir = sdf::filesystem::append(lastPath, name);
+    sdf::filesystem::create_directory(dir);
+    std::ofstream(sdf::filesystem::append(dir, "model.config"))
+      << "<?xml version='1.0'?><model/>";
+    models.push_back("find_file_model://" + name);
+  }
+
+  // Each model is looked up several times, as if included several times.
+  const int repeat = 10;
+  auto lookUp = [&](const std::string &_label)
+  {
+    sdf::resetFindFileStats();
+    auto start = Clock::now();
+    for (int r = 0; r < repeat; ++r)
+    {
+      for (const auto &model : models)
+      {
+        EXPECT_FALSE(sdf::findFile(model, false).empty());
+        EXPECT_FALSE(sdf::findFile(model + "/model.config", false).empty());
+      }
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    const sdf::FindFileStats stats = sdf::findFileStats();
+    std::cout << _label << ": " << elapsed.count() << " ms, "
+              << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.indexSkips << " index skips\n";
+  };
+
+  lookUp("Uncached");
+
+  sdf::setURIPathIndexEnabled(true);
+  lookUp("Index");
+
+  sdf::setFindFileCacheEnabled(true);
+  lookUp("Index and cache");
+
+  sdf::setURIPathIndexEnabled(false);
+  lookUp("Cache");
+  sdf::setFindFileCacheEnabled(false);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Get a model whose links form a chain, each link posed relative
+/// to the previous one and attached to it by a joint, with a chain of
+/// frames attached to the last link.
+/// \param[in] _linkCount Number of links, and of frames.
+/// \return The model.
+std::string deepModelString(const int _linkCount)
+{
+  std::ostringstream stream;
+  stream << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+         << "<model name='deep'>\n";
+  for (int l = 0; l < _linkCount; ++l)
+  {
+    const std::string relativeTo =
+      l == 0 ? "" : " relative_to='link_" + std::to_string(l - 1) + "'";
+    stream << "  <link name='link_" << l << "'><pose" << relativeTo
+           << ">0.1 0 0 0 0 0.01</pose></link>\n";
+    if (l > 0)
+    {
+      stream << "  <joint name='joint_" << l << "' type='revolute'>"
+             << "<parent>link_" << l - 1 << "</parent>"
+             << "<child>link_" << l << "</child>"
+             << "<axis><xyz>0 0 1</xyz></axis></joint>\n";
+    }
+  }
+  for (int f = 0; f < _linkCount; ++f)
+  {
+    const std::string attachedTo = f == 0 ?
+      "link_" + std::to_string(_linkCount - 1) :
+      "frame_" + std::to_string(f - 1);
+    stream << "  <frame name='frame_" << f << "' attached_to='"
+           << attachedTo << "'><pose relative_to='" << attachedTo
+           << "'>0 0.1 0 0 0 0</pose></frame>\n";
+  }
+  stream << "</model>\n</sdf>\n";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Time of Model::Load, which builds, validates and caches the frame
+/// graphs, on deep models. Validating a graph used to resolve every vertex
+/// by walking up to the root, which made it quadratic in the depth.
+TEST(FrameGraph, LoadDeepModel)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int linkCount : {100, 1000, 3000})
+  {
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+    ASSERT_TRUE(sdf::readString(deepModelString(linkCount), sdfParsed));
+    sdf::ElementPtr modelElem = sdfParsed->Root()->GetElement("model");
+
+    auto start = Clock::now();
+    sdf::Model model;
+    EXPECT_TRUE(model.Load(modelElem).empty());
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    std::cout << linkCount << " links and " << linkCount << " frames: "
+              << elapsed.count() << " ms" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Time of edits to a loaded model with 1000 links and 1000 frames, which
+/// update the graphs in place, compared to loading the model again. An
+/// edit visits the edited frame and the frames posed relative to it, so
+/// editing the first link of the chain is the slowest case.
+TEST(FrameGraph, EditLatency)
+{
+  using Clock = std::chrono::steady_clock;
+  const int linkCount = 1000;
+  const int editCount = 100;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  ASSERT_TRUE(sdf::readString(deepModelString(linkCount), sdfParsed));
+  sdf::ElementPtr modelElem = sdfParsed->Root()->GetElement("model");
+
+  auto start = Clock::now();
+  sdf::Model model;
+  EXPECT_TRUE(model.Load(modelElem).empty());
+  const std::chrono::duration<double, std::milli> loadTime =
+    Clock::now() - start;
+  std::cout << "Load: " << loadTime.count() << " ms" << std::endl;
+
+  const std::string last = std::to_string(linkCount - 1);
+  const std::string middle = std::to_string(linkCount / 2);
+  for (const std::string name :
+      {"frame_" + last, "link_" + last, "link_" + middle, "link_0"})
+  {
+    start = Clock::now();
+    for (int e = 0; e < editCount; ++e)
+    {
+      EXPECT_TRUE(model.UpdateRawPose(
+            name, ignition::math::Pose3d(0.1, 0.001 * e, 0, 0, 0, 0.01))
+          .empty());
+    }
+    const std::chrono::duration<double, std::milli> editTime =
+      Clock::now() - start;
+    std::cout << "UpdateRawPose of " << name << ": "
+              << editTime.count() / editCount << " ms per edit" << std::endl;
+  }
+
+  // Move the last frame back and forth between two links.
+  start = Clock::now();
+  for (int e = 0; e < editCount; ++e)
+  {
+    EXPECT_TRUE(model.UpdatePoseRelativeTo(
+          "frame_" + last, e % 2 ? "link_0" : "link_" + middle).empty());
+  }
+  const std::chrono::duration<double, std::milli> editTime =
+    Clock::now() - start;
+  std::cout << "UpdatePoseRelativeTo of frame_" << last << ": "
+            << editTime.count() / editCount << " ms per edit" << std::endl;
+}
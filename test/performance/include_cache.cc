@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "integration",
+                                 "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// Get a world that includes the same model a number of times.
+/// \param[in] _count Number of <include> elements.
+/// \return The world as an SDF string.
+std::string worldWithIdenticalIncludes(const int _count)
+{
+  std::string world = "<sdf version='" SDF_VERSION "'><world name='default'>";
+  for (int i = 0; i < _count; ++i)
+  {
+    world += "<include><uri>test_model</uri><name>model_" +
+      std::to_string(i) + "</name><pose>" + std::to_string(i) +
+      " 0 0 0 0 0</pose></include>";
+  }
+  return world + "</world></sdf>";
+}
+
+/////////////////////////////////////////////////
+/// The included model is parsed by the first include only, and copied for
+/// the others, so the cost per include drops as the count grows.
+TEST(IncludeCache, IdenticalIncludes)
+{
+  using Clock = std::chrono::steady_clock;
+  sdf::setFindCallback(findFileCb);
+  sdf::setIncludeCache(true);
+
+  for (int count : {1, 10, 100, 500})
+  {
+    const std::string world = worldWithIdenticalIncludes(count);
+
+    // Each count parses the model once.
+    sdf::clearIncludeCache();
+    sdf::Root root;
+    auto start = Clock::now();
+    sdf::Errors errors = root.LoadSdfString(world);
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    EXPECT_TRUE(errors.empty());
+    ASSERT_NE(nullptr, root.WorldByIndex(0));
+    EXPECT_EQ(static_cast<uint64_t>(count),
+              root.WorldByIndex(0)->ModelCount());
+
+    std::cout << count << " identical includes: " << elapsed.count()
+              << " ms, " << elapsed.count() / count << " ms per include\n";
+  }
+  sdf::setIncludeCache(false);
+}
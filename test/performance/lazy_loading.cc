@@ -0,0 +1,111 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Get a world with many models, each with a link that has a
+/// camera, a lidar and a visual with a PBR material.
+/// \param[in] _modelCount Number of models.
+/// \return The world.
+std::string worldString(const int _modelCount)
+{
+  std::ostringstream stream;
+  stream << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+         << "<world name='default'>\n";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    stream
+      << "  <model name='model_" << m << "'>\n"
+      << "    <pose>" << m << " 0 0.5 0 0 0</pose>\n"
+      << "    <link name='link'>\n"
+      << "      <inertial><mass>1.5</mass></inertial>\n"
+      << "      <collision name='collision'><geometry><box>"
+      << "<size>1 1 1</size></box></geometry></collision>\n"
+      << "      <visual name='visual'><geometry><box>"
+      << "<size>1 1 1</size></box></geometry>\n"
+      << "        <material><pbr><metal>"
+      << "<albedo_map>albedo.png</albedo_map>"
+      << "<normal_map>normal.png</normal_map>"
+      << "<metalness>0.5</metalness><roughness>0.2</roughness>"
+      << "</metal></pbr></material>\n"
+      << "      </visual>\n"
+      << "      <sensor name='camera' type='camera'><camera>"
+      << "<horizontal_fov>1.0</horizontal_fov>"
+      << "<image><width>640</width><height>480</height></image>"
+      << "<clip><near>0.1</near><far>100</far></clip>"
+      << "</camera></sensor>\n"
+      << "      <sensor name='lidar' type='gpu_lidar'><lidar><scan>"
+      << "<horizontal><samples>640</samples>"
+      << "<min_angle>-1</min_angle><max_angle>1</max_angle></horizontal>"
+      << "</scan><range><min>0.1</min><max>10</max></range></lidar>"
+      << "</sensor>\n"
+      << "    </link>\n"
+      << "  </model>\n";
+  }
+  stream << "</world>\n</sdf>\n";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Time to the first ModelCount() of Root::Load with and without lazy
+/// loading. The document is parsed beforehand, so only the time spent
+/// building the DOM objects is measured.
+TEST(LazyLoading, TimeToModelCount)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int modelCount : {1000, 10000})
+  {
+    const std::string world = worldString(modelCount);
+
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+    ASSERT_TRUE(sdf::readString(world, sdfParsed));
+
+    for (bool lazy : {false, true})
+    {
+      sdf::Root root;
+      root.SetLazyLoading(lazy);
+
+      auto start = Clock::now();
+      EXPECT_TRUE(root.Load(sdfParsed).empty());
+      ASSERT_EQ(1u, root.WorldCount());
+      EXPECT_EQ(static_cast<uint64_t>(modelCount),
+          root.WorldByIndex(0)->ModelCount());
+      const std::chrono::duration<double, std::milli> loadTime =
+        Clock::now() - start;
+
+      start = Clock::now();
+      EXPECT_TRUE(root.ValidateAll().empty());
+      const std::chrono::duration<double, std::milli> validateTime =
+        Clock::now() - start;
+
+      std::cout << modelCount << " models, "
+                << (lazy ? "lazy loading" : "eager loading") << ": "
+                << loadTime.count() << " ms to ModelCount, "
+                << validateTime.count() << " ms to ValidateAll" << std::endl;
+    }
+  }
+}
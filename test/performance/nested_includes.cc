@@ -0,0 +1,106 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/// \brief Directory that the generated models are written to.
+const std::string g_modelsDir = sdf::filesystem::append(PROJECT_BINARY_DIR,
+    "test", "performance", "nested_include_models");
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(g_modelsDir, _input);
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a model with a chain of links and joints, which includes
+/// the model of the level below it.
+/// \param[in] _level Level of the model. Level 0 includes no model.
+void writeModel(const int _level)
+{
+  const std::string name = "level_" + std::to_string(_level);
+  const std::string dir = sdf::filesystem::append(g_modelsDir, name);
+  sdf::filesystem::create_directory(dir);
+
+  std::ofstream config(sdf::filesystem::append(dir, "model.config"));
+  config << "<?xml version='1.0'?><model><name>" << name << "</name>"
+         << "<sdf version='1.6'>model.sdf</sdf></model>";
+
+  std::ofstream model(sdf::filesystem::append(dir, "model.sdf"));
+  model << "<sdf version='1.6'><model name='" << name << "'>";
+  const int links = 10;
+  for (int i = 0; i < links; ++i)
+  {
+    model << "<link name='link_" << i << "'><pose>0 0 " << i
+          << " 0 0 0</pose><visual name='visual'><geometry><box>"
+          << "<size>1 1 1</size></box></geometry></visual></link>";
+  }
+  for (int i = 1; i < links; ++i)
+  {
+    model << "<joint name='joint_" << i << "' type='revolute'>"
+          << "<parent>link_" << i - 1 << "</parent>"
+          << "<child>link_" << i << "</child>"
+          << "<axis><xyz>0 0 1</xyz></axis></joint>";
+  }
+  if (_level > 0)
+  {
+    model << "<include><uri>level_" << _level - 1 << "</uri></include>";
+  }
+  model << "</model></sdf>";
+}
+
+/////////////////////////////////////////////////
+/// Time to load a world with one model that has nested includes of a
+/// given depth. Each level adds links and joints that addNestedModel has to
+/// rename.
+TEST(NestedIncludes, LoadTimeByDepth)
+{
+  using Clock = std::chrono::steady_clock;
+  sdf::setFindCallback(findFileCb);
+
+  const int maxDepth = 8;
+  sdf::filesystem::create_directory(g_modelsDir);
+  for (int level = 0; level <= maxDepth; ++level)
+    writeModel(level);
+
+  for (int depth = 1; depth <= maxDepth; ++depth)
+  {
+    const std::string world = "<sdf version='" SDF_VERSION "'>"
+      "<world name='default'><include><uri>level_" + std::to_string(depth) +
+      "</uri></include></world></sdf>";
+
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+    auto start = Clock::now();
+    ASSERT_TRUE(sdf::readString(world, sdfParsed));
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    std::cout << "Nested include depth " << depth << ": " << elapsed.count()
+              << " ms\n";
+  }
+}
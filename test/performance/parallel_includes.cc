@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "integration",
+                                 "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// Get a world that includes models a number of times.
+/// \param[in] _count Number of <include> elements.
+/// \return The world as an SDF string.
+std::string worldWithIncludes(const int _count)
+{
+  const std::vector<std::string> uris = {"box", "test_model"};
+  std::string world = "<sdf version='" SDF_VERSION "'><world name='default'>";
+  for (int i = 0; i < _count; ++i)
+  {
+    world += "<include><uri>" + uris[i % uris.size()] + "</uri><name>model_" +
+      std::to_string(i) + "</name></include>";
+  }
+  return world + "</world></sdf>";
+}
+
+/////////////////////////////////////////////////
+/// Time to load a world with many <include> elements, with the included
+/// files read one at a time and in parallel.
+TEST(ParallelIncludes, WorldLoadTime)
+{
+  using Clock = std::chrono::steady_clock;
+  sdf::setFindCallback(findFileCb);
+
+  for (int count : {8, 32, 128, 512})
+  {
+    const std::string world = worldWithIncludes(count);
+
+    for (bool parallel : {false, true})
+    {
+      sdf::setParallelIncludes(parallel);
+      sdf::Root root;
+      auto start = Clock::now();
+      sdf::Errors errors = root.LoadSdfString(world);
+      const std::chrono::duration<double, std::milli> elapsed =
+        Clock::now() - start;
+
+      EXPECT_TRUE(errors.empty());
+      ASSERT_NE(nullptr, root.WorldByIndex(0));
+      EXPECT_EQ(static_cast<uint64_t>(count),
+                root.WorldByIndex(0)->ModelCount());
+
+      std::cout << count << " includes, "
+                << (parallel ? "parallel: " : "serial: ")
+                << elapsed.count() << " ms\n";
+    }
+  }
+  sdf::setParallelIncludes(false);
+}
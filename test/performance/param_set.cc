@@ -0,0 +1,108 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Number of values to set in each timed loop.
+static const int kSets = 100000;
+
+/////////////////////////////////////////////////
+/// Set<Pose3d> on a pose param stores the value directly, while setting the
+/// same pose from its string form has to parse it.
+TEST(ParamSet, SetPoseTypedVsString)
+{
+  sdf::Param param("pose", "pose", "0 0 0 0 0 0", false);
+  const ignition::math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  std::ostringstream stream;
+  stream << pose;
+  const std::string poseString = stream.str();
+
+  auto start = Clock::now();
+  for (int i = 0; i < kSets; ++i)
+  {
+    ASSERT_TRUE(param.Set(pose));
+  }
+  const std::chrono::duration<double, std::nano> typed =
+    Clock::now() - start;
+
+  start = Clock::now();
+  for (int i = 0; i < kSets; ++i)
+  {
+    ASSERT_TRUE(param.SetFromString(poseString));
+  }
+  const std::chrono::duration<double, std::nano> fromString =
+    Clock::now() - start;
+
+  std::cout << "Set<Pose3d>: " << typed.count() / kSets << " ns per set\n"
+            << "SetFromString: " << fromString.count() / kSets
+            << " ns per set\n";
+  EXPECT_LT(typed.count(), fromString.count());
+}
+
+/////////////////////////////////////////////////
+/// Floating point values are parsed with std::from_chars, without touching
+/// the global C locale.
+TEST(ParamSet, ParseDoubleThroughput)
+{
+  sdf::Param param("value", "double", "0", false);
+  std::vector<std::string> values;
+  for (int i = 0; i < 100; ++i)
+  {
+    values.push_back(std::to_string(i * 1.0625) + "e-3");
+  }
+
+  auto start = Clock::now();
+  for (int i = 0; i < kSets; ++i)
+  {
+    ASSERT_TRUE(param.SetFromString(values[i % values.size()]));
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  std::cout << "SetFromString<double>: " << kSets / elapsed.count()
+            << " floats per second\n";
+}
+
+/////////////////////////////////////////////////
+TEST(ParamSet, CloneElement)
+{
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  sdf::ElementPtr link = sdfParsed->Root()->GetElement("model")
+    ->GetElement("link");
+  ASSERT_NE(nullptr, link);
+
+  const int count = 1000;
+  auto start = Clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    ASSERT_NE(nullptr, link->Clone());
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+    Clock::now() - start;
+  std::cout << "Clone <link>: " << elapsed.count() / count
+            << " us per clone\n";
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Get a model whose links form a chain, each link posed relative
+/// to the previous one and attached to it by a joint. Each link has a
+/// visual, a collision and a frame.
+/// \param[in] _linkCount Number of links.
+/// \return The model.
+std::string chainModelString(const int _linkCount)
+{
+  std::ostringstream stream;
+  stream << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+         << "<model name='chain'>\n";
+  for (int l = 0; l < _linkCount; ++l)
+  {
+    const std::string name = "link_" + std::to_string(l);
+    const std::string relativeTo =
+      l == 0 ? "" : " relative_to='link_" + std::to_string(l - 1) + "'";
+    stream
+      << "  <link name='" << name << "'>\n"
+      << "    <pose" << relativeTo << ">0.1 0 0 0 0 0.01</pose>\n"
+      << "    <visual name='visual'><pose>0 0 0.1 0 0 0</pose><geometry>"
+      << "<box><size>0.1 0.1 0.1</size></box></geometry></visual>\n"
+      << "    <collision name='collision'><geometry>"
+      << "<box><size>0.1 0.1 0.1</size></box></geometry></collision>\n"
+      << "  </link>\n"
+      << "  <frame name='" << name << "_frame' attached_to='" << name << "'>"
+      << "<pose relative_to='" << name << "'>0 0.1 0 0 0 0</pose></frame>\n";
+    if (l > 0)
+    {
+      stream
+        << "  <joint name='joint_" << l << "' type='revolute'>\n"
+        << "    <parent>link_" << l - 1 << "</parent>\n"
+        << "    <child>" << name << "</child>\n"
+        << "    <axis><xyz>0 0 1</xyz></axis>\n"
+        << "  </joint>\n";
+    }
+  }
+  stream << "</model>\n</sdf>\n";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Time to resolve the pose of every link, visual, collision, frame and
+/// joint of a long chain to the model frame, one SemanticPose at a time.
+TEST(PoseResolution, PerCall)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int linkCount : {100, 600, 1667})
+  {
+    sdf::Root root;
+    EXPECT_TRUE(root.LoadSdfString(chainModelString(linkCount)).empty());
+    const sdf::Model *model = root.ModelByIndex(0);
+    ASSERT_NE(nullptr, model);
+
+    auto start = Clock::now();
+    ignition::math::Pose3d pose;
+    std::size_t resolved = 0;
+    for (uint64_t l = 0; l < model->LinkCount(); ++l)
+    {
+      const sdf::Link *link = model->LinkByIndex(l);
+      EXPECT_TRUE(link->SemanticPose().Resolve(pose, "__model__").empty());
+      EXPECT_TRUE(link->VisualByIndex(0)->SemanticPose().Resolve(
+            pose, "__model__").empty());
+      EXPECT_TRUE(link->CollisionByIndex(0)->SemanticPose().Resolve(
+            pose, "__model__").empty());
+      resolved += 3;
+    }
+    for (uint64_t f = 0; f < model->FrameCount(); ++f)
+    {
+      EXPECT_TRUE(model->FrameByIndex(f)->SemanticPose().Resolve(
+            pose, "__model__").empty());
+      ++resolved;
+    }
+    for (uint64_t j = 0; j < model->JointCount(); ++j)
+    {
+      EXPECT_TRUE(model->JointByIndex(j)->SemanticPose().Resolve(
+            pose, "__model__").empty());
+      ++resolved;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    std::cout << linkCount << " links, " << resolved << " poses resolved in "
+              << elapsed.count() << " ms" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Time to resolve the same poses with Model::ResolveAllPoses. The chain
+/// with 1667 links has 5000 frames: its links, joints and explicit frames.
+TEST(PoseResolution, Bulk)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int linkCount : {100, 600, 1667})
+  {
+    sdf::Root root;
+    EXPECT_TRUE(root.LoadSdfString(chainModelString(linkCount)).empty());
+    const sdf::Model *model = root.ModelByIndex(0);
+    ASSERT_NE(nullptr, model);
+
+    auto start = Clock::now();
+    sdf::ModelPoses poses;
+    EXPECT_TRUE(model->ResolveAllPoses(poses, "__model__").empty());
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    const std::size_t resolved = poses.links.size() * 3 +
+      poses.frames.size() + poses.joints.size();
+    std::cout << linkCount << " links, " << resolved << " poses resolved in "
+              << elapsed.count() << " ms" << std::endl;
+  }
+}
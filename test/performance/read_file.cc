@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with many models to a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _modelCount Number of models.
+/// \return Size of the file in bytes.
+size_t writeWorld(const std::string &_path, const int _modelCount)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  file << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+       << "<world name='default'>\n";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    file << "  <model name='model_" << m << "'>\n"
+         << "    <pose>" << m << " 0 0.5 0 0 0</pose>\n"
+         << "    <link name='link'>\n"
+         << "      <collision name='collision'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></collision>\n"
+         << "      <visual name='visual'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></visual>\n"
+         << "    </link>\n"
+         << "  </model>\n";
+  }
+  file << "</world>\n</sdf>\n";
+  return static_cast<size_t>(file.tellp());
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the peak resident set size of the process.
+/// \return Peak RSS in MB, or 0 if it is not known on this platform.
+double peakRssMb()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1.0e6;
+#else
+  return usage.ru_maxrss / 1.0e3;
+#endif
+#else
+  return 0;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// Load time and peak memory use of readFile for increasing file sizes.
+/// Files are read from smallest to largest, since the peak RSS of the
+/// process never decreases.
+TEST(ReadFile, LoadTimeAndPeakRss)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string path = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "performance", "read_file_world.sdf");
+
+  for (int modelCount : {1000, 10000, 50000})
+  {
+    const size_t fileSize = writeWorld(path, modelCount);
+
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+    auto start = Clock::now();
+    ASSERT_TRUE(sdf::readFile(path, sdfParsed));
+    const std::chrono::duration<double, std::milli> elapsed =
+      Clock::now() - start;
+
+    std::cout << "File size " << fileSize / 1.0e6 << " MB: "
+              << elapsed.count() << " ms, peak RSS " << peakRssMb()
+              << " MB\n";
+  }
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// Get a world with many models, each with a chain of links and joints.
+/// \param[in] _modelCount Number of models.
+/// \return The world as an SDF string.
+std::string largeWorld(const int _modelCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='" << SDF_VERSION << "'><world name='default'>";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'><pose>" << m
+           << " 0.5 0.25 0 0 0.1</pose>";
+    for (int l = 0; l < 5; ++l)
+    {
+      stream << "<link name='link_" << l << "'><pose>0 0 " << l * 0.1
+             << " 0 0 0</pose><inertial><mass>1.5</mass></inertial>"
+             << "<collision name='collision'><geometry><box>"
+             << "<size>0.1 0.2 0.3</size></box></geometry></collision>"
+             << "<visual name='visual'><geometry><box>"
+             << "<size>0.1 0.2 0.3</size></box></geometry></visual></link>";
+    }
+    for (int l = 1; l < 5; ++l)
+    {
+      stream << "<joint name='joint_" << l << "' type='revolute'>"
+             << "<parent>link_" << l - 1 << "</parent>"
+             << "<child>link_" << l << "</child>"
+             << "<axis><xyz>0 0 1</xyz><limit><lower>-1.57</lower>"
+             << "<upper>1.57</upper></limit></axis></joint>";
+    }
+    stream << "</model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Rate at which a large world is written to a file and to a string.
+TEST(SDFWrite, Throughput)
+{
+  using Clock = std::chrono::steady_clock;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  ASSERT_TRUE(sdf::readString(largeWorld(2000), sdfParsed));
+
+  const std::string path = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "performance", "sdf_write.sdf");
+
+  auto start = Clock::now();
+  const std::string output = sdfParsed->ToString();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  const double megabytes = output.size() / 1.0e6;
+  std::cout << "SDF::ToString: " << megabytes << " MB in "
+            << elapsed.count() * 1000 << " ms, "
+            << megabytes / elapsed.count() << " MB/s\n";
+
+  start = Clock::now();
+  sdfParsed->Write(path);
+  elapsed = Clock::now() - start;
+  std::cout << "SDF::Write: " << megabytes << " MB in "
+            << elapsed.count() * 1000 << " ms, "
+            << megabytes / elapsed.count() << " MB/s\n";
+
+  EXPECT_TRUE(sdf::filesystem::exists(path));
+  std::remove(path.c_str());
+}
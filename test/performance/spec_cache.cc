@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// The first call to readFile builds the spec description tree from the
+/// embedded spec files, which every call used to do. Later calls copy the
+/// cached spec, so they should be much cheaper.
+TEST(SpecCache, ReadFilePerFileCost)
+{
+  using Clock = std::chrono::steady_clock;
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+                            "model_link_relative_to.sdf");
+  const int runs = 50;
+
+  sdf::Errors errors;
+  auto start = Clock::now();
+  sdf::SDFPtr sdfParsed = sdf::readFile(testFile, errors);
+  const std::chrono::duration<double, std::milli> cold = Clock::now() - start;
+  ASSERT_NE(nullptr, sdfParsed);
+  EXPECT_TRUE(errors.empty());
+
+  start = Clock::now();
+  for (int i = 0; i < runs; ++i)
+  {
+    sdfParsed = sdf::readFile(testFile, errors);
+    ASSERT_NE(nullptr, sdfParsed);
+  }
+  const std::chrono::duration<double, std::milli> warm =
+    (Clock::now() - start) / runs;
+  EXPECT_TRUE(errors.empty());
+
+  std::cout << "readFile with spec build: " << cold.count() << " ms\n"
+            << "readFile with cached spec: " << warm.count() << " ms\n";
+  EXPECT_LT(warm.count(), cold.count());
+}
+
+/////////////////////////////////////////////////
+TEST(SpecCache, InitRuns_performance)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    ASSERT_TRUE(sdf::init(sdfParsed));
+  }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "sdf/sdf.hh"
+
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with many models to a file. Every tenth model has
+/// a plugin, which the streaming parser keeps as a small TinyXML tree.
+/// \param[in] _path Path of the file.
+/// \param[in] _modelCount Number of models.
+/// \return Size of the file in bytes.
+size_t writeWorld(const std::string &_path, const int _modelCount)
+{
+  std::ofstream file(_path, std::ios::out | std::ios::binary);
+  file << "<?xml version='1.0'?>\n<sdf version='" << SDF_VERSION << "'>\n"
+       << "<world name='default'>\n";
+  for (int m = 0; m < _modelCount; ++m)
+  {
+    file << "  <model name='model_" << m << "'>\n"
+         << "    <pose>" << m << " 0 0.5 0 0 0</pose>\n"
+         << "    <link name='link'>\n"
+         << "      <inertial><mass>1.5</mass></inertial>\n"
+         << "      <collision name='collision'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></collision>\n"
+         << "      <visual name='visual'><geometry><box>"
+         << "<size>1 1 1</size></box></geometry></visual>\n"
+         << "    </link>\n";
+    if (m % 10 == 0)
+    {
+      file << "    <plugin name='plugin' filename='libplugin.so'>"
+           << "<gain>" << m << "</gain></plugin>\n";
+    }
+    file << "  </model>\n";
+  }
+  file << "</world>\n</sdf>\n";
+  return static_cast<size_t>(file.tellp());
+}
+
+#ifndef _WIN32
+/////////////////////////////////////////////////
+/// \brief Get the peak resident set size of the process.
+/// \return Peak RSS in MB.
+double peakRssMb()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1.0e6;
+#else
+  return usage.ru_maxrss / 1.0e3;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// Load time and peak memory use of readFile with and without the
+/// streaming parser. Each file is read in a child process, so the growth of
+/// its peak RSS is the memory needed to read the file.
+TEST(StreamingParser, LoadTimeAndPeakRss)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const std::string path = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "test", "performance", "streaming_parser_world.sdf");
+
+  for (int modelCount : {1000, 10000, 50000})
+  {
+    const size_t fileSize = writeWorld(path, modelCount);
+
+    for (bool streaming : {false, true})
+    {
+      std::cout << std::flush;
+      const pid_t pid = fork();
+      ASSERT_NE(-1, pid);
+      if (pid == 0)
+      {
+        sdf::setStreamingParser(streaming);
+        const double startRss = peakRssMb();
+
+        sdf::SDFPtr sdfParsed(new sdf::SDF());
+        sdf::init(sdfParsed);
+        auto start = Clock::now();
+        const bool result = sdf::readFile(path, sdfParsed);
+        const std::chrono::duration<double, std::milli> elapsed =
+          Clock::now() - start;
+
+        std::cout << "File size " << fileSize / 1.0e6 << " MB, "
+                  << (streaming ? "streaming" : "TinyXML") << ": "
+                  << elapsed.count() << " ms, peak RSS growth "
+                  << peakRssMb() - startRss << " MB" << std::endl;
+        _exit(result ? 0 : 1);
+      }
+
+      int status = 0;
+      ASSERT_EQ(pid, waitpid(pid, &status, 0));
+      EXPECT_TRUE(WIFEXITED(status));
+      EXPECT_EQ(0, WEXITSTATUS(status));
+    }
+  }
+
+  std::remove(path.c_str());
+}
+#endif